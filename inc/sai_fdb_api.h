@@ -169,6 +169,34 @@ typedef sai_status_t (*sai_fdb_internal_callback_fn)(uint_t num_notification,
 void sai_fdb_internal_callback_cache_update (sai_fdb_internal_callback_fn
                                                  fdb_callback);
 
+/** SAI FDB API - FDB entry change listener function pointer declaration.
+                  Changes on FDB entry learn, port move and removal are queued
+                  with the FDB lock held, and the listener is called with the
+                  queued changes by sai_fdb_send_entry_change_notifications(),
+                  without the FDB lock. A bulk flush is one call.
+    \param[in] num_changes Number of changes
+    \param[in] change_list Array of changes in FDB order. port_id is the port on
+                           which entry is learnt, SAI_NULL_OBJECT_ID on removal.
+                           fdb_event is SAI_FDB_EVENT_LEARNED or SAI_FDB_EVENT_FLUSHED
+    \param[in] resync true if changes were lost because they could not be queued.
+                      The listener must then re-read every entry it tracks with
+                      sai_fdb_get_port_from_cache() after applying change_list.
+*/
+typedef void (*sai_fdb_entry_change_listener_fn)(uint_t num_changes,
+                                                 const sai_fdb_notification_data_t *change_list,
+                                                 bool resync);
+
+/** SAI FDB API - Register FDB entry change listener function
+    \param[in] listener Function pointer to listener function, NULL to unregister
+*/
+void sai_fdb_entry_change_listener_set (sai_fdb_entry_change_listener_fn listener);
+
+/** SAI FDB API - Send the queued FDB entry changes to the change listener.
+                  Must be called without the FDB lock and the FIB lock held.
+                  Also called by sai_fdb_send_internal_notifications().
+*/
+void sai_fdb_send_entry_change_notifications(void);
+
 /** SAI FDB API - Send internal notifications to the subscriber
 */
 void sai_fdb_send_internal_notifications(void);
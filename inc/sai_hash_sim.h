@@ -0,0 +1,235 @@
+/************************************************************************
+* LEGALESE:   "Copyright (c) 2015, Dell Inc. All rights reserved."
+*
+* This source code is confidential, proprietary, and contains trade
+* secrets that are the sole property of Dell Inc.
+* Copy and/or distribution of this source code or disassembly or reverse
+* engineering of the resultant object code are strictly forbidden without
+* the written consent of Dell Inc.
+*
+************************************************************************/
+/**
+* @file sai_hash_sim.h
+*
+* @brief This file contains the software LAG and ECMP hash simulator used
+*        to predict the load distribution of a traffic mix.
+*
+*************************************************************************/
+#ifndef __SAI_HASH_SIM_H__
+#define __SAI_HASH_SIM_H__
+
+#include "std_type_defs.h"
+#include "saitypes.h"
+#include "saistatus.h"
+#include "saihash.h"
+#include "sai_hash_object.h"
+
+/** \defgroup SAIHASHSIM SAI - LAG and ECMP hash simulator
+ *  Software model of the LAG and ECMP member selection.
+ *
+ *  The native hash fields of a flow are packed in the order of the
+ *  sai_native_hash_field_t values, hashed with the configured algorithm
+ *  and seed, and the member is the hash modulo the number of members.
+ *  The model does not reproduce the NPU specific hash bit selection, it is
+ *  meant to compare seeds, field lists and traffic mixes.
+ *
+ *  \{
+ */
+
+/** Maximum number of members of a simulated LAG or ECMP group */
+#define SAI_HASH_SIM_MAX_MEMBERS    (1024)
+
+/** Maximum number of hops of a polarization simulation */
+#define SAI_HASH_SIM_MAX_HOPS       (8)
+
+/** Maximum number of bytes of the packed hash key of a flow */
+#define SAI_HASH_SIM_MAX_KEY_LEN    (64)
+
+/**
+ * @brief Hash functions of the simulator.
+ */
+typedef enum _sai_hash_sim_algo_t {
+    /** CRC16-CCITT */
+    SAI_HASH_SIM_ALGO_CRC16 = 0,
+
+    /** CRC32C (Castagnoli) */
+    SAI_HASH_SIM_ALGO_CRC32,
+
+    /** XOR fold of the key to 32 bits */
+    SAI_HASH_SIM_ALGO_XOR,
+
+    SAI_HASH_SIM_ALGO_MAX,
+} sai_hash_sim_algo_t;
+
+/**
+ * @brief Native hash fields of a flow.
+ */
+typedef struct _sai_hash_sim_flow_t {
+    sai_ip_address_t   src_ip;
+    sai_ip_address_t   dst_ip;
+    uint8_t            ip_protocol;
+    uint16_t           l4_src_port;
+    uint16_t           l4_dst_port;
+    uint16_t           vlan_id;
+    uint16_t           ethertype;
+    uint32_t           in_port;
+    sai_mac_t          src_mac;
+    sai_mac_t          dst_mac;
+} sai_hash_sim_flow_t;
+
+/**
+ * @brief Hash configuration of a LAG or ECMP group.
+ */
+typedef struct _sai_hash_sim_config_t {
+    sai_hash_sim_algo_t  algo;
+    uint32_t             seed;
+    uint_t               num_members;
+
+    /** Bitmap of the native hash fields, bit i for the field of value i */
+    uint32_t             field_mask;
+} sai_hash_sim_config_t;
+
+/**
+ * @brief Load distribution of a flow list.
+ */
+typedef struct _sai_hash_sim_result_t {
+    uint_t     num_members;
+
+    /** Number of flows per member, array of num_members given by the
+     * caller */
+    uint64_t  *member_flow_count;
+
+    uint64_t   total_flows;
+    uint64_t   max_flows;
+    uint64_t   min_flows;
+
+    /** Number of members with no flow */
+    uint_t     unused_members;
+
+    /** Flows of the most loaded member over the mean, 1.0 is even */
+    double     max_to_mean_ratio;
+
+    /** Difference between the most and least loaded members in percent
+     * of the mean */
+    double     spread_pct;
+} sai_hash_sim_result_t;
+
+/**
+ * @brief Fill a simulator configuration.
+ *
+ * @param[in] algo Hash function
+ * @param[in] seed Hash seed
+ * @param[in] field_list Native hash fields of the sai_native_hash_field_t
+ *  type. Unsupported fields are ignored.
+ * @param[in] num_members Number of LAG or ECMP members
+ * @param[out] config Simulator configuration
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_hash_sim_config_init (sai_hash_sim_algo_t algo, uint32_t seed,
+                                       const sai_s32_list_t *field_list,
+                                       uint_t num_members,
+                                       sai_hash_sim_config_t *config);
+
+/**
+ * @brief Fill a simulator configuration from the switch LAG or ECMP hash
+ * algorithm and seed.
+ *
+ * @param[in] is_lag true for the LAG hash, false for the ECMP hash
+ * @param[in] hash_obj Hash object giving the native hash fields. NULL for
+ *  the default native hash fields.
+ * @param[in] num_members Number of LAG or ECMP members
+ * @param[out] config Simulator configuration
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned. SAI_STATUS_NOT_SUPPORTED if the switch hash
+ *  algorithm cannot be simulated, such as SAI_HASH_ALGORITHM_RANDOM.
+ */
+sai_status_t sai_hash_sim_switch_config_get (bool is_lag,
+                                             const dn_sai_hash_object_t *hash_obj,
+                                             uint_t num_members,
+                                             sai_hash_sim_config_t *config);
+
+/**
+ * @brief Compute the hash of a flow.
+ *
+ * @param[in] config Simulator configuration
+ * @param[in] flow Flow
+ * @return Hash value of the flow.
+ */
+uint32_t sai_hash_sim_flow_hash_get (const sai_hash_sim_config_t *config,
+                                     const sai_hash_sim_flow_t *flow);
+
+/**
+ * @brief Get the member selected for a flow.
+ *
+ * @param[in] config Simulator configuration
+ * @param[in] flow Flow
+ * @return Member index, from 0 to num_members - 1.
+ */
+uint_t sai_hash_sim_flow_member_get (const sai_hash_sim_config_t *config,
+                                     const sai_hash_sim_flow_t *flow);
+
+/**
+ * @brief Load a flow trace file.
+ *
+ * Each line holds one flow as white space separated fields:
+ * src_ip dst_ip ip_protocol l4_src_port l4_dst_port [vlan_id [in_port
+ * [ethertype [src_mac dst_mac]]]]. Empty lines and lines starting with '#'
+ * are skipped. Missing fields are 0.
+ *
+ * @param[in] file_name Trace file name
+ * @param[out] flow_list Allocated flow array, freed by the caller
+ * @param[out] count Number of flows
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_hash_sim_trace_load (const char *file_name,
+                                      sai_hash_sim_flow_t **flow_list,
+                                      uint_t *count);
+
+/**
+ * @brief Compute the load distribution of a flow list.
+ *
+ * @param[in] config Simulator configuration
+ * @param[in] flow_list Flows
+ * @param[in] count Number of flows
+ * @param[inout] result Distribution. member_flow_count must hold
+ *  config->num_members entries.
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_hash_sim_distribution_get (const sai_hash_sim_config_t *config,
+                                            const sai_hash_sim_flow_t *flow_list,
+                                            uint_t count,
+                                            sai_hash_sim_result_t *result);
+
+/**
+ * @brief Compute the polarization between consecutive hops.
+ *
+ * Every flow crosses every hop. For each pair of consecutive hops, the
+ * polarization is the share of the (previous hop member, hop member)
+ * pairs that the flows could use and do not. 0.0 means the hop spreads
+ * the flows of each previous hop member over all its members, and it
+ * gets close to 1.0 when the flows of a previous hop member all take the
+ * same member.
+ *
+ * @param[in] hop_list Simulator configuration of each hop
+ * @param[in] num_hops Number of hops, 2 to SAI_HASH_SIM_MAX_HOPS
+ * @param[in] flow_list Flows
+ * @param[in] count Number of flows
+ * @param[out] polarization_list Polarization of hop i + 1 against hop i,
+ *  num_hops - 1 entries
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_hash_sim_polarization_get (const sai_hash_sim_config_t *hop_list,
+                                            uint_t num_hops,
+                                            const sai_hash_sim_flow_t *flow_list,
+                                            uint_t count,
+                                            double *polarization_list);
+
+/**
+ * \}
+ */
+
+#endif /* __SAI_HASH_SIM_H__ */
@@ -166,6 +166,21 @@ typedef sai_status_t (*sai_npu_neighbor_attribute_get_fn) (
                                                  uint_t attr_count,
                                                  sai_attribute_t *p_attr_list);
 
+/**
+ * @brief Update the egress port of all the neighbors in a neighbor MAC
+ * entry in NPU, on the move of the MAC to another port. Neighbor nodes are
+ * updated with the new port after the NPU update is successful.
+ *
+ * @param[in] p_mac_entry   Pointer to the neighbor MAC entry node
+ * @param[in] port_id       New egress port Id, SAI_NULL_OBJECT_ID if the
+ * MAC is flushed
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+typedef sai_status_t (*sai_npu_neighbor_mac_entry_port_update_fn) (
+                                      sai_fib_neighbor_mac_entry_t *p_mac_entry,
+                                      sai_object_id_t port_id);
+
 /**
  * @brief Create a next hop in NPU.
  *
@@ -267,6 +282,22 @@ typedef sai_status_t (*sai_npu_next_hop_group_attribute_get_fn) (
                                                 uint_t attr_count,
                                                 sai_attribute_t *p_attr_list);
 
+/**
+ * @brief Program the resilient hashing buckets of a NH group in NPU.
+ *
+ * @param[in] p_nh_group   Pointer to NH Group node
+ * @param[in] p_bucket_table  Bucket table of the group
+ * @param[in] p_changed_list  Indexes of the buckets changed since the last
+ *  update, NULL to program all the buckets
+ * @param[in] changed_count  Number of indexes in the changed list
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+typedef sai_status_t (*sai_npu_next_hop_group_bucket_update_fn) (
+                       sai_fib_nh_group_t *p_nh_group,
+                       const sai_fib_nh_group_bucket_table_t *p_bucket_table,
+                       const uint_t *p_changed_list, uint_t changed_count);
+
 /**
  * @brief Create a route entry in NPU.
  *
@@ -397,6 +428,9 @@ typedef struct _sai_npu_neighbor_api_t {
     sai_npu_neighbor_remove_fn          neighbor_remove;
     sai_npu_neighbor_attribute_set_fn   neighbor_attr_set;
     sai_npu_neighbor_attribute_get_fn   neighbor_attr_get;
+
+    /** Optional. neighbor_attr_set is called per neighbor if NULL */
+    sai_npu_neighbor_mac_entry_port_update_fn neighbor_mac_entry_port_update;
 } sai_npu_neighbor_api_t;
 
 /**
@@ -417,6 +451,9 @@ typedef struct _sai_npu_nh_group_api_t {
     sai_npu_next_hop_add_to_group_fn           add_nh_to_group;
     sai_npu_next_hop_remove_from_group_fn      remove_nh_from_group;
     sai_npu_next_hop_group_attribute_get_fn    nh_group_attr_get;
+
+    /** Optional, NULL if the NPU does not support resilient hashing */
+    sai_npu_next_hop_group_bucket_update_fn    nh_group_bucket_update;
 } sai_npu_nh_group_api_t;
 
 /**
@@ -29,6 +29,24 @@
 #include "sairoute.h"
 #include "saiswitch.h"
 
+struct _sai_fib_nh_t;
+
+/**
+ * @brief SAI L3 Next Hop hash index on (RIF, IP address family, IP address).
+ * Nodes are chained through their p_hash_next field.
+ */
+typedef struct _sai_fib_nh_hash_t {
+
+    /** Bucket heads, NULL if the index is not initialized */
+    struct _sai_fib_nh_t **ap_bucket;
+
+    /** Number of buckets, a power of 2 */
+    uint_t                 num_buckets;
+
+    /** Number of nodes in the index */
+    uint_t                 num_entries;
+} sai_fib_nh_hash_t;
+
 /**
  * @brief SAI L3 data structure for the global parameters
  */
@@ -49,6 +67,9 @@ typedef struct _sai_fib_global_t {
     /** Neighbor MAC entry tree. Nodes of type sai_fib_neighbor_mac_entry_t */
     std_rt_table    *neighbor_mac_tree;
 
+    /** (RIF, IP) hash index of the nodes in the VRF Next Hop trees */
+    sai_fib_nh_hash_t nh_hash;
+
     /** SAI_SWITCH_ATTR_MAX_ECMP_PATHS */
     uint_t           max_ecmp_paths;
 
@@ -63,6 +84,91 @@ typedef struct _sai_fib_global_t {
 } sai_fib_global_t;
 
 
+/** Number of prefix lengths for IPv4 routes, 0 to 32 */
+#define SAI_FIB_V4_PREFIX_LEN_COUNT   (32 + 1)
+
+/** Number of prefix lengths for IPv6 routes, 0 to 128 */
+#define SAI_FIB_V6_PREFIX_LEN_COUNT   (128 + 1)
+
+/** Number of packet actions tracked in route statistics */
+#define SAI_FIB_ROUTE_STATS_PKT_ACTION_COUNT   (8)
+
+/**
+ * @brief Next hop type index in the route statistics.
+ */
+typedef enum _sai_fib_route_stats_nh_type_t {
+
+    SAI_FIB_ROUTE_STATS_NH_TYPE_NEXT_HOP,
+    SAI_FIB_ROUTE_STATS_NH_TYPE_NEXT_HOP_GROUP,
+    SAI_FIB_ROUTE_STATS_NH_TYPE_NONE,
+    SAI_FIB_ROUTE_STATS_NH_TYPE_MAX,
+
+} sai_fib_route_stats_nh_type_t;
+
+/**
+ * @brief SAI L3 per VRF route statistics. Maintained on route insert and
+ * remove in the VRF route tree.
+ */
+typedef struct _sai_fib_vrf_route_stats_t {
+
+    /** Number of IPv4 routes */
+    uint_t   num_v4_routes;
+
+    /** Number of IPv6 routes */
+    uint_t   num_v6_routes;
+
+    /** Number of IPv4 routes per prefix length */
+    uint_t   v4_prefix_len_count [SAI_FIB_V4_PREFIX_LEN_COUNT];
+
+    /** Number of IPv6 routes per prefix length */
+    uint_t   v6_prefix_len_count [SAI_FIB_V6_PREFIX_LEN_COUNT];
+
+    /** Number of routes per next hop type [sai_fib_route_stats_nh_type_t] */
+    uint_t   nh_type_count [SAI_FIB_ROUTE_STATS_NH_TYPE_MAX];
+
+    /** Number of routes per packet action [sai_packet_action_t] */
+    uint_t   pkt_action_count [SAI_FIB_ROUTE_STATS_PKT_ACTION_COUNT];
+} sai_fib_vrf_route_stats_t;
+
+/**
+ * @brief SAI L3 per VRF memory accounting. Maintained on insert and remove
+ * of the nodes in the VRF trees. Bytes are the node allocation sizes.
+ */
+typedef struct _sai_fib_vrf_mem_stats_t {
+
+    /** Number of route nodes and their bytes */
+    uint_t     num_routes;
+    uint64_t   route_bytes;
+
+    /** Number of Next Hop and Neighbor nodes and their bytes */
+    uint_t     num_nh;
+    uint64_t   nh_bytes;
+
+    /** Number of Neighbor MAC entry nodes charged to the VRF and their bytes */
+    uint_t     num_neighbor_mac_entries;
+    uint64_t   neighbor_mac_entry_bytes;
+
+    /** Estimated radix tree branch node bytes for the nodes above */
+    uint64_t   radix_bytes;
+} sai_fib_vrf_mem_stats_t;
+
+/**
+ * @brief SAI L3 per RIF memory accounting of the Next Hop and Neighbor
+ * nodes on the RIF. A node owned by both a Next Hop and a Neighbor is
+ * counted in both counts, and its bytes once.
+ */
+typedef struct _sai_fib_rif_mem_stats_t {
+
+    /** Number of nodes owned by a Next Hop */
+    uint_t     num_nh;
+
+    /** Number of nodes owned by a Neighbor */
+    uint_t     num_neighbors;
+
+    /** Bytes of the nodes */
+    uint64_t   bytes;
+} sai_fib_rif_mem_stats_t;
+
 /**
  * @brief SAI L3 VRF data structure. Contains the VR attributes.
  *
@@ -96,6 +202,12 @@ typedef struct _sai_fib_vrf_t {
     /** Route tree. Nodes of type sai_fib_route_t */
     std_rt_table    *sai_route_tree;
 
+    /** Route statistics for the routes in the route tree */
+    sai_fib_vrf_route_stats_t  route_stats;
+
+    /** Memory accounting of the nodes in the VRF trees */
+    sai_fib_vrf_mem_stats_t    mem_stats;
+
     /** Place holder for NPU-specific data */
     void            *hw_info;
 } sai_fib_vrf_t;
@@ -133,6 +245,9 @@ typedef struct _sai_fib_router_interface_t {
 
     uint_t                       ref_count;
 
+    /** Memory accounting of the Next Hop and Neighbor nodes on the RIF */
+    sai_fib_rif_mem_stats_t      mem_stats;
+
     /** Place holder for NPU-specific data */
     void                        *hw_info;
 } sai_fib_router_interface_t;
@@ -183,6 +298,9 @@ typedef struct _sai_fib_nh_t {
     /** Indicate if the node belongs to next hop and/or neighbor object */
     uint_t                      owner_flag;
 
+    /** Owner flags counted in the RIF memory stats of the node */
+    uint_t                      mem_stats_owner_flag;
+
     /** Packet action for the next-hop. */
     sai_packet_action_t         packet_action;
 
@@ -204,6 +322,9 @@ typedef struct _sai_fib_nh_t {
     /** Neighbor MAC entry node list pointers */
     std_dll                     mac_entry_link;
 
+    /** Next node in the same bucket of the (RIF, IP) hash index */
+    struct _sai_fib_nh_t       *p_hash_next;
+
     /** Place holder for NPU-specific data */
     void                       *hw_info;
 } sai_fib_nh_t;
@@ -232,6 +353,9 @@ typedef struct _sai_fib_neighbor_mac_entry_t {
 
     /** Head of the list of Neighbor nodes */
     std_dll_head                      neighbor_list;
+
+    /** VRF charged for the entry memory, the VRF of the first Neighbor */
+    sai_object_id_t                   vrf_id;
 } sai_fib_neighbor_mac_entry_t;
 
 /**
@@ -262,6 +386,28 @@ typedef struct _sai_fib_wt_link_node_t {
 
 } sai_fib_wt_link_node_t;
 
+/**
+ * @brief Resilient hashing bucket table of a NH Group. Member weights are
+ * expanded in a fixed number of buckets, and a member change reassigns
+ * only the buckets of the members added or removed.
+ *
+ */
+typedef struct _sai_fib_nh_group_bucket_table_t {
+
+    /** Number of buckets in the table */
+    uint_t              num_buckets;
+
+    /** Next Hop Id of each bucket, SAI_NULL_OBJECT_ID if the group is
+     * empty */
+    sai_object_id_t    *p_bucket_list;
+
+    /** Number of buckets reassigned since the table was built */
+    uint_t              num_changes;
+
+    /** All the buckets were programmed in NPU */
+    bool                is_programmed;
+} sai_fib_nh_group_bucket_table_t;
+
 /**
  * @brief Key structure for NH Group tree
  *
@@ -291,6 +437,9 @@ typedef struct _sai_fib_nh_group_t {
 
     uint_t                      ref_count;
 
+    /** Resilient hashing bucket table, NULL if not built for the group */
+    sai_fib_nh_group_bucket_table_t *p_bucket_table;
+
     /** Place holder for NPU-specific data */
     void                       *hw_info;
 } sai_fib_nh_group_t;
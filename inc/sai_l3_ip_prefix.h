@@ -0,0 +1,162 @@
+/************************************************************************
+* LEGALESE:   "Copyright (c) 2015, Dell Inc. All rights reserved."
+*
+* This source code is confidential, proprietary, and contains trade
+* secrets that are the sole property of Dell Inc.
+* Copy and/or distribution of this source code or disassembly or reverse
+* engineering of the resultant object code are strictly forbidden without
+* the written consent of Dell Inc.
+*
+************************************************************************/
+/**
+* @file sai_l3_ip_prefix.h
+*
+* @brief This file contains the IP prefix utility functions for SAI L3
+*        component.
+*
+*************************************************************************/
+#ifndef __SAI_L3_IP_PREFIX_H__
+#define __SAI_L3_IP_PREFIX_H__
+
+#include "std_type_defs.h"
+#include "saitypes.h"
+
+/** \defgroup SAIL3IPPREFIX SAI - L3 IP prefix functions
+ *  Prefix mask, containment and canonicalization functions on SAI IP
+ *  addresses. Addresses are in network byte order, as in the route and
+ *  next hop keys.
+ *
+ *  The functions work on one address at a time. Routes are staged one by
+ *  one in a route transaction and snapshot records are checked one by one,
+ *  each with its own prefix length, so no caller holds an array of IPv6
+ *  addresses of the same prefix length.
+ *
+ *  \{
+ */
+
+/** Prefix length of the IPv4-mapped IPv6 address block ::ffff:0:0/96 */
+#define SAI_FIB_IPV4_MAPPED_PREFIX_LEN   (96)
+
+/**
+ * @brief Validate the prefix length for an address family.
+ *
+ * @param[in] addr_family IP address family
+ * @param[in] prefix_len Prefix length
+ * @return SAI_STATUS_SUCCESS if the prefix length is valid, otherwise
+ *  SAI_STATUS_INVALID_PARAMETER.
+ */
+sai_status_t sai_fib_ip_prefix_len_validate (sai_ip_addr_family_t addr_family,
+                                             uint_t prefix_len);
+
+/**
+ * @brief Get the mask of a prefix length.
+ *
+ * @param[in] addr_family IP address family
+ * @param[in] prefix_len Prefix length
+ * @param[out] p_mask Mask in network byte order
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_ip_prefix_mask_get (sai_ip_addr_family_t addr_family,
+                                         uint_t prefix_len,
+                                         sai_ip_address_t *p_mask);
+
+/**
+ * @brief Get the prefix length of a contiguous mask.
+ *
+ * @param[in] p_mask Mask in network byte order
+ * @param[out] p_prefix_len Prefix length
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned. SAI_STATUS_INVALID_PARAMETER is returned if the
+ *  mask is not contiguous.
+ */
+sai_status_t sai_fib_ip_mask_to_prefix_len (const sai_ip_address_t *p_mask,
+                                            uint_t *p_prefix_len);
+
+/**
+ * @brief Canonicalize a prefix by clearing the host bits of the address.
+ *
+ * @param[inout] p_ip_addr IP address of the prefix
+ * @param[in] prefix_len Prefix length
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned. The address is not changed if the prefix length
+ *  is not valid for the address family.
+ */
+sai_status_t sai_fib_ip_prefix_canonicalize (sai_ip_address_t *p_ip_addr,
+                                             uint_t prefix_len);
+
+/**
+ * @brief Check whether the host bits of a prefix are all zero.
+ *
+ * @param[in] p_ip_addr IP address of the prefix
+ * @param[in] prefix_len Prefix length
+ * @return true if the prefix is canonical, false if not or if the prefix
+ *  length is not valid for the address family
+ */
+bool sai_fib_ip_prefix_is_canonical (const sai_ip_address_t *p_ip_addr,
+                                     uint_t prefix_len);
+
+/**
+ * @brief Check whether an IP address is in a prefix. An IPv4 address and
+ * its IPv4-mapped IPv6 address are handled as the same address.
+ *
+ * @param[in] p_prefix IP address of the prefix
+ * @param[in] prefix_len Prefix length
+ * @param[in] p_ip_addr IP address to check
+ * @return true if the address is in the prefix, false if not or if the
+ *  prefix length is not valid for the address family
+ */
+bool sai_fib_ip_prefix_contains (const sai_ip_address_t *p_prefix,
+                                 uint_t prefix_len,
+                                 const sai_ip_address_t *p_ip_addr);
+
+/**
+ * @brief Check whether a prefix is covered by another prefix.
+ *
+ * @param[in] p_prefix IP address of the covering prefix
+ * @param[in] prefix_len Prefix length of the covering prefix
+ * @param[in] p_sub_prefix IP address of the covered prefix
+ * @param[in] sub_prefix_len Prefix length of the covered prefix
+ * @return true if p_sub_prefix/sub_prefix_len is in p_prefix/prefix_len,
+ *  else false
+ */
+bool sai_fib_ip_prefix_covers (const sai_ip_address_t *p_prefix,
+                               uint_t prefix_len,
+                               const sai_ip_address_t *p_sub_prefix,
+                               uint_t sub_prefix_len);
+
+/**
+ * @brief Check whether an IPv6 address is an IPv4-mapped address.
+ *
+ * @param[in] p_ip_addr IP address
+ * @return true if the address is in ::ffff:0:0/96, else false
+ */
+bool sai_fib_ip_addr_is_v4_mapped (const sai_ip_address_t *p_ip_addr);
+
+/**
+ * @brief Convert an IPv4 address to its IPv4-mapped IPv6 address.
+ *
+ * @param[in] p_v4_addr IPv4 address
+ * @param[out] p_v6_addr IPv4-mapped IPv6 address
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_ip_addr_v4_to_v4_mapped (const sai_ip_address_t *p_v4_addr,
+                                              sai_ip_address_t *p_v6_addr);
+
+/**
+ * @brief Convert an IPv4-mapped IPv6 address to the IPv4 address.
+ *
+ * @param[in] p_v6_addr IPv4-mapped IPv6 address
+ * @param[out] p_v4_addr IPv4 address
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_ip_addr_v4_mapped_to_v4 (const sai_ip_address_t *p_v6_addr,
+                                              sai_ip_address_t *p_v4_addr);
+
+/**
+ * \}
+ */
+
+#endif /* __SAI_L3_IP_PREFIX_H__ */
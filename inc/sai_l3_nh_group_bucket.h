@@ -0,0 +1,128 @@
+/************************************************************************
+* LEGALESE:   "Copyright (c) 2015, Dell Inc. All rights reserved."
+*
+* This source code is confidential, proprietary, and contains trade
+* secrets that are the sole property of Dell Inc.
+* Copy and/or distribution of this source code or disassembly or reverse
+* engineering of the resultant object code are strictly forbidden without
+* the written consent of Dell Inc.
+*
+************************************************************************/
+/**
+* @file sai_l3_nh_group_bucket.h
+*
+* @brief This file contains the resilient hashing bucket table functions
+*        of the SAI L3 Next Hop Groups.
+*
+*************************************************************************/
+#ifndef __SAI_L3_NH_GROUP_BUCKET_H__
+#define __SAI_L3_NH_GROUP_BUCKET_H__
+
+#include "std_type_defs.h"
+#include "sai_l3_common.h"
+#include "sai_l3_api.h"
+#include "saitypes.h"
+
+/** \defgroup SAIL3NHGROUPBUCKET SAI - L3 NH Group bucket table functions
+ *  Resilient hashing bucket table of the Next Hop Groups.
+ *
+ *  The member weights of a group are expanded in a fixed number of
+ *  buckets, each member getting a share of the buckets proportional to its
+ *  weight. On a member change only the buckets of the removed members and
+ *  the buckets needed by the added members are reassigned, so flows hashed
+ *  to the other buckets keep their next hop.
+ *
+ *  \{
+ */
+
+/** Default number of buckets of a bucket table */
+#define SAI_FIB_NH_GROUP_DFLT_NUM_BUCKETS  (256)
+
+/** Maximum number of buckets of a bucket table */
+#define SAI_FIB_NH_GROUP_MAX_NUM_BUCKETS   (4096)
+
+/**
+ * @brief Build the bucket table of a NH group from the group members. The
+ * table is programmed in NPU on the next sai_fib_nh_group_bucket_table_sync().
+ * Called by sai_fib_nh_group_node_alloc() for groups with buckets.
+ *
+ * @warning Caller must hold the FIB lock.
+ *
+ * @param[in] p_group Pointer to the NH group node
+ * @param[in] num_buckets Number of buckets, 0 for the default
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_nh_group_bucket_table_create (sai_fib_nh_group_t *p_group,
+                                                   uint_t num_buckets);
+
+/**
+ * @brief Release the bucket table of a NH group. Called by
+ * sai_fib_nh_group_node_free().
+ *
+ * @warning Caller must hold the FIB lock.
+ *
+ * @param[in] p_group Pointer to the NH group node
+ */
+void sai_fib_nh_group_bucket_table_destroy (sai_fib_nh_group_t *p_group);
+
+/**
+ * @brief Update the bucket table of a NH group after a member change.
+ * Buckets of the members still in the group are kept up to the new share of
+ * each member, the other buckets are reassigned to the members below their
+ * share.
+ *
+ * @warning Caller must hold the FIB lock.
+ *
+ * @param[in] p_group Pointer to the NH group node
+ * @param[out] p_changed_list Indexes of the reassigned buckets, array of
+ *  num_buckets entries. NULL if not needed.
+ * @param[out] p_changed_count Number of reassigned buckets
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_nh_group_bucket_table_update (sai_fib_nh_group_t *p_group,
+                                                   uint_t *p_changed_list,
+                                                   uint_t *p_changed_count);
+
+/**
+ * @brief Update the bucket table of a NH group and program the reassigned
+ * buckets in NPU. All the buckets are programmed the first time. NPU is not
+ * programmed if it does not support resilient hashing.
+ *
+ * @warning Caller must hold the FIB lock.
+ *
+ * @param[in] p_group Pointer to the NH group node
+ * @param[in] p_nh_group_api NPU NH Group API table
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_nh_group_bucket_table_sync (sai_fib_nh_group_t *p_group,
+                                    const sai_npu_nh_group_api_t *p_nh_group_api);
+
+/**
+ * @brief Get the Next Hop Id of the bucket of a flow hash.
+ *
+ * @param[in] p_group Pointer to the NH group node
+ * @param[in] hash Flow hash
+ * @return Next Hop Id, SAI_NULL_OBJECT_ID if the group has no bucket table
+ *  or no member.
+ */
+sai_object_id_t sai_fib_nh_group_bucket_nh_id_get (sai_fib_nh_group_t *p_group,
+                                                   uint32_t hash);
+
+/**
+ * @brief Get the number of buckets of a Next Hop in a NH group.
+ *
+ * @param[in] p_group Pointer to the NH group node
+ * @param[in] next_hop_id Next Hop Id
+ * @return Number of buckets.
+ */
+uint_t sai_fib_nh_group_bucket_count_get (sai_fib_nh_group_t *p_group,
+                                          sai_object_id_t next_hop_id);
+
+/**
+ * \}
+ */
+
+#endif /* __SAI_L3_NH_GROUP_BUCKET_H__ */
@@ -0,0 +1,106 @@
+/************************************************************************
+* LEGALESE:   "Copyright (c) 2015, Dell Inc. All rights reserved."
+*
+* This source code is confidential, proprietary, and contains trade
+* secrets that are the sole property of Dell Inc.
+* Copy and/or distribution of this source code or disassembly or reverse
+* engineering of the resultant object code are strictly forbidden without
+* the written consent of Dell Inc.
+*
+************************************************************************/
+/**
+* @file sai_l3_nh_hash.h
+*
+* @brief This file contains the (RIF, IP) hash index functions of the SAI
+*        L3 Next Hop and Neighbor nodes.
+*
+*************************************************************************/
+#ifndef __SAI_L3_NH_HASH_H__
+#define __SAI_L3_NH_HASH_H__
+
+#include "std_type_defs.h"
+#include "sai_l3_common.h"
+#include "saitypes.h"
+
+/** \defgroup SAIL3NHHASH SAI - L3 Next Hop hash index functions
+ *  Hash index of the Next Hop and Neighbor nodes on the router interface
+ *  and the IP address.
+ *
+ *  The index holds the same nodes as the VRF Next Hop radix trees and
+ *  resolves an exact (RIF, IP) lookup in constant time. The nodes are
+ *  chained in their buckets, so the index does not allocate per node.
+ *  The bucket array is doubled when the index holds more nodes than
+ *  buckets.
+ *
+ *  \{
+ */
+
+/** Initial number of buckets of the Next Hop hash index */
+#define SAI_FIB_NH_HASH_DFLT_NUM_BUCKETS  (1024)
+
+/**
+ * @brief Initialize the Next Hop hash index.
+ *
+ * @param[in] num_buckets Initial number of buckets, rounded up to a power
+ *  of 2. 0 for the default.
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_nh_hash_init (uint_t num_buckets);
+
+/**
+ * @brief Release the Next Hop hash index. Nodes are not freed.
+ */
+void sai_fib_nh_hash_deinit (void);
+
+/**
+ * @brief Add a Next Hop node to the hash index.
+ *
+ * @warning Caller must hold the FIB lock.
+ *
+ * @param[in] p_next_hop Pointer to the Next Hop node
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_nh_hash_insert (sai_fib_nh_t *p_next_hop);
+
+/**
+ * @brief Remove a Next Hop node from the hash index.
+ *
+ * @warning Caller must hold the FIB lock.
+ *
+ * @param[in] p_next_hop Pointer to the Next Hop node
+ */
+void sai_fib_nh_hash_remove (sai_fib_nh_t *p_next_hop);
+
+/**
+ * @brief Find the Next Hop node of a router interface and an IP address.
+ *
+ * @warning Caller must hold the FIB lock or the FIB read lock.
+ *
+ * @param[in] rif_id Router interface Id
+ * @param[in] p_ip_addr IP address of the Next Hop
+ * @return Pointer to the Next Hop node if found otherwise NULL
+ */
+sai_fib_nh_t *sai_fib_nh_hash_lookup (sai_object_id_t rif_id,
+                                      const sai_ip_address_t *p_ip_addr);
+
+/**
+ * @brief Check whether the Next Hop hash index is initialized.
+ *
+ * @return true if the index is initialized, else false
+ */
+bool sai_fib_nh_hash_is_init (void);
+
+/**
+ * @brief Get the length of the longest bucket chain of the hash index.
+ *
+ * @return Number of nodes in the longest bucket chain.
+ */
+uint_t sai_fib_nh_hash_max_chain_len_get (void);
+
+/**
+ * \}
+ */
+
+#endif /* __SAI_L3_NH_HASH_H__ */
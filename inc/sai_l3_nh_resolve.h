@@ -0,0 +1,206 @@
+/************************************************************************
+* LEGALESE:   "Copyright (c) 2015, Dell Inc. All rights reserved."
+*
+* This source code is confidential, proprietary, and contains trade
+* secrets that are the sole property of Dell Inc.
+* Copy and/or distribution of this source code or disassembly or reverse
+* engineering of the resultant object code are strictly forbidden without
+* the written consent of Dell Inc.
+*
+************************************************************************/
+/**
+* @file sai_l3_nh_resolve.h
+*
+* @brief This file contains the recursive next hop resolution functions of
+*        the SAI L3 component.
+*
+*************************************************************************/
+#ifndef __SAI_L3_NH_RESOLVE_H__
+#define __SAI_L3_NH_RESOLVE_H__
+
+#include "std_type_defs.h"
+#include "sai_l3_common.h"
+#include "saitypes.h"
+
+/** \defgroup SAIL3NHRESOLVE SAI - L3 Recursive next hop resolution
+ *  Resolution of recursive next hop addresses on the VRF route trees.
+ *
+ *  A registered next hop address is resolved to the longest prefix match
+ *  route of its VRF, and is kept as a dependent of that route, or of the
+ *  VRF unresolved list if no route covers it. When a route is added, only
+ *  the dependents of its less specific covering route that the new route
+ *  covers are moved to it. When a route is removed, its dependents move to
+ *  its less specific covering route. Resolution changes are queued and
+ *  notified in batches.
+ *
+ *  Dependents are kept by route prefix, not by route node, so a route
+ *  freed without sai_fib_nh_resolve_route_remove() leaves no dangling
+ *  reference. Its dependents resolve to their longest prefix match until
+ *  the next route hook or sai_fib_nh_resolve_refresh_all() moves them.
+ *
+ *  The resolution is optional and the route hooks do nothing until
+ *  sai_fib_nh_resolve_init() is called.
+ *
+ *  \{
+ */
+
+/** Default number of resolution changes notified in a batch */
+#define SAI_FIB_NH_RESOLVE_DFLT_BATCH_SIZE  (64)
+
+/**
+ * @brief Resolution of a recursive next hop address.
+ */
+typedef struct _sai_fib_nh_resolve_info_t {
+    sai_object_id_t      vrf_id;
+    sai_ip_address_t     ip_addr;
+
+    /** A route covers the address */
+    bool                 is_resolved;
+
+    /** Covering route prefix and prefix length, valid if resolved */
+    sai_ip_address_t     prefix;
+    uint_t               prefix_len;
+
+    /** Next Hop or Next Hop Group Id and packet action of the covering
+     * route, valid if resolved */
+    sai_object_id_t      nh_id;
+    sai_packet_action_t  packet_action;
+
+    /** Cookie given at registration */
+    void                *p_cookie;
+} sai_fib_nh_resolve_info_t;
+
+/**
+ * @brief Callback notifying a batch of resolution changes.
+ *
+ * @param[in] p_info_list Array of the new resolutions
+ * @param[in] count Number of resolutions in the array
+ */
+typedef void (*sai_fib_nh_resolve_notify_fn) (
+                                const sai_fib_nh_resolve_info_t *p_info_list,
+                                uint_t count);
+
+/**
+ * @brief Initialize the recursive next hop resolution.
+ *
+ * @param[in] notify_fn Callback notifying the resolution changes
+ * @param[in] batch_size Number of changes notified at a time, 0 for the
+ *  default
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_nh_resolve_init (sai_fib_nh_resolve_notify_fn notify_fn,
+                                      uint_t batch_size);
+
+/**
+ * @brief Release all the registrations of the recursive next hop resolution.
+ * Pending changes are dropped.
+ */
+void sai_fib_nh_resolve_deinit (void);
+
+/**
+ * @brief Register a recursive next hop address. Registrations of the same
+ * address are counted and share the first cookie.
+ *
+ * @warning Caller must hold the FIB lock.
+ *
+ * @param[in] vrf_id VRF Id
+ * @param[in] p_ip_addr Next hop address
+ * @param[in] p_cookie Cookie returned in the notifications
+ * @param[out] p_info Current resolution. Can be NULL.
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_nh_resolve_register (sai_object_id_t vrf_id,
+                                          const sai_ip_address_t *p_ip_addr,
+                                          void *p_cookie,
+                                          sai_fib_nh_resolve_info_t *p_info);
+
+/**
+ * @brief Release a registration of a recursive next hop address.
+ *
+ * @warning Caller must hold the FIB lock.
+ *
+ * @param[in] vrf_id VRF Id
+ * @param[in] p_ip_addr Next hop address
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_nh_resolve_unregister (sai_object_id_t vrf_id,
+                                            const sai_ip_address_t *p_ip_addr);
+
+/**
+ * @brief Get the current resolution of a registered next hop address.
+ *
+ * @warning Caller must hold the FIB lock or the FIB read lock.
+ *
+ * @param[in] vrf_id VRF Id
+ * @param[in] p_ip_addr Next hop address
+ * @param[out] p_info Current resolution
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_nh_resolve_info_get (sai_object_id_t vrf_id,
+                                          const sai_ip_address_t *p_ip_addr,
+                                          sai_fib_nh_resolve_info_t *p_info);
+
+/**
+ * @brief Re-resolve the dependents of the less specific route of a route
+ * added to the VRF route tree.
+ *
+ * @warning Caller must hold the FIB lock. Route must be in the route tree.
+ *
+ * @param[in] p_route Pointer to the route node
+ */
+void sai_fib_nh_resolve_route_add (sai_fib_route_t *p_route);
+
+/**
+ * @brief Move the dependents of a route removed from the VRF route tree to
+ * its less specific route. Must be called before the route node is freed.
+ *
+ * @warning Caller must hold the FIB lock. Route must not be in the route
+ * tree.
+ *
+ * @param[in] p_route Pointer to the route node
+ */
+void sai_fib_nh_resolve_route_remove (sai_fib_route_t *p_route);
+
+/**
+ * @brief Refresh the dependents of a route whose next hop or packet action
+ * changed.
+ *
+ * @warning Caller must hold the FIB lock.
+ *
+ * @param[in] p_route Pointer to the route node
+ */
+void sai_fib_nh_resolve_route_update (sai_fib_route_t *p_route);
+
+/**
+ * @brief Re-resolve all the registered addresses. Used after the route
+ * trees are changed without the route hooks, e.g. a bulk load.
+ *
+ * @warning Caller must hold the FIB lock.
+ */
+void sai_fib_nh_resolve_refresh_all (void);
+
+/**
+ * @brief Notify the pending resolution changes.
+ *
+ * @warning Caller must hold the FIB lock.
+ */
+void sai_fib_nh_resolve_notify_flush (void);
+
+/**
+ * @brief Get the number of registered next hop addresses.
+ *
+ * @param[out] p_unresolved_count Number of the addresses not resolved. Can
+ *  be NULL.
+ * @return Number of registered addresses.
+ */
+uint_t sai_fib_nh_resolve_count_get (uint_t *p_unresolved_count);
+
+/**
+ * \}
+ */
+
+#endif /* __SAI_L3_NH_RESOLVE_H__ */
@@ -0,0 +1,211 @@
+/************************************************************************
+* LEGALESE:   "Copyright (c) 2015, Dell Inc. All rights reserved."
+*
+* This source code is confidential, proprietary, and contains trade
+* secrets that are the sole property of Dell Inc.
+* Copy and/or distribution of this source code or disassembly or reverse
+* engineering of the resultant object code are strictly forbidden without
+* the written consent of Dell Inc.
+*
+************************************************************************/
+/**
+* @file sai_l3_reconcile.h
+*
+* @brief This file contains the reconciliation functions of the SAI L3
+*        software FIB with the NPU.
+*
+*************************************************************************/
+#ifndef __SAI_L3_RECONCILE_H__
+#define __SAI_L3_RECONCILE_H__
+
+#include "std_type_defs.h"
+#include "sai_l3_common.h"
+#include "sai_l3_api.h"
+#include "saitypes.h"
+
+/** \defgroup SAIL3RECONCILE SAI - L3 NPU reconciliation functions
+ *  Comparison of the Next Hop, Next Hop Group and Route entries of the
+ *  software FIB with the entries programmed in the NPU.
+ *
+ *  The software FIB and the NPU keys are streamed in the same order and
+ *  merged. Entries only in the software FIB are reported as ADD, entries
+ *  only in the NPU as REMOVE, and entries in both are read back with the
+ *  NPU attribute get functions and reported as MODIFY if they differ.
+ *  NPU keys are read in windows of batch_size keys and repairs are queued
+ *  in a batch of the same size, so memory does not grow with the FIB size.
+ *
+ *  \{
+ */
+
+/** Default number of NPU keys read and repairs queued at a time */
+#define SAI_FIB_RECONCILE_DFLT_BATCH_SIZE  (256)
+
+/**
+ * @brief Objects reconciled, in the order they are compared.
+ */
+typedef enum _sai_fib_reconcile_obj_t {
+
+    SAI_FIB_RECONCILE_OBJ_NEXT_HOP,
+    SAI_FIB_RECONCILE_OBJ_NH_GROUP,
+    SAI_FIB_RECONCILE_OBJ_ROUTE,
+    SAI_FIB_RECONCILE_OBJ_MAX,
+
+} sai_fib_reconcile_obj_t;
+
+/**
+ * @brief Difference of an entry between the software FIB and the NPU.
+ */
+typedef enum _sai_fib_reconcile_diff_type_t {
+
+    /** Entry is in the software FIB only */
+    SAI_FIB_RECONCILE_DIFF_ADD,
+
+    /** Entry is in the NPU only */
+    SAI_FIB_RECONCILE_DIFF_REMOVE,
+
+    /** Entry attributes in the NPU differ from the software FIB */
+    SAI_FIB_RECONCILE_DIFF_MODIFY,
+
+    SAI_FIB_RECONCILE_DIFF_MAX,
+
+} sai_fib_reconcile_diff_type_t;
+
+/**
+ * @brief Route key of the reconciliation.
+ */
+typedef struct _sai_fib_reconcile_route_key_t {
+    sai_object_id_t   vrf_id;
+
+    /** Prefix address with the host bits cleared */
+    sai_ip_address_t  prefix;
+    uint_t            prefix_len;
+} sai_fib_reconcile_route_key_t;
+
+/**
+ * @brief Key of a reconciled entry. Next Hop Id, Next Hop Group Id or
+ * route key based on the object.
+ */
+typedef union _sai_fib_reconcile_key_t {
+    sai_object_id_t                next_hop_id;
+    sai_object_id_t                group_id;
+    sai_fib_reconcile_route_key_t  route;
+} sai_fib_reconcile_key_t;
+
+/**
+ * @brief Callback to read the keys of the entries programmed in the NPU.
+ *
+ * @param[in] obj_type Object of the keys
+ * @param[in] p_after_key Keys greater than this key are returned, NULL to
+ *  get the first keys
+ * @param[in] max_count Size of the key array
+ * @param[out] p_key_list Keys in increasing order as per
+ *  sai_fib_reconcile_key_compare()
+ * @param[out] p_count Number of keys returned, 0 if there are no more keys
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+typedef sai_status_t (*sai_fib_reconcile_hw_keys_get_fn) (
+                                      sai_fib_reconcile_obj_t obj_type,
+                                      const sai_fib_reconcile_key_t *p_after_key,
+                                      uint_t max_count,
+                                      sai_fib_reconcile_key_t *p_key_list,
+                                      uint_t *p_count);
+
+/**
+ * @brief Difference reported by the reconciliation.
+ */
+typedef struct _sai_fib_reconcile_diff_t {
+    sai_fib_reconcile_obj_t        obj_type;
+    sai_fib_reconcile_diff_type_t  diff_type;
+    sai_fib_reconcile_key_t        key;
+
+    /** Software FIB node, sai_fib_nh_t, sai_fib_nh_group_t or
+     * sai_fib_route_t based on obj_type. NULL for REMOVE */
+    void                          *p_node;
+} sai_fib_reconcile_diff_t;
+
+/**
+ * @brief Callback to report a difference.
+ *
+ * @param[in] p_diff Difference of an entry
+ * @param[in] p_cookie Cookie of the reconciliation parameters
+ */
+typedef void (*sai_fib_reconcile_diff_fn) (const sai_fib_reconcile_diff_t *p_diff,
+                                           void *p_cookie);
+
+/**
+ * @brief Reconciliation parameters.
+ */
+typedef struct _sai_fib_reconcile_params_t {
+
+    /** NPU key read callback */
+    sai_fib_reconcile_hw_keys_get_fn  hw_keys_get;
+
+    /** NPU API tables used for the attribute read back and the repair */
+    const sai_npu_nexthop_api_t      *p_nexthop_api;
+    const sai_npu_nh_group_api_t     *p_nh_group_api;
+    const sai_npu_route_api_t        *p_route_api;
+
+    /** Program the NPU to match the software FIB */
+    bool                              repair;
+
+    /** Keys read and repairs queued at a time, 0 for the default */
+    uint_t                            batch_size;
+
+    /** Optional difference callback and its cookie */
+    sai_fib_reconcile_diff_fn         diff_fn;
+    void                             *p_cookie;
+} sai_fib_reconcile_params_t;
+
+/**
+ * @brief Reconciliation result counters.
+ */
+typedef struct _sai_fib_reconcile_result_t {
+    uint_t  diff_count [SAI_FIB_RECONCILE_OBJ_MAX][SAI_FIB_RECONCILE_DIFF_MAX];
+    uint_t  repair_count [SAI_FIB_RECONCILE_OBJ_MAX][SAI_FIB_RECONCILE_DIFF_MAX];
+    uint_t  repair_fail_count [SAI_FIB_RECONCILE_OBJ_MAX][SAI_FIB_RECONCILE_DIFF_MAX];
+} sai_fib_reconcile_result_t;
+
+/**
+ * @brief Compare two reconciliation keys. Ids are ordered as the FIB Id
+ * trees and routes by VRF as the VRF tree, then as the VRF route tree.
+ *
+ * @param[in] obj_type Object of the keys
+ * @param[in] p_key_1 First key
+ * @param[in] p_key_2 Second key
+ * @return Negative, 0 or positive if the first key is lower, equal or
+ *  greater than the second key.
+ */
+int sai_fib_reconcile_key_compare (sai_fib_reconcile_obj_t obj_type,
+                                   const sai_fib_reconcile_key_t *p_key_1,
+                                   const sai_fib_reconcile_key_t *p_key_2);
+
+/**
+ * @brief Reconcile the software FIB with the NPU.
+ *
+ * With repair set, next hops and groups missing in the NPU are created
+ * first, then routes are added, updated and removed, and the stale groups
+ * and next hops are removed last. Stale NPU entries are removed through a
+ * transient node that has only the key fields set. Next hop attribute
+ * differences are reported but not repaired, as the NPU API has no next
+ * hop attribute set. A next hop or group that the NPU recreates with a
+ * different Id is removed again and the repair fails, as the Id is known to
+ * the SAI user. A modified route is removed and created again, as the NPU
+ * API has no route attribute set, and its traffic is hit in between.
+ *
+ * @warning Caller must hold the FIB lock.
+ *
+ * @param[in] p_params Reconciliation parameters
+ * @param[out] p_result Result counters
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned. Repair failures are counted in the result and do
+ *  not fail the reconciliation.
+ */
+sai_status_t sai_fib_reconcile_run (const sai_fib_reconcile_params_t *p_params,
+                                    sai_fib_reconcile_result_t *p_result);
+
+/**
+ * \}
+ */
+
+#endif /* __SAI_L3_RECONCILE_H__ */
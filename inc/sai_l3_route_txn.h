@@ -0,0 +1,315 @@
+/************************************************************************
+* LEGALESE:   "Copyright (c) 2015, Dell Inc. All rights reserved."
+*
+* This source code is confidential, proprietary, and contains trade
+* secrets that are the sole property of Dell Inc.
+* Copy and/or distribution of this source code or disassembly or reverse
+* engineering of the resultant object code are strictly forbidden without
+* the written consent of Dell Inc.
+*
+************************************************************************/
+/**
+* @file sai_l3_route_txn.h
+*
+* @brief This file contains the datastructure definitions and utility
+*        functions for SAI L3 route transactions.
+*
+*************************************************************************/
+#ifndef __SAI_L3_ROUTE_TXN_H__
+#define __SAI_L3_ROUTE_TXN_H__
+
+#include "std_type_defs.h"
+#include "sai_l3_common.h"
+#include "sai_l3_api.h"
+#include "saitypes.h"
+
+/** \defgroup SAIL3ROUTETXN SAI - L3 Route transaction utility functions
+ *  Journal based transactions for Route, Next Hop and Next Hop Group
+ *  changes in the SAI L3 component.
+ *
+ *  Changes are staged in a journal, programmed in the NPU in journal
+ *  order at commit and only then applied to the software FIB. If any NPU
+ *  operation fails, the already programmed entries are reverted in the NPU
+ *  in reverse order and the software FIB is left untouched.
+ *
+ *  \{
+ */
+
+/** Initial number of entries allocated for a transaction journal */
+#define SAI_FIB_ROUTE_TXN_DFLT_JOURNAL_SIZE    (64)
+
+/** Maximum number of group member changes batched in one NPU call */
+#define SAI_FIB_ROUTE_TXN_MAX_NH_BATCH         (64)
+
+/**
+ * @brief Operation type of a transaction journal entry.
+ */
+typedef enum _sai_fib_route_txn_op_t {
+
+    /** Create a next hop. Node is added to the NH trees on commit */
+    SAI_FIB_ROUTE_TXN_OP_NEXT_HOP_CREATE,
+
+    /** Remove a next hop. Node is removed from the NH trees on commit */
+    SAI_FIB_ROUTE_TXN_OP_NEXT_HOP_REMOVE,
+
+    /** Add a next hop member to a next hop group */
+    SAI_FIB_ROUTE_TXN_OP_NH_GROUP_MEMBER_ADD,
+
+    /** Remove a next hop member from a next hop group */
+    SAI_FIB_ROUTE_TXN_OP_NH_GROUP_MEMBER_REMOVE,
+
+    /** Create a route. Node is added to the VRF route tree on commit */
+    SAI_FIB_ROUTE_TXN_OP_ROUTE_CREATE,
+
+    /** Remove a route. Node is removed from the VRF route tree on commit */
+    SAI_FIB_ROUTE_TXN_OP_ROUTE_REMOVE,
+
+} sai_fib_route_txn_op_t;
+
+/**
+ * @brief State of a route transaction.
+ */
+typedef enum _sai_fib_route_txn_state_t {
+
+    /** Transaction is accepting staged changes */
+    SAI_FIB_ROUTE_TXN_STATE_OPEN,
+
+    /** Journal is programmed in NPU and applied to the software FIB */
+    SAI_FIB_ROUTE_TXN_STATE_COMMITTED,
+
+    /** Journal is reverted in NPU and software FIB is left untouched */
+    SAI_FIB_ROUTE_TXN_STATE_ROLLED_BACK,
+
+} sai_fib_route_txn_state_t;
+
+/**
+ * @brief Callback to release a FIB node that is no longer referenced by
+ * the software FIB at the end of the transaction.
+ *
+ * @param[in] op Journal operation of the node. Route operations pass a
+ * sai_fib_route_t node and next hop operations pass a sai_fib_nh_t node.
+ * @param[in] p_node Pointer to the node
+ */
+typedef void (*sai_fib_route_txn_release_fn) (sai_fib_route_txn_op_t op,
+                                              void *p_node);
+
+/**
+ * @brief Transaction journal entry.
+ */
+typedef struct _sai_fib_route_txn_entry_t {
+
+    /** Operation staged in this entry */
+    sai_fib_route_txn_op_t      op;
+
+    union {
+        /** Route node for route operations */
+        sai_fib_route_t        *p_route;
+
+        /** Next hop node for next hop operations */
+        sai_fib_nh_t           *p_next_hop;
+
+        /** Group and member for next hop group member operations */
+        struct {
+            sai_fib_nh_group_t *p_group;
+            sai_fib_nh_t       *p_next_hop;
+        } member;
+    } obj;
+
+    /** Link nodes preallocated at stage time for member add, so that the
+     * software FIB update on commit cannot fail */
+    sai_fib_wt_link_node_t     *p_nh_link;
+    sai_fib_wt_link_node_t     *p_group_link;
+
+    /** Entry is programmed in NPU */
+    bool                        is_hw_done;
+
+    /** Number of journal entries programmed by the NPU call issued for this
+     * entry. 0 if the entry was programmed by the call of a previous one */
+    uint_t                      hw_batch_count;
+} sai_fib_route_txn_entry_t;
+
+/**
+ * @brief SAI L3 route transaction. Contains the journal of staged changes.
+ */
+typedef struct _sai_fib_route_txn_t {
+
+    /** Transaction state */
+    sai_fib_route_txn_state_t         state;
+
+    /** Journal of staged changes */
+    sai_fib_route_txn_entry_t        *p_journal;
+
+    /** Number of entries staged in the journal */
+    uint_t                            num_entries;
+
+    /** Number of entries allocated for the journal */
+    uint_t                            max_entries;
+
+    /** Index of the journal entry that failed in NPU */
+    uint_t                            failed_index;
+
+    /** Index of the staged route and next hop ops on their key, to find a
+     * staged op without a journal scan */
+    rbtree_handle                     entry_index_tree;
+
+    /** Next hop reference count changes of the staged entries */
+    rbtree_handle                     nh_ref_tree;
+
+    /** Callback to release unreferenced FIB nodes. If NULL, nodes are freed
+     * with free() */
+    sai_fib_route_txn_release_fn      release_fn;
+
+    /** NPU API tables used on commit and rollback */
+    const sai_npu_route_api_t        *p_route_api;
+    const sai_npu_nexthop_api_t      *p_nexthop_api;
+    const sai_npu_nh_group_api_t     *p_nh_group_api;
+} sai_fib_route_txn_t;
+
+/**
+ * @brief Begin a route transaction.
+ *
+ * @param[in] p_route_api  NPU Route API table
+ * @param[in] p_nexthop_api  NPU Next Hop API table
+ * @param[in] p_nh_group_api  NPU Next Hop Group API table
+ * @param[in] release_fn  Callback to release unreferenced FIB nodes at the
+ * end of the transaction. If NULL, nodes are freed with free().
+ * @param[out] pp_txn  Pointer to the allocated transaction
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_route_txn_begin (const sai_npu_route_api_t *p_route_api,
+                                      const sai_npu_nexthop_api_t *p_nexthop_api,
+                                      const sai_npu_nh_group_api_t *p_nh_group_api,
+                                      sai_fib_route_txn_release_fn release_fn,
+                                      sai_fib_route_txn_t **pp_txn);
+
+/**
+ * @brief Stage a route create. Route node must be fully filled, with the
+ * key, prefix length, VRF and next hop information, but not added to the
+ * VRF route tree. Host bits of the key prefix are cleared. A route key
+ * can be staged for create only once per transaction.
+ *
+ * @param[in] p_txn  Pointer to the transaction
+ * @param[in] p_route  Pointer to the route node
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_route_txn_route_create (sai_fib_route_txn_t *p_txn,
+                                             sai_fib_route_t *p_route);
+
+/**
+ * @brief Stage a route remove. Route node must be present in the VRF
+ * route tree.
+ *
+ * @param[in] p_txn  Pointer to the transaction
+ * @param[in] p_route  Pointer to the route node
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_route_txn_route_remove (sai_fib_route_txn_t *p_txn,
+                                             sai_fib_route_t *p_route);
+
+/**
+ * @brief Stage a next hop create. Next hop node must be filled with the
+ * key and VRF but not added to the next hop trees. next_hop_id is filled
+ * on commit from the NPU object id.
+ *
+ * @param[in] p_txn  Pointer to the transaction
+ * @param[in] p_next_hop  Pointer to the next hop node
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_route_txn_next_hop_create (sai_fib_route_txn_t *p_txn,
+                                                sai_fib_nh_t *p_next_hop);
+
+/**
+ * @brief Stage a next hop remove. Next hop must not be used by a route or
+ * a next hop group once the entries staged before it are applied. Uses are
+ * the next hop ref_count, which counts the routes and the group member
+ * weights, changed by the staged route and member entries.
+ *
+ * @param[in] p_txn  Pointer to the transaction
+ * @param[in] p_next_hop  Pointer to the next hop node
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_route_txn_next_hop_remove (sai_fib_route_txn_t *p_txn,
+                                                sai_fib_nh_t *p_next_hop);
+
+/**
+ * @brief Stage the addition of next hop(s) to a next hop group.
+ *
+ * @param[in] p_txn  Pointer to the transaction
+ * @param[in] p_group  Pointer to the next hop group node
+ * @param[in] next_hop_count  Number of next hops
+ * @param[in] ap_next_hop  Array of pointer to the next hop node(s)
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_route_txn_nh_group_member_add (sai_fib_route_txn_t *p_txn,
+                                                    sai_fib_nh_group_t *p_group,
+                                                    uint_t next_hop_count,
+                                                    sai_fib_nh_t *ap_next_hop []);
+
+/**
+ * @brief Stage the removal of next hop(s) from a next hop group.
+ *
+ * @param[in] p_txn  Pointer to the transaction
+ * @param[in] p_group  Pointer to the next hop group node
+ * @param[in] next_hop_count  Number of next hops
+ * @param[in] ap_next_hop  Array of pointer to the next hop node(s)
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_route_txn_nh_group_member_remove (
+                                                    sai_fib_route_txn_t *p_txn,
+                                                    sai_fib_nh_group_t *p_group,
+                                                    uint_t next_hop_count,
+                                                    sai_fib_nh_t *ap_next_hop []);
+
+/**
+ * @brief Commit the staged changes. Journal entries are programmed in the
+ * NPU in order, consecutive member changes on the same group being batched
+ * in one NPU call. On success, the software FIB is updated in one pass,
+ * the bucket tables of the changed groups are updated and the recursive next
+ * hop resolution changes are notified.
+ * On failure, the programmed entries are reverted in the NPU and the
+ * software FIB is not modified.
+ *
+ * @warning Caller must hold the FIB lock for the duration of the commit.
+ *
+ * @param[in] p_txn  Pointer to the transaction
+ * @param[out] p_failed_index  Index of the journal entry that failed in NPU.
+ * Can be NULL.
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise the error
+ *  code returned by the NPU for the failed entry.
+ */
+sai_status_t sai_fib_route_txn_commit (sai_fib_route_txn_t *p_txn,
+                                       uint_t *p_failed_index);
+
+/**
+ * @brief End the transaction and free the journal. If committed, removed
+ * route and next hop nodes are released. Otherwise, staged route and
+ * next hop nodes are released as they were never added to the FIB.
+ *
+ * @param[in] p_txn  Pointer to the transaction
+ */
+void sai_fib_route_txn_end (sai_fib_route_txn_t *p_txn);
+
+/**
+ * @brief Utility to get number of staged entries in the transaction.
+ *
+ * @param[in] p_txn  Pointer to the transaction
+ * @return Number of staged entries.
+ */
+static inline uint_t sai_fib_route_txn_num_entries_get (
+                                           const sai_fib_route_txn_t *p_txn)
+{
+    return (p_txn->num_entries);
+}
+
+/**
+ * \}
+ */
+
+#endif /* __SAI_L3_ROUTE_TXN_H__ */
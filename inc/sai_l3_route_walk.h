@@ -0,0 +1,204 @@
+/************************************************************************
+* LEGALESE:   "Copyright (c) 2015, Dell Inc. All rights reserved."
+*
+* This source code is confidential, proprietary, and contains trade
+* secrets that are the sole property of Dell Inc.
+* Copy and/or distribution of this source code or disassembly or reverse
+* engineering of the resultant object code are strictly forbidden without
+* the written consent of Dell Inc.
+*
+************************************************************************/
+/**
+* @file sai_l3_route_walk.h
+*
+* @brief This file contains the route walk functions for SAI L3 component.
+*
+*************************************************************************/
+#ifndef __SAI_L3_ROUTE_WALK_H__
+#define __SAI_L3_ROUTE_WALK_H__
+
+#include "std_type_defs.h"
+#include "sai_l3_common.h"
+#include "saitypes.h"
+
+/** \defgroup SAIL3ROUTEWALK SAI - L3 Route walk functions
+ *  Walk of the VRF route trees with a callback and a filter.
+ *
+ *  The route key space of a VRF can be split in ranges on the leading
+ *  bits of the prefix address. Ranges can be walked independently, and
+ *  sai_fib_route_walk_parallel() walks the ranges of a set of VRFs on a
+ *  set of worker threads. The workers release the FIB read lock every
+ *  SAI_FIB_ROUTE_WALK_CHUNK_SIZE routes so that FIB updates are not held
+ *  off for the whole walk. The walk is over a consistent view of the FIB:
+ *  it fails if the FIB is changed before all the routes are walked.
+ *
+ *  \{
+ */
+
+/** Maximum number of prefix address bits used to split a route walk */
+#define SAI_FIB_ROUTE_WALK_MAX_SPLIT_BITS     (8)
+
+/** Maximum number of worker threads of a parallel route walk */
+#define SAI_FIB_ROUTE_WALK_MAX_THREADS        (32)
+
+/** Number of routes visited by a parallel walk worker per FIB read lock */
+#define SAI_FIB_ROUTE_WALK_CHUNK_SIZE         (256)
+
+/** Filter on the route address family */
+#define SAI_FIB_ROUTE_WALK_FILTER_ADDR_FAMILY (0x1)
+
+/** Filter on the route prefix length range */
+#define SAI_FIB_ROUTE_WALK_FILTER_PREFIX_LEN  (0x2)
+
+/** Filter on routes covered by a prefix of the same address family */
+#define SAI_FIB_ROUTE_WALK_FILTER_PREFIX      (0x4)
+
+/** Filter on the route Next Hop or Next Hop Group Id */
+#define SAI_FIB_ROUTE_WALK_FILTER_NH_ID       (0x8)
+
+/**
+ * @brief Route walk filter. Only the fields of the flags set are used.
+ */
+typedef struct _sai_fib_route_walk_filter_t {
+
+    /** Bitmap of SAI_FIB_ROUTE_WALK_FILTER_* flags */
+    uint_t                flags;
+
+    sai_ip_addr_family_t  addr_family;
+
+    /** Prefix length range, both inclusive */
+    uint_t                min_prefix_len;
+    uint_t                max_prefix_len;
+
+    /** Covering prefix */
+    sai_ip_address_t      prefix;
+    uint_t                prefix_len;
+
+    /** Next Hop or Next Hop Group Id of the route */
+    sai_object_id_t       nh_id;
+} sai_fib_route_walk_filter_t;
+
+/**
+ * @brief Range of the route key space of a VRF. Contains the routes of the
+ * address family with index as the leading split_bits of the prefix
+ * address.
+ */
+typedef struct _sai_fib_route_walk_range_t {
+    sai_object_id_t       vrf_id;
+    sai_ip_addr_family_t  addr_family;
+    uint_t                split_bits;
+    uint_t                index;
+} sai_fib_route_walk_range_t;
+
+/**
+ * @brief Route walk callback.
+ *
+ * @param[in] p_route Pointer to the route node. Must not be modified.
+ * @param[in] p_cookie Cookie passed to the walk function
+ * @return SAI_STATUS_SUCCESS to continue the walk, any other value stops the
+ *  walk and is returned by the walk function.
+ */
+typedef sai_status_t (*sai_fib_route_walk_fn) (sai_fib_route_t *p_route,
+                                               void *p_cookie);
+
+/**
+ * @brief Check whether a route matches a walk filter.
+ *
+ * @param[in] p_route Pointer to the route node
+ * @param[in] p_filter Route walk filter, NULL matches all the routes
+ * @return true if the route matches the filter, else false
+ */
+bool sai_fib_route_walk_filter_match (sai_fib_route_t *p_route,
+                                      const sai_fib_route_walk_filter_t *p_filter);
+
+/**
+ * @brief Walk the routes of a VRF.
+ *
+ * @warning Caller must hold the FIB lock or the FIB read lock.
+ *
+ * @param[in] vrf_id VRF Id
+ * @param[in] p_filter Route walk filter, NULL for all the routes
+ * @param[in] walk_fn Callback called for each route matching the filter
+ * @param[in] p_cookie Cookie passed to the callback
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_route_walk (sai_object_id_t vrf_id,
+                                 const sai_fib_route_walk_filter_t *p_filter,
+                                 sai_fib_route_walk_fn walk_fn, void *p_cookie);
+
+/**
+ * @brief Get the ranges of the route key space of a VRF. Each address
+ * family is split in 2^split_bits ranges.
+ *
+ * @param[in] vrf_id VRF Id
+ * @param[in] split_bits Number of leading prefix address bits to split on,
+ *  at most SAI_FIB_ROUTE_WALK_MAX_SPLIT_BITS
+ * @param[out] p_range_list Array of ranges, NULL to get the count only
+ * @param[inout] p_count Size of the array in, number of ranges out
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned. SAI_STATUS_BUFFER_OVERFLOW is returned if the
+ *  array is too small.
+ */
+sai_status_t sai_fib_route_walk_ranges_get (sai_object_id_t vrf_id,
+                                            uint_t split_bits,
+                                            sai_fib_route_walk_range_t *p_range_list,
+                                            uint_t *p_count);
+
+/**
+ * @brief Walk the routes of a range of the route key space of a VRF.
+ *
+ * @warning Caller must hold the FIB lock or the FIB read lock.
+ *
+ * @param[in] p_range Range to walk
+ * @param[in] p_filter Route walk filter, NULL for all the routes
+ * @param[in] walk_fn Callback called for each route matching the filter
+ * @param[in] p_cookie Cookie passed to the callback
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_route_walk_range (const sai_fib_route_walk_range_t *p_range,
+                                       const sai_fib_route_walk_filter_t *p_filter,
+                                       sai_fib_route_walk_fn walk_fn,
+                                       void *p_cookie);
+
+/**
+ * @brief Walk the routes of a set of VRFs in parallel. Each worker takes
+ * the FIB read lock for a chunk of SAI_FIB_ROUTE_WALK_CHUNK_SIZE routes and
+ * resumes from the key of the last visited route. A successful walk has
+ * visited every route of a single FIB view: if the FIB lock is taken for
+ * writing during the walk, the walk is stopped and SAI_STATUS_OBJECT_IN_USE
+ * is returned, and the caller discards the results and walks again. The
+ * callback is called concurrently from the worker threads with the FIB read
+ * lock held, it must not take the FIB lock, modify the FIB or keep the
+ * route pointer.
+ *
+ * @warning Caller must not hold the FIB lock or the FIB read lock.
+ *
+ * @param[in] p_vrf_list Array of VRF Ids, NULL for all the VRFs
+ * @param[in] vrf_count Number of VRF Ids in the array
+ * @param[in] split_bits Number of leading prefix address bits to split each
+ *  VRF on
+ * @param[in] num_threads Number of worker threads, at most
+ *  SAI_FIB_ROUTE_WALK_MAX_THREADS. The walk is done in the calling thread
+ *  if 0 or 1.
+ * @param[in] p_filter Route walk filter, NULL for all the routes
+ * @param[in] walk_fn Callback called for each route matching the filter
+ * @param[in] p_cookie Cookie passed to the callback
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned. On a callback error the walk is stopped and the
+ *  first error is returned. SAI_STATUS_OBJECT_IN_USE is returned if the FIB
+ *  changed during the walk.
+ */
+sai_status_t sai_fib_route_walk_parallel (const sai_object_id_t *p_vrf_list,
+                                          uint_t vrf_count, uint_t split_bits,
+                                          uint_t num_threads,
+                                          const sai_fib_route_walk_filter_t *p_filter,
+                                          sai_fib_route_walk_fn walk_fn,
+                                          void *p_cookie);
+
+/**
+ * \}
+ */
+
+#endif /* __SAI_L3_ROUTE_WALK_H__ */
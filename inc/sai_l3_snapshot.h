@@ -0,0 +1,271 @@
+/************************************************************************
+* LEGALESE:   "Copyright (c) 2015, Dell Inc. All rights reserved."
+*
+* This source code is confidential, proprietary, and contains trade
+* secrets that are the sole property of Dell Inc.
+* Copy and/or distribution of this source code or disassembly or reverse
+* engineering of the resultant object code are strictly forbidden without
+* the written consent of Dell Inc.
+*
+************************************************************************/
+/**
+* @file sai_l3_snapshot.h
+*
+* @brief This file contains the binary snapshot format and the save and
+*        load functions of the SAI L3 FIB, used for warm boot.
+*
+*************************************************************************/
+#ifndef __SAI_L3_SNAPSHOT_H__
+#define __SAI_L3_SNAPSHOT_H__
+
+#include "std_type_defs.h"
+#include "saitypes.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/** \defgroup SAIL3SNAPSHOT SAI - L3 FIB snapshot functions
+ *  Binary snapshot of the VRF, RIF, Next Hop, Next Hop Group and Route
+ *  nodes of the SAI L3 component.
+ *
+ *  The snapshot is a header followed by one section per object type. Each
+ *  section is an array of fixed size records at an 8 byte aligned offset,
+ *  so that a snapshot file can be mapped and read in place. Next hop and
+ *  next hop group references are stored as indexes in their section.
+ *
+ *  The snapshot is loaded in the software FIB only. NPU-specific data of
+ *  the nodes (hw_info) is not saved and is restored by the NPU layer.
+ *
+ *  \{
+ */
+
+/** Snapshot magic, "SFIB" */
+#define SAI_FIB_SNAPSHOT_MAGIC           (0x53464942)
+
+/** Snapshot format version */
+#define SAI_FIB_SNAPSHOT_VERSION         (2)
+
+/** Index value for a reference to no object */
+#define SAI_FIB_SNAPSHOT_INVALID_INDEX   (0xffffffff)
+
+/** Alignment of the sections in the snapshot */
+#define SAI_FIB_SNAPSHOT_ALIGN           (8)
+
+/**
+ * @brief Sections of the snapshot.
+ */
+typedef enum _sai_fib_snapshot_section_t {
+
+    SAI_FIB_SNAPSHOT_SECTION_VRF,
+    SAI_FIB_SNAPSHOT_SECTION_RIF,
+    SAI_FIB_SNAPSHOT_SECTION_NH,
+    SAI_FIB_SNAPSHOT_SECTION_NH_GROUP,
+    SAI_FIB_SNAPSHOT_SECTION_NH_GROUP_MEMBER,
+    SAI_FIB_SNAPSHOT_SECTION_NH_GROUP_BUCKET,
+    SAI_FIB_SNAPSHOT_SECTION_ROUTE,
+    SAI_FIB_SNAPSHOT_SECTION_MAX,
+
+} sai_fib_snapshot_section_t;
+
+/**
+ * @brief Section descriptor in the snapshot header.
+ */
+typedef struct _sai_fib_snapshot_section_hdr_t {
+
+    /** Offset of the section from the start of the snapshot */
+    uint64_t  offset;
+
+    /** Number of records in the section */
+    uint32_t  count;
+
+    /** Size of a record in the section */
+    uint32_t  record_size;
+} sai_fib_snapshot_section_hdr_t;
+
+/**
+ * @brief Snapshot header.
+ */
+typedef struct _sai_fib_snapshot_hdr_t {
+    uint32_t  magic;
+    uint32_t  version;
+
+    /** Length of the snapshot including the header */
+    uint64_t  total_len;
+
+    uint32_t  hdr_size;
+    uint32_t  num_sections;
+
+    sai_fib_snapshot_section_hdr_t section [SAI_FIB_SNAPSHOT_SECTION_MAX];
+} sai_fib_snapshot_hdr_t;
+
+/**
+ * @brief VRF record.
+ */
+typedef struct _sai_fib_snapshot_vrf_t {
+    uint64_t  vrf_id;
+    int32_t   ttl0_1_pkt_action;
+    int32_t   ip_options_pkt_action;
+    uint8_t   src_mac [6];
+    uint8_t   v4_admin_state;
+    uint8_t   v6_admin_state;
+} sai_fib_snapshot_vrf_t;
+
+/**
+ * @brief Router interface record.
+ */
+typedef struct _sai_fib_snapshot_rif_t {
+    uint64_t  rif_id;
+    uint64_t  vrf_id;
+
+    /** Port Id, or VLAN Id for VLAN router interfaces */
+    uint64_t  attachment;
+    uint32_t  type;
+    uint32_t  mtu;
+    int32_t   ip_options_pkt_action;
+    uint32_t  ref_count;
+    uint8_t   src_mac [6];
+    uint8_t   v4_admin_state;
+    uint8_t   v6_admin_state;
+} sai_fib_snapshot_rif_t;
+
+/**
+ * @brief Next hop record. Includes the neighbor only next hop nodes.
+ */
+typedef struct _sai_fib_snapshot_nh_t {
+    uint64_t  next_hop_id;
+    uint64_t  rif_id;
+    uint64_t  vrf_id;
+    uint64_t  port_id;
+    uint32_t  nh_type;
+    uint32_t  addr_family;
+    uint8_t   addr [16];
+    uint32_t  owner_flag;
+    int32_t   packet_action;
+    uint32_t  ref_count;
+    uint32_t  meta_data;
+    uint8_t   mac_addr [6];
+    uint8_t   no_host_route;
+    uint8_t   reserved;
+} sai_fib_snapshot_nh_t;
+
+/**
+ * @brief Next hop group record. Members are the member_count records
+ * starting at member_start in the member section, and buckets the
+ * num_buckets records starting at bucket_start in the bucket section.
+ */
+typedef struct _sai_fib_snapshot_nh_group_t {
+    uint64_t  group_id;
+    uint32_t  type;
+    uint32_t  nh_count;
+    uint32_t  ref_count;
+    uint32_t  member_start;
+    uint32_t  member_count;
+
+    /** Number of resilient hashing buckets, 0 if no bucket table */
+    uint32_t  num_buckets;
+    uint32_t  bucket_start;
+    uint32_t  reserved;
+} sai_fib_snapshot_nh_group_t;
+
+/**
+ * @brief Next hop group member record.
+ */
+typedef struct _sai_fib_snapshot_nh_group_member_t {
+
+    /** Index of the next hop in the next hop section */
+    uint32_t  nh_index;
+    uint32_t  weight;
+} sai_fib_snapshot_nh_group_member_t;
+
+/**
+ * @brief Next hop group bucket record.
+ */
+typedef struct _sai_fib_snapshot_nh_group_bucket_t {
+
+    /** Index of the next hop in the next hop section, invalid index for an
+     * empty bucket */
+    uint32_t  nh_index;
+    uint32_t  reserved;
+} sai_fib_snapshot_nh_group_bucket_t;
+
+/**
+ * @brief Route record.
+ */
+typedef struct _sai_fib_snapshot_route_t {
+    uint64_t  vrf_id;
+    uint32_t  addr_family;
+    uint8_t   addr [16];
+    uint32_t  prefix_len;
+    uint32_t  nh_type;
+
+    /** Index in the next hop or next hop group section based on nh_type */
+    uint32_t  nh_index;
+    int32_t   packet_action;
+    uint32_t  trap_priority;
+    uint32_t  meta_data;
+    uint32_t  reserved;
+} sai_fib_snapshot_route_t;
+
+/**
+ * @brief Get the length of the snapshot of the current FIB.
+ *
+ * @warning Caller must hold the FIB lock or the FIB read lock, and keep it
+ * until the snapshot is serialized.
+ *
+ * @param[out] p_len  Length of the snapshot in bytes
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_snapshot_len_get (size_t *p_len);
+
+/**
+ * @brief Serialize the current FIB in a buffer.
+ *
+ * @warning Caller must hold the FIB lock or the FIB read lock.
+ *
+ * @param[out] p_buf  Buffer for the snapshot, 8 byte aligned
+ * @param[in] buf_len  Length of the buffer
+ * @param[out] p_len  Length of the snapshot written in the buffer
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_snapshot_serialize (uint8_t *p_buf, size_t buf_len,
+                                         size_t *p_len);
+
+/**
+ * @brief Rebuild the FIB from a snapshot. The FIB must be initialized and
+ * empty. Nodes are added to the FIB trees and lists without NPU calls. If
+ * the snapshot is invalid, the FIB is left empty.
+ *
+ * @warning Caller must hold the FIB lock.
+ *
+ * @param[in] p_buf  Snapshot, 8 byte aligned
+ * @param[in] len  Length of the snapshot buffer
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_snapshot_deserialize (const uint8_t *p_buf, size_t len);
+
+/**
+ * @brief Save a snapshot of the FIB in a file. FIB lock is taken.
+ *
+ * @param[in] p_file_name  Snapshot file name
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_snapshot_save (const char *p_file_name);
+
+/**
+ * @brief Rebuild the FIB from a snapshot file. The file is mapped and read
+ * in place. FIB lock is taken.
+ *
+ * @param[in] p_file_name  Snapshot file name
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_snapshot_load (const char *p_file_name);
+
+/**
+ * \}
+ */
+
+#endif /* __SAI_L3_SNAPSHOT_H__ */
@@ -22,6 +22,7 @@
 #include "std_struct_utils.h"
 #include "std_bit_masks.h"
 #include "sai_l3_common.h"
+#include "sai_l3_api.h"
 #include "sai_event_log.h"
 #include "sai_oid_utils.h"
 #include "saitypes.h"
@@ -53,6 +54,10 @@
 #define SAI_FIB_NH_IP_ADDR_TREE_KEY_LEN  \
          (sizeof (sai_fib_nh_key_t) * BITS_PER_BYTE)
 
+/** Key length for Route radix tree */
+#define SAI_FIB_ROUTE_TREE_KEY_LEN  \
+         (sizeof (sai_fib_route_key_t) * BITS_PER_BYTE)
+
 /** Key length for Neighbor MAC entry radix tree */
 #define SAI_FIB_NEIGHBOR_MAC_ENTRY_TREE_KEY_LEN  \
          (sizeof (sai_fib_neighbor_mac_entry_key_t) * BITS_PER_BYTE)
@@ -364,7 +369,8 @@ sai_fib_router_interface_t *sai_fib_router_interface_node_get (
                                  sai_object_id_t rif_id);
 
 /**
- * @brief Get SAI FIB Next Hop node using next_hop_id.
+ * @brief Get SAI FIB Next Hop node using next_hop_id. Caller must hold the
+ * FIB lock or the FIB read lock.
  *
  * @param[in] nh_id    Next Hop id
  * @return Pointer to the next hop node if next hop id is found
@@ -381,6 +387,28 @@ sai_fib_nh_t *sai_fib_next_hop_node_get_from_id (sai_object_id_t nh_id);
  */
 sai_fib_nh_group_t *sai_fib_next_hop_group_get (sai_object_id_t id);
 
+/**
+ * @brief Allocate a SAI FIB Next Hop Group node. The node must be released
+ * with sai_fib_nh_group_node_free().
+ *
+ * @param[in] group_id  Next Hop Group id
+ * @param[in] type  Next Hop Group type
+ * @param[in] num_buckets  Number of resilient hashing buckets, 0 for a group
+ * without bucket table
+ * @return Pointer to the next hop group node, NULL on failure
+ */
+sai_fib_nh_group_t *sai_fib_nh_group_node_alloc (sai_object_id_t group_id,
+                                                 sai_next_hop_group_type_t type,
+                                                 uint_t num_buckets);
+
+/**
+ * @brief Free a SAI FIB Next Hop Group node and its bucket table. Node must
+ * be removed from the NH Group tree and have no member.
+ *
+ * @param[in] p_group  Pointer to the next hop group node
+ */
+void sai_fib_nh_group_node_free (sai_fib_nh_group_t *p_group);
+
 /**
  * @brief Get SAI FIB VRF node for the RIF Id.
  *
@@ -390,7 +418,9 @@ sai_fib_nh_group_t *sai_fib_next_hop_group_get (sai_object_id_t id);
 sai_fib_vrf_t* sai_fib_get_vrf_node_for_rif (sai_object_id_t rif_id);
 
 /**
- * @brief Get SAI FIB IP next hop node for the Next hop IP address.
+ * @brief Get SAI FIB IP next hop node for the Next hop IP address. Resolved
+ * with the (RIF, IP) hash index when it is initialized, else with the VRF
+ * Next Hop tree.
  *
  * @param[in] vrf_id    Virtual router id
  * @param[in] p_ip_addr   Pointer to the Next Hop IP address
@@ -399,6 +429,36 @@ sai_fib_vrf_t* sai_fib_get_vrf_node_for_rif (sai_object_id_t rif_id);
 sai_fib_nh_t* sai_fib_ip_next_hop_node_get (sai_object_id_t vrf_id,
                                             sai_ip_address_t *p_ip_addr);
 
+/**
+ * @brief Add a Next Hop node to the VRF Next Hop tree and to the (RIF, IP)
+ * hash index. The radix key address of the node is set.
+ *
+ * @param[in] p_vrf_node   Pointer to the VRF node
+ * @param[in] p_next_hop   Pointer to the Next Hop node
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_nh_tree_insert (sai_fib_vrf_t *p_vrf_node,
+                                     sai_fib_nh_t *p_next_hop);
+
+/**
+ * @brief Remove a Next Hop node from the VRF Next Hop tree and from the
+ * (RIF, IP) hash index.
+ *
+ * @param[in] p_vrf_node   Pointer to the VRF node
+ * @param[in] p_next_hop   Pointer to the Next Hop node
+ */
+void sai_fib_nh_tree_remove (sai_fib_vrf_t *p_vrf_node,
+                             sai_fib_nh_t *p_next_hop);
+
+/**
+ * @brief Update the RIF next hop and neighbor counts of a Next Hop node
+ * that stays in the VRF Next Hop tree after its owner flag changed.
+ *
+ * @param[in] p_next_hop   Pointer to the Next Hop node
+ */
+void sai_fib_nh_mem_stats_owner_sync (sai_fib_nh_t *p_next_hop);
+
 /**
  * @brief Find if the next hop group node is present in next hop's group list.
  *
@@ -596,15 +656,162 @@ sai_fib_nh_t* sai_fib_get_next_neighbor_from_mac_entry (
                                 sai_fib_nh_t *p_neighbor);
 
 /**
- * @brief Utility to take simple mutex lock for FIB resources access.
+ * @brief Update the egress port of the neighbors bound to a (VLAN, MAC).
+ * Only the neighbors whose port differs are updated. NPU is notified once
+ * for the MAC entry if the NPU supports it, otherwise once per neighbor.
+ *
+ * @warning Caller must hold the FIB lock.
+ *
+ * @param[in] p_neighbor_api  NPU Neighbor API table
+ * @param[in] p_key  Key of the neighbor MAC entry
+ * @param[in] port_id  New egress port Id, SAI_NULL_OBJECT_ID if MAC is flushed
+ * @param[out] p_count  Number of neighbors updated. Can be NULL.
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_neighbor_mac_entry_port_update (
+                                const sai_npu_neighbor_api_t *p_neighbor_api,
+                                const sai_fib_neighbor_mac_entry_key_t *p_key,
+                                sai_object_id_t port_id, uint_t *p_count);
+
+/**
+ * @brief Bind the Neighbor MAC entries to the FDB. FDB entry learn, move and
+ * flush events then update the egress port of the neighbors bound to the
+ * same (VLAN, MAC).
+ *
+ * FDB events are queued with the FDB lock held and applied by
+ * sai_fdb_send_entry_change_notifications() after the FDB lock is released,
+ * taking the FIB lock once per batch of events. If FDB could not queue an
+ * event, the port of every neighbor MAC entry is re-read from the FDB cache,
+ * taking the FDB lock with the FIB lock held.
+ *
+ * @param[in] p_neighbor_api  NPU Neighbor API table, NULL to unbind
+ */
+void sai_fib_neighbor_fdb_binding_set (
+                                const sai_npu_neighbor_api_t *p_neighbor_api);
+
+/**
+ * @brief Update the VRF route statistics for a route added to or removed
+ * from the VRF route tree. On a route attribute change, the route must be
+ * accounted as removed with the old attributes and added with the new ones.
+ *
+ * @param[in] p_vrf_node Pointer to the VRF node.
+ * @param[in] p_route Pointer to the route node.
+ * @param[in] is_add true if route is added to the route tree, false if removed.
+ */
+void sai_fib_vrf_route_stats_update (sai_fib_vrf_t *p_vrf_node,
+                                     const sai_fib_route_t *p_route,
+                                     bool is_add);
+
+/**
+ * @brief Get the route statistics of a VRF.
+ *
+ * @param[in] vrf_id VRF Id.
+ * @param[out] p_stats Route statistics of the VRF.
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_vrf_route_stats_get (sai_object_id_t vrf_id,
+                                          sai_fib_vrf_route_stats_t *p_stats);
+
+/**
+ * @brief Update the VRF memory accounting for a Neighbor MAC entry added to
+ * or removed from the Neighbor MAC entry tree. The entry is charged to the
+ * VRF in its vrf_id field.
+ *
+ * @param[in] p_mac_entry Pointer to the Neighbor MAC entry node.
+ * @param[in] is_add true if entry is added to the tree, false if removed.
+ */
+void sai_fib_neighbor_mac_entry_mem_stats_update (
+                                    sai_fib_neighbor_mac_entry_t *p_mac_entry,
+                                    bool is_add);
+
+/**
+ * @brief Get the memory accounting of a VRF. Route, Next Hop and Neighbor
+ * MAC entry memory is updated on insert and remove of the nodes.
+ *
+ * @param[in] vrf_id VRF Id.
+ * @param[out] p_stats Memory accounting of the VRF.
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_vrf_mem_stats_get (sai_object_id_t vrf_id,
+                                        sai_fib_vrf_mem_stats_t *p_stats);
+
+/**
+ * @brief Get the total bytes of a VRF memory accounting.
+ *
+ * @param[in] p_stats Memory accounting of the VRF.
+ * @return Sum of the node and radix bytes.
+ */
+uint64_t sai_fib_vrf_mem_stats_total_bytes_get (
+                                       const sai_fib_vrf_mem_stats_t *p_stats);
+
+/**
+ * @brief Get the memory accounting of the Next Hop and Neighbor nodes on a
+ * router interface.
+ *
+ * @param[in] rif_id Router interface Id.
+ * @param[out] p_stats Memory accounting of the RIF.
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_fib_rif_mem_stats_get (sai_object_id_t rif_id,
+                                        sai_fib_rif_mem_stats_t *p_stats);
+
+/**
+ * @brief Get the first route node in the VRF route tree.
+ *
+ * @param[in] p_vrf_node Pointer to the VRF node.
+ * @return Pointer to the first route node, NULL if the tree is empty.
+ */
+sai_fib_route_t *sai_fib_route_get_first (sai_fib_vrf_t *p_vrf_node);
+
+/**
+ * @brief Get the next route node in the VRF route tree.
+ *
+ * @param[in] p_vrf_node Pointer to the VRF node.
+ * @param[in] p_route Pointer to the current route node in the tree.
+ * @return Pointer to the next route node, NULL if there is none.
+ */
+sai_fib_route_t *sai_fib_route_get_next (sai_fib_vrf_t *p_vrf_node,
+                                         sai_fib_route_t *p_route);
+
+/**
+ * @brief Utility to take the FIB lock for FIB resources modification.
+ * Exclusive of the other writers and readers.
  */
 void sai_fib_lock (void);
 
 /**
- * @brief Utility to release simple mutex lock for FIB resources access.
+ * @brief Utility to release the FIB lock taken with sai_fib_lock.
  */
 void sai_fib_unlock (void);
 
+/**
+ * @brief Utility to take the FIB lock for FIB resources lookup. Shared with
+ * the other readers, a waiting writer blocks the new readers. Must not be
+ * taken again by a thread that already holds it. Node pointers must not be
+ * used after the lock is released.
+ */
+void sai_fib_read_lock (void);
+
+/**
+ * @brief Utility to release the FIB lock taken with sai_fib_read_lock.
+ */
+void sai_fib_read_unlock (void);
+
+/**
+ * @brief Get the FIB write generation, incremented each time the FIB lock
+ * is taken with sai_fib_lock. Readers compare it across read lock holds to
+ * check that the FIB did not change in between.
+ *
+ * @warning Caller must hold the FIB read lock.
+ *
+ * @return FIB write generation.
+ */
+uint64_t sai_fib_write_gen_get (void);
+
 /**
  * @brief Utility to check is_init_complete flag for SAI L3 component.
  *
@@ -942,6 +1149,18 @@ static inline bool sai_fib_is_ipv6_full_length_route (sai_fib_route_t *p_route)
             (SAI_IPV6_ADDR_PREFIX_LEN == p_route->prefix_len));
 }
 
+/**
+ * @brief Utility to get the route tree key length in bits for a prefix length.
+ *
+ * @param[in] prefix_len Prefix length of the route.
+ * @return Key length of the route in the VRF route tree.
+ */
+static inline uint_t sai_fib_route_key_len_get (uint_t prefix_len)
+{
+    return ((STD_STR_SIZE_OF (sai_ip_address_t, addr_family) * BITS_PER_BYTE) +
+            prefix_len);
+}
+
 /**
  * \}
  */
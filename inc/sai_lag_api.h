@@ -141,7 +141,8 @@ void sai_lag_lock(void);
 */
 std_dll_head* sai_lag_list_get(void);
 
-/** SAI LAG API - Get the Lag node to dump
+/** SAI LAG API - Get the Lag node to dump. The node is found in the LAG id
+    hash, the sorted LAG list is only used for ordered walks.
     \param[in] lag_id LAG Identifier
     \return Success: A valid pointer to lag node in cache
             Failure: NULL
@@ -225,7 +226,7 @@ sai_status_t sai_lag_member_get_disable_status (sai_object_id_t  lag_id,
       \param[in] is_ingress Direction - true if ingress, else false
       \param[in] status [ing/egr] disable status of the given Lag member
       \return Success: SAI_STATUS_SUCCESS
-              Failure: SAI_STATUS_INVALID_PARAMETER
+              Failure: SAI_STATUS_INVALID_PARAMETER, SAI_STATUS_NO_MEMORY
 */
 sai_status_t sai_lag_member_set_disable_status (sai_object_id_t lag_id,
                                                 sai_object_id_t port_id,
@@ -254,5 +255,20 @@ sai_status_t sai_lag_member_set_member_id (sai_object_id_t lag_id,
                                            sai_object_id_t port_id,
                                            sai_object_id_t member_id);
 
+/** SAI LAG API - Get the ports of the LAG that are not egress disabled
+      \param[in] lag_id LAG Identifier
+      \param[out] port_list Contiguous array of the ports, sorted on port id.
+                  Owned by the LAG cache and valid until the next LAG update.
+      \param[out] port_count Number of ports in port_list
+      \param[out] epoch Epoch of the array, changes whenever it is updated
+      \return Success: SAI_STATUS_SUCCESS
+              Failure: SAI_STATUS_ITEM_NOT_FOUND
+      \warning Caller must hold the LAG lock
+*/
+sai_status_t sai_lag_active_port_list_get (sai_object_id_t         lag_id,
+                                           const sai_object_id_t **port_list,
+                                           unsigned int           *port_count,
+                                           uint64_t               *epoch);
+
 
 #endif
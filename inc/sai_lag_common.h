@@ -44,6 +44,10 @@ typedef struct _sai_lag_port_node_t {
     bool            ing_disable;
     /* Disable traffic distribution on port */
     bool            egr_disable;
+    /* Next LAG port node in the same member id hash bucket */
+    struct _sai_lag_port_node_t *member_hash_next;
+    /* Next LAG port node in the same port id hash bucket */
+    struct _sai_lag_port_node_t *port_hash_next;
 }sai_lag_port_node_t;
 
 /*LAg node: A linked list node in LAG list*/
@@ -58,8 +62,30 @@ typedef struct _sai_lag_node_t {
     unsigned int port_count;
     /*rif_id Router interface Identifier*/
     sai_object_id_t rif_id;
+    /*hash_next: Next LAG node in the same LAG id hash bucket*/
+    struct _sai_lag_node_t *hash_next;
+    /*active_port_list: Ports not egress disabled, sorted on port id*/
+    sai_object_id_t *active_port_list;
+    /*active_port_count: Number of ports in active_port_list*/
+    unsigned int active_port_count;
+    /*active_port_max: Number of ports active_port_list can hold*/
+    unsigned int active_port_max;
+    /*active_epoch: Incremented on every change of active_port_list*/
+    uint64_t active_epoch;
 }sai_lag_node_t;
 
+/*Number of buckets in the LAG id hash, a power of 2*/
+#define SAI_LAG_ID_HASH_NUM_BUCKETS (256)
+
+/*Number of buckets in the LAG member id and port id hashes, a power of 2*/
+#define SAI_LAG_MEMBER_HASH_NUM_BUCKETS (1024)
+
+/*Alignment in bytes of the LAG active port list, a cache line*/
+#define SAI_LAG_ACTIVE_PORT_LIST_ALIGN (64)
+
+/*Initial number of ports of the LAG active port list*/
+#define SAI_LAG_ACTIVE_PORT_LIST_DFLT_SIZE (8)
+
 #define SAI_LAG_ID_OFFSET STD_STR_OFFSET_OF(sai_lag_node_t,sai_lag_id)
 #define SAI_LAG_ID_SIZE STD_STR_SIZE_OF(sai_lag_node_t,sai_lag_id)
 #define SAI_LAG_PORT_ID_OFFSET STD_STR_OFFSET_OF(sai_lag_port_node_t, port_id)
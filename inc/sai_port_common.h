@@ -47,6 +47,12 @@ typedef uint32_t sai_npu_port_id_t;
  */
 typedef rbtree_handle sai_port_info_table_t;
 
+/**
+ * @brief Maximum number of entries of the port info index, indexed on the
+ * port number of the port UOID. Ports beyond are looked up in the table.
+ */
+#define SAI_PORT_INFO_INDEX_MAX_SIZE (4096)
+
 /**
  * @brief Multiplier to Convert SAI port speed value from Gbps to Mbps
  */
@@ -218,6 +224,31 @@ typedef struct _sai_port_attr_info_t
 
 } sai_port_attr_info_t;
 
+/**
+ * @brief Ports, attributes and result buffers of a bulk get of the cached
+ * port attributes
+ */
+typedef struct _sai_port_attr_bulk_info_t
+{
+    /** Ports to read, or filled with all the valid logical ports. Count is
+     * the number of ports, or the size of the list when it is filled */
+    sai_object_list_t       port_list;
+
+    /** Number of attributes to read */
+    uint32_t                attr_count;
+
+    /** Attribute ids to read */
+    const sai_attr_id_t    *attr_id_list;
+
+    /** attr_count arrays of port_list.count values. The value of attribute
+     * attr_idx for port port_idx is at (attr_idx * port_list.count) +
+     * port_idx */
+    sai_attribute_value_t  *value_list;
+
+    /** Status of each port, values are not filled for a failed port */
+    sai_status_t           *port_status_list;
+} sai_port_attr_bulk_info_t;
+
 /**
  * @brief SAI port level capabilities and information.
  */
@@ -81,6 +81,28 @@
  */
 sai_status_t sai_port_info_init(void);
 
+/**
+ * @brief Build the port info indexes on the port UOID and on the NPU local
+ *  port from the port info table. Lookups of ports missing from the indexes
+ *  fall back to the table and fill the indexes.
+ *
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_port_info_index_build(void);
+
+/**
+ * @brief Remove a port info node from the port info table and from the port
+ *  info indexes. The NPU must remove port info nodes with this function
+ *  before freeing them, a node removed from the table directly stays in the
+ *  indexes.
+ *
+ * @param[in] port_info Port info node, freed by the caller
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_port_info_remove(sai_port_info_t *port_info);
+
 /**
  * @brief Initialize the port attributes to its default value
  */
@@ -163,6 +185,22 @@ sai_status_t sai_port_attr_info_cache_set(sai_object_id_t port_id,
 sai_status_t sai_port_attr_info_cache_get(sai_object_id_t port_id,
                                           sai_attribute_t *attr);
 
+/**
+ * @brief Get cached port attributes for a list of ports or for all the
+ *  valid logical ports in one call. Attributes are validated once, and
+ *  the values are filled in one pass over the ports.
+ *
+ * @param[in] all_ports  true to read all the valid logical ports and fill
+ *  bulk_info->port_list, false to read the ports in bulk_info->port_list
+ * @param[inout] bulk_info  ports, attributes and result buffers
+ * @return SAI_STATUS_SUCCESS if operation is successful,
+ *  SAI_STATUS_BUFFER_OVERFLOW with the number of valid ports in
+ *  port_list.count if the port list is too small, otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_port_attr_info_cache_bulk_get(bool all_ports,
+                                               sai_port_attr_bulk_info_t *bulk_info);
+
 /**
  * @brief Get the phy device type of a given switch port
  *
@@ -220,6 +258,18 @@ sai_status_t sai_port_to_npu_local_port(sai_object_id_t port,
  */
 sai_status_t sai_npu_local_port_to_sai_port(sai_npu_port_id_t local_port_id,
                                             sai_object_id_t *port);
+
+/**
+ * @brief Get the physical port number for the given local/logical port
+ *
+ * @param[in] local_port_id  local port id of a sai switch port
+ * @param[out] phy_port_id  physical port number for the given local port
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_npu_local_port_to_physical_port(sai_npu_port_id_t local_port_id,
+                                                 sai_npu_port_id_t *phy_port_id);
+
 /**
  * @brief Get the physical port number for the given switch port
  *
@@ -20,9 +20,11 @@
 #include "saitypes.h"
 #include "saistatus.h"
 #include "sai_vlan_common.h"
-/** SAI VLAN API - Init VLAN Module data structures
+/** SAI VLAN API - Init VLAN Module data structures. VLAN port bitmaps are
+    sized from the maximum logical port count, so the switch info must be
+    initialized before.
     \return Success: SAI_STATUS_SUCCESS
-            Failure: SAI_STATUS_UNINITIALIZED
+            Failure: SAI_STATUS_UNINITIALIZED, SAI_STATUS_NO_MEMORY
 */
 sai_status_t sai_vlan_cache_init(void);
 
@@ -106,11 +108,97 @@ bool sai_is_port_in_different_tagging_mode (sai_vlan_id_t vlan_id,
 sai_status_t sai_remove_vlan_port_node (sai_vlan_id_t vlan_id,
                                         const sai_vlan_port_t *vlan_port);
 
+/** SAI VLAN API - Add a port to a list of VLANs. The caller holds
+    sai_vlan_lock() once for the whole list. Forwarding mode of the port is
+    updated once.
+      \param[in] vlan_port Port id along with tagging mode
+      \param[in] vlan_count Number of VLANs in the list
+      \param[in] vlan_list List of VLAN Identifiers
+      \param[out] status_list Status of each VLAN in the list
+      \return Success: SAI_STATUS_SUCCESS if the port is added to all VLANs
+              Failure: Status of the first VLAN that failed
+*/
+sai_status_t sai_add_port_to_vlan_list(const sai_vlan_port_t *vlan_port,
+                                       unsigned int vlan_count,
+                                       const sai_vlan_id_t *vlan_list,
+                                       sai_status_t *status_list);
+
+/** SAI VLAN API - Add a list of ports to a VLAN. The caller holds
+    sai_vlan_lock() once for the whole list.
+      \param[in] vlan_id VLAN Identifier
+      \param[in] port_count Number of ports in the list
+      \param[in] vlan_port_list List of port ids along with tagging mode
+      \param[out] status_list Status of each port in the list
+      \return Success: SAI_STATUS_SUCCESS if all ports are added
+              Failure: Status of the first port that failed
+*/
+sai_status_t sai_add_vlan_port_list(sai_vlan_id_t vlan_id,
+                                    unsigned int port_count,
+                                    const sai_vlan_port_t *vlan_port_list,
+                                    sai_status_t *status_list);
+
+/** SAI VLAN API - Remove a port from a list of VLANs. The caller holds
+    sai_vlan_lock() once for the whole list. Forwarding mode of the port is
+    updated once.
+      \param[in] vlan_port Port id along with tagging mode
+      \param[in] vlan_count Number of VLANs in the list
+      \param[in] vlan_list List of VLAN Identifiers
+      \param[out] status_list Status of each VLAN in the list
+      \return Success: SAI_STATUS_SUCCESS if the port is removed from all VLANs
+              Failure: Status of the first VLAN that failed
+*/
+sai_status_t sai_remove_port_from_vlan_list(const sai_vlan_port_t *vlan_port,
+                                            unsigned int vlan_count,
+                                            const sai_vlan_id_t *vlan_list,
+                                            sai_status_t *status_list);
+
+/** SAI VLAN API - Remove a list of ports from a VLAN. The caller holds
+    sai_vlan_lock() once for the whole list.
+      \param[in] vlan_id VLAN Identifier
+      \param[in] port_count Number of ports in the list
+      \param[in] vlan_port_list List of port ids along with tagging mode
+      \param[out] status_list Status of each port in the list
+      \return Success: SAI_STATUS_SUCCESS if all ports are removed
+              Failure: Status of the first port that failed
+*/
+sai_status_t sai_remove_vlan_port_list(sai_vlan_id_t vlan_id,
+                                       unsigned int port_count,
+                                       const sai_vlan_port_t *vlan_port_list,
+                                       sai_status_t *status_list);
+
+/** SAI VLAN API - Get the VLANs a port is member of, from the port VLAN
+    bitmap kept with the VLAN membership
+      \param[in] port_id Port Identifier
+      \param[inout] vlan_count Size of the VLAN list, number of VLANs on return
+      \param[out] vlan_list VLAN Identifiers in ascending order
+      \return Success: SAI_STATUS_SUCCESS
+              Failure: SAI_STATUS_BUFFER_OVERFLOW with the required count
+*/
+sai_status_t sai_port_vlan_list_get(sai_object_id_t port_id,
+                                    unsigned int *vlan_count,
+                                    sai_vlan_id_t *vlan_list);
+
+/** SAI VLAN API - Remove a port from all its VLANs, in time proportional to
+    the number of VLANs of the port. Forwarding mode of the port is updated.
+      \param[in] port_id Port Identifier
+      \param[out] vlan_count Number of VLANs the port is removed from. Can be
+                  NULL.
+      \return Success: SAI_STATUS_SUCCESS
+*/
+sai_status_t sai_remove_port_from_all_vlans(sai_object_id_t port_id,
+                                            unsigned int *vlan_count);
+
 /** SAI VLAN API - Remove all VLAN Port nodes from VLAN Port list
       \param[in] vlan_id VLAN Identifier
 */
 void sai_remove_all_vlan_port_nodes (sai_vlan_id_t vlan_id);
 
+/** SAI VLAN API - Get the number of VLANs a port is member of
+      \param[in] port_id Port Identifier
+      \return Number of VLANs of the port
+*/
+unsigned int sai_port_vlan_count_get(sai_object_id_t port_id);
+
 /** SAI VLAN API - Initialize internal vlan ID
       \param[in] vlan_id VLAN Identifier
 */
@@ -134,13 +222,62 @@ bool sai_is_internal_vlan_id_initialized(void);
 */
 sai_vlan_id_t sai_internal_vlan_id_get(void);
 
-/** SAI VLAN API - Get Port list for a VLAN
+/** SAI VLAN API - Get Port list for a VLAN. Logical ports are listed in
+    NPU local port order, followed by the other ports such as LAGs.
       \param[in] vlan_id VLAN Identifier
       \param[out] vlan_port_list List of vlan ports and their count
       \return Success: SAI_STATUS_SUCCESS
               Failure: SAI_STATUS_NO_MEMORY
 */
 sai_status_t sai_vlan_port_list_get(sai_vlan_id_t vlan_id, sai_vlan_port_list_t *vlan_port_list);
+/** SAI VLAN API - Get the number of port members of a VLAN without copying
+    the port list
+      \param[in] vlan_id VLAN Identifier
+      \return Number of port members, 0 if the VLAN is not created
+*/
+unsigned int sai_vlan_port_count_get(sai_vlan_id_t vlan_id);
+
+/** SAI VLAN API - Get the first port member of a VLAN. The returned entry is
+    the cache entry and is valid while sai_vlan_lock() is held.
+      \param[in] vlan_id VLAN Identifier
+      \return Success: A valid pointer to the VLAN port
+              Failure: NULL if the VLAN has no port or is not created
+*/
+const sai_vlan_port_t* sai_vlan_port_get_first(sai_vlan_id_t vlan_id);
+
+/** SAI VLAN API - Get the next port member of a VLAN. The returned entry is
+    the cache entry and is valid while sai_vlan_lock() is held.
+      \param[in] vlan_id VLAN Identifier
+      \param[in] vlan_port VLAN port returned by the previous get
+      \return Success: A valid pointer to the VLAN port
+              Failure: NULL if there are no more ports
+*/
+const sai_vlan_port_t* sai_vlan_port_get_next(sai_vlan_id_t vlan_id,
+                                              const sai_vlan_port_t *vlan_port);
+
+/** SAI VLAN API - Callback for each port member of a VLAN walk
+      \param[in] vlan_id VLAN Identifier
+      \param[in] vlan_port Cache entry of the VLAN port. Must not be modified.
+      \param[in] p_cookie Cookie passed to the walk
+      \return SAI_STATUS_SUCCESS to continue the walk, any other value stops
+               the walk and is returned by the walk
+*/
+typedef sai_status_t (*sai_vlan_port_walk_fn)(sai_vlan_id_t vlan_id,
+                                              const sai_vlan_port_t *vlan_port,
+                                              void *p_cookie);
+
+/** SAI VLAN API - Walk the port members of a VLAN without copying them. The
+    caller holds sai_vlan_lock() and must not change the VLAN membership from
+    the callback.
+      \param[in] vlan_id VLAN Identifier
+      \param[in] walk_fn Callback for each port member
+      \param[in] p_cookie Cookie passed to the callback
+      \return Success: SAI_STATUS_SUCCESS
+              Failure: SAI_STATUS_INVALID_VLAN_ID or the callback status
+*/
+sai_status_t sai_vlan_port_walk(sai_vlan_id_t vlan_id,
+                                sai_vlan_port_walk_fn walk_fn, void *p_cookie);
+
 /** SAI VLAN API - Lock VLAN for access
 */
 void sai_vlan_lock(void);
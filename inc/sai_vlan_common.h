@@ -41,12 +41,32 @@ typedef struct _sai_vlan_port_node_t{
     std_dll node;
     /*vlan_port: Port and tagging mode*/
     sai_vlan_port_t vlan_port;
+    /*is_indexed: Port had a bitmap index when it was added*/
+    bool is_indexed;
+    /*bitmap_index: Port bitmap index resolved at add time, used on removal
+      so that bits are cleared even if the port is deleted first*/
+    unsigned int bitmap_index;
 }sai_vlan_port_node_t;
 
+/*VLAN port bitmaps: Member bitmap and one bitmap per tagging mode*/
+typedef enum _sai_vlan_port_bitmap_type_t{
+    SAI_VLAN_PORT_BITMAP_MEMBER,
+    SAI_VLAN_PORT_BITMAP_UNTAGGED,
+    SAI_VLAN_PORT_BITMAP_TAGGED,
+    SAI_VLAN_PORT_BITMAP_PRIORITY_TAGGED,
+    SAI_VLAN_PORT_BITMAP_MAX
+}sai_vlan_port_bitmap_type_t;
+
 /*VLAN Global cache node: List of ports in the vlan*/
 typedef struct _sai_vlan_global_cache_node_t{
     /*port_list: List of ports*/
     std_dll_head port_list;
+    /*port_bitmap: Port bitmaps indexed by the port bitmap index
+      [sai_vlan_port_bitmap_type_t]*/
+    uint8_t *port_bitmap[SAI_VLAN_PORT_BITMAP_MAX];
+    /*unindexed_port_count: Number of ports without a bitmap index
+      in the port list, such as LAGs*/
+    unsigned int unindexed_port_count;
     /*vlan_id: VLAN identifier*/
     sai_vlan_id_t vlan_id;
     /*port_cout: Number of ports in the VLAN*/
@@ -59,6 +79,9 @@ typedef struct _sai_vlan_global_cache_node_t{
     unsigned int meta_data;
 }sai_vlan_global_cache_node_t;
 
+/*Number of bytes in a bitmap of all VLAN identifiers*/
+#define SAI_VLAN_BITMAP_BYTES ((SAI_MAX_VLAN_TAG_ID + 1 + 7) / 8)
+
 /*Port VLAN Counter: A node in linked list*/
 typedef struct _sai_port_vlan_counter_t{
     /*node: Linked list node*/
@@ -67,6 +90,8 @@ typedef struct _sai_port_vlan_counter_t{
     sai_object_id_t port_id;
     /*vlan_count: Number of VLANS in port*/
     unsigned int vlan_count;
+    /*vlan_bitmap: VLANs of the port indexed by VLAN identifier*/
+    uint8_t vlan_bitmap[SAI_VLAN_BITMAP_BYTES];
 }sai_port_vlan_counter_t;
 
 #define SAI_PORTV_VLAN_COUNTER_OFFSET STD_STR_OFFSET_OF(sai_port_vlan_counter_t, port_id)
@@ -219,102 +219,201 @@ sai_status_t sai_port_attr_info_cache_set(sai_object_id_t port_id,
     return SAI_STATUS_SUCCESS;
 }
 
-sai_status_t sai_port_attr_info_cache_get(sai_object_id_t port_id,
-                                          sai_attribute_t *attr)
+/* Copy a cached attribute value of a port */
+static sai_status_t sai_port_attr_info_value_get(const sai_port_attr_info_t *port_attr_info,
+                                                 sai_attr_id_t attr_id,
+                                                 sai_attribute_value_t *value)
 {
-    STD_ASSERT(!(attr == NULL));
-
-    if(!sai_is_port_valid(port_id)) {
-        SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not valid port", port_id);
-        return SAI_STATUS_INVALID_OBJECT_ID;
-    }
-
-    sai_port_attr_info_t *port_attr_info = sai_port_attr_info_get(port_id);
-    STD_ASSERT(!(port_attr_info == NULL));
-
-    switch(attr->id) {
+    switch(attr_id) {
         case SAI_PORT_ATTR_OPER_STATUS:
-            attr->value.s32 = port_attr_info->oper_status;
+            value->s32 = port_attr_info->oper_status;
             break;
 
         case SAI_PORT_ATTR_SPEED:
-            attr->value.u32 = port_attr_info->speed;
+            value->u32 = port_attr_info->speed;
             break;
 
         case SAI_PORT_ATTR_FULL_DUPLEX_MODE:
-            attr->value.booldata = port_attr_info->duplex;
+            value->booldata = port_attr_info->duplex;
             break;
 
         case SAI_PORT_ATTR_AUTO_NEG_MODE:
-            attr->value.booldata = port_attr_info->autoneg;
+            value->booldata = port_attr_info->autoneg;
             break;
 
         case SAI_PORT_ATTR_ADMIN_STATE:
-            attr->value.booldata = port_attr_info->admin_state;
+            value->booldata = port_attr_info->admin_state;
             break;
 
         case SAI_PORT_ATTR_MEDIA_TYPE:
-            attr->value.s32 = port_attr_info->media_type;
+            value->s32 = port_attr_info->media_type;
             break;
 
         case SAI_PORT_ATTR_PORT_VLAN_ID:
-            attr->value.u16 = port_attr_info->default_vlan;
+            value->u16 = port_attr_info->default_vlan;
             break;
 
         case SAI_PORT_ATTR_DEFAULT_VLAN_PRIORITY:
-            attr->value.u8 = port_attr_info->default_vlan_priority;
+            value->u8 = port_attr_info->default_vlan_priority;
             break;
 
         case SAI_PORT_ATTR_INGRESS_FILTERING:
-            attr->value.booldata = port_attr_info->ingress_filtering;
+            value->booldata = port_attr_info->ingress_filtering;
             break;
 
         case SAI_PORT_ATTR_DROP_UNTAGGED:
-            attr->value.booldata = port_attr_info->drop_untagged;
+            value->booldata = port_attr_info->drop_untagged;
             break;
 
         case SAI_PORT_ATTR_DROP_TAGGED:
-            attr->value.booldata = port_attr_info->drop_tagged;
+            value->booldata = port_attr_info->drop_tagged;
             break;
 
         case SAI_PORT_ATTR_INTERNAL_LOOPBACK:
-            attr->value.s32 = port_attr_info->internal_loopback;
+            value->s32 = port_attr_info->internal_loopback;
             break;
 
         case SAI_PORT_ATTR_FDB_LEARNING:
-            attr->value.s32 = port_attr_info->fdb_learning;
+            value->s32 = port_attr_info->fdb_learning;
             break;
 
         case SAI_PORT_ATTR_UPDATE_DSCP:
-            attr->value.booldata = port_attr_info->update_dscp;
+            value->booldata = port_attr_info->update_dscp;
             break;
 
         case SAI_PORT_ATTR_MTU:
-            attr->value.u32 = port_attr_info->mtu;
+            value->u32 = port_attr_info->mtu;
             break;
 
         case SAI_PORT_ATTR_MAX_LEARNED_ADDRESSES:
-            attr->value.u32 = port_attr_info->max_learned_address;
+            value->u32 = port_attr_info->max_learned_address;
             break;
 
         case SAI_PORT_ATTR_FDB_LEARNING_LIMIT_VIOLATION:
-            attr->value.s32 = port_attr_info->fdb_learn_limit_violation;
+            value->s32 = port_attr_info->fdb_learn_limit_violation;
             break;
 
         case SAI_PORT_ATTR_GLOBAL_FLOW_CONTROL:
-            attr->value.s32 = port_attr_info->flow_control_mode;
+            value->s32 = port_attr_info->flow_control_mode;
             break;
 
         case SAI_PORT_ATTR_PRIORITY_FLOW_CONTROL:
-            attr->value.u8 = port_attr_info->pfc_enabled_bitmap;
+            value->u8 = port_attr_info->pfc_enabled_bitmap;
             break;
 
         default:
-            SAI_PORT_LOG_ERR("Attribute %d not in cache list for port 0x%"PRIx64"",
-                             attr->id, port_id);
             return SAI_STATUS_INVALID_ATTRIBUTE_0;
     }
 
     return SAI_STATUS_SUCCESS;
 }
 
+sai_status_t sai_port_attr_info_cache_get(sai_object_id_t port_id,
+                                          sai_attribute_t *attr)
+{
+    sai_status_t ret_code = SAI_STATUS_SUCCESS;
+
+    STD_ASSERT(!(attr == NULL));
+
+    if(!sai_is_port_valid(port_id)) {
+        SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not valid port", port_id);
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    sai_port_attr_info_t *port_attr_info = sai_port_attr_info_get(port_id);
+    STD_ASSERT(!(port_attr_info == NULL));
+
+    ret_code = sai_port_attr_info_value_get(port_attr_info, attr->id, &attr->value);
+    if(ret_code != SAI_STATUS_SUCCESS) {
+        SAI_PORT_LOG_ERR("Attribute %d not in cache list for port 0x%"PRIx64"",
+                         attr->id, port_id);
+    }
+
+    return ret_code;
+}
+
+/* Get the attribute cache of a valid logical port or of the CPU port */
+static sai_port_attr_info_t *sai_port_valid_attr_info_get(sai_object_id_t port)
+{
+    sai_port_info_t *port_info = NULL;
+
+    if(port == sai_switch_cpu_port_obj_id_get()) {
+        return &cpu_port_attr_info;
+    }
+
+    if(!sai_is_obj_id_logical_port(port)) {
+        return NULL;
+    }
+
+    port_info = sai_port_info_get(port);
+    if((port_info == NULL) || (!port_info->port_valid)) {
+        return NULL;
+    }
+
+    return &port_info->port_attr_info;
+}
+
+sai_status_t sai_port_attr_info_cache_bulk_get(bool all_ports,
+                                               sai_port_attr_bulk_info_t *bulk_info)
+{
+    sai_port_attr_info_t *port_attr_info = NULL;
+    sai_port_info_t *port_info = NULL;
+    sai_attribute_value_t value;
+    uint32_t port_count = 0;
+    uint32_t port_idx = 0;
+    uint32_t attr_idx = 0;
+
+    STD_ASSERT(!(bulk_info == NULL));
+    STD_ASSERT(!(bulk_info->port_list.list == NULL));
+    STD_ASSERT(!(bulk_info->value_list == NULL));
+    STD_ASSERT(!(bulk_info->port_status_list == NULL));
+
+    /* Check the attributes once rather than for every port */
+    for(attr_idx = 0; attr_idx < bulk_info->attr_count; attr_idx++) {
+        if(sai_port_attr_info_value_get(&cpu_port_attr_info,
+                                        bulk_info->attr_id_list[attr_idx],
+                                        &value) != SAI_STATUS_SUCCESS) {
+            SAI_PORT_LOG_ERR("Attribute %d not in cache list",
+                             bulk_info->attr_id_list[attr_idx]);
+            return (SAI_STATUS_INVALID_ATTRIBUTE_0 + attr_idx);
+        }
+    }
+
+    if(all_ports) {
+        for (port_info = sai_port_info_getfirst(); (port_info != NULL);
+             port_info = sai_port_info_getnext(port_info)) {
+            if(port_info->port_valid) {
+                if(port_count < bulk_info->port_list.count) {
+                    bulk_info->port_list.list[port_count] = port_info->sai_port_id;
+                }
+                port_count++;
+            }
+        }
+
+        if(port_count > bulk_info->port_list.count) {
+            bulk_info->port_list.count = port_count;
+            return SAI_STATUS_BUFFER_OVERFLOW;
+        }
+        bulk_info->port_list.count = port_count;
+    }
+
+    port_count = bulk_info->port_list.count;
+
+    for(port_idx = 0; port_idx < port_count; port_idx++) {
+        port_attr_info = sai_port_valid_attr_info_get(bulk_info->port_list.list[port_idx]);
+        if(port_attr_info == NULL) {
+            bulk_info->port_status_list[port_idx] = SAI_STATUS_INVALID_OBJECT_ID;
+            continue;
+        }
+
+        for(attr_idx = 0; attr_idx < bulk_info->attr_count; attr_idx++) {
+            sai_port_attr_info_value_get(port_attr_info,
+                                         bulk_info->attr_id_list[attr_idx],
+                                         &bulk_info->value_list[(attr_idx * port_count) +
+                                                                port_idx]);
+        }
+        bulk_info->port_status_list[port_idx] = SAI_STATUS_SUCCESS;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
@@ -33,7 +33,29 @@
 #include "std_mutex_lock.h"
 #include "std_struct_utils.h"
 
-static std_mutex_lock_create_static_init_fast(port_lock);
+/* Recursive, the port info lookups done with the lock held fill the indexes
+ * under the lock */
+static std_mutex_lock_create_static_init_rec(port_lock);
+
+/* Port info index entry. The indexes are read and written with port_lock
+ * held. A hit is checked against the key of the node, and a node removed
+ * from the port info table with sai_port_info_remove is cleared from the
+ * indexes */
+typedef struct _sai_port_info_index_entry_t {
+    sai_object_id_t   sai_port_id;
+    sai_port_info_t  *port_info;
+} sai_port_info_index_entry_t;
+
+/* Port info nodes indexed on the port number of the port UOID. Nodes are
+ * inserted in the port info tree by the NPU, the index is filled by
+ * sai_port_info_index_build and on the first lookup of a port. */
+static sai_port_info_index_entry_t *sai_port_info_index = NULL;
+static uint_t sai_port_info_index_size = 0;
+
+/* Port info nodes indexed on the NPU local port id, built and filled
+ * along with the port info index */
+static sai_port_info_index_entry_t *sai_port_local_port_index = NULL;
+static uint_t sai_port_local_port_index_size = 0;
 
 void sai_port_lock(void)
 {
@@ -68,9 +90,123 @@ sai_status_t sai_port_info_init(void)
     /* @todo replace STD_ASSERT with RELEASE_ASSERT */
     STD_ASSERT(!(switch_info->port_applications_tree == NULL));
 
+    return sai_port_info_index_build();
+}
+
+sai_status_t sai_port_info_index_build(void)
+{
+    sai_port_info_index_entry_t *port_info_index = NULL;
+    sai_port_info_index_entry_t *local_port_index = NULL;
+    sai_port_info_t *port_info = NULL;
+    uint_t index_size = sai_switch_get_max_lport() + 1;
+    uint_t local_index_size = index_size;
+    uint_t port_num;
+
+    sai_port_lock();
+
+    for (port_info = sai_port_info_getfirst(); (port_info != NULL);
+         port_info = sai_port_info_getnext(port_info)) {
+
+        port_num = sai_uoid_npu_obj_id_get(port_info->sai_port_id);
+        if((port_num < SAI_PORT_INFO_INDEX_MAX_SIZE) && (port_num >= index_size)) {
+            index_size = port_num + 1;
+        }
+
+        port_num = port_info->local_port_id;
+        if((port_num < SAI_PORT_INFO_INDEX_MAX_SIZE) && (port_num >= local_index_size)) {
+            local_index_size = port_num + 1;
+        }
+    }
+
+    if(index_size > SAI_PORT_INFO_INDEX_MAX_SIZE) {
+        index_size = SAI_PORT_INFO_INDEX_MAX_SIZE;
+    }
+    if(local_index_size > SAI_PORT_INFO_INDEX_MAX_SIZE) {
+        local_index_size = SAI_PORT_INFO_INDEX_MAX_SIZE;
+    }
+
+    port_info_index = (sai_port_info_index_entry_t *)
+        calloc(index_size, sizeof(sai_port_info_index_entry_t));
+    local_port_index = (sai_port_info_index_entry_t *)
+        calloc(local_index_size, sizeof(sai_port_info_index_entry_t));
+    if((port_info_index == NULL) || (local_port_index == NULL)) {
+        SAI_PORT_LOG_ERR("Allocation of Memory failed for port info index "
+                         "of %d ports", index_size);
+        free(port_info_index);
+        free(local_port_index);
+        sai_port_unlock();
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    for (port_info = sai_port_info_getfirst(); (port_info != NULL);
+         port_info = sai_port_info_getnext(port_info)) {
+
+        port_num = sai_uoid_npu_obj_id_get(port_info->sai_port_id);
+        if(port_num < index_size) {
+            port_info_index[port_num].sai_port_id = port_info->sai_port_id;
+            port_info_index[port_num].port_info = port_info;
+        }
+
+        if(port_info->local_port_id < local_index_size) {
+            local_port_index[port_info->local_port_id].sai_port_id =
+                port_info->sai_port_id;
+            local_port_index[port_info->local_port_id].port_info = port_info;
+        }
+    }
+
+    free(sai_port_info_index);
+    sai_port_info_index = port_info_index;
+    sai_port_info_index_size = index_size;
+
+    free(sai_port_local_port_index);
+    sai_port_local_port_index = local_port_index;
+    sai_port_local_port_index_size = local_index_size;
+
+    sai_port_unlock();
+
     return SAI_STATUS_SUCCESS;
 }
 
+/* Clear a port info node from the indexes, port_lock is held */
+static void sai_port_info_index_remove(const sai_port_info_t *port_info)
+{
+    uint_t port_num;
+
+    port_num = sai_uoid_npu_obj_id_get(port_info->sai_port_id);
+    if((port_num < sai_port_info_index_size) &&
+       (sai_port_info_index[port_num].port_info == port_info)) {
+        memset(&sai_port_info_index[port_num], 0, sizeof(sai_port_info_index_entry_t));
+    }
+
+    port_num = port_info->local_port_id;
+    if((port_num < sai_port_local_port_index_size) &&
+       (sai_port_local_port_index[port_num].port_info == port_info)) {
+        memset(&sai_port_local_port_index[port_num], 0,
+               sizeof(sai_port_info_index_entry_t));
+    }
+}
+
+sai_status_t sai_port_info_remove(sai_port_info_t *port_info)
+{
+    sai_status_t ret_code = SAI_STATUS_SUCCESS;
+
+    STD_ASSERT(port_info != NULL);
+
+    sai_port_lock();
+
+    sai_port_info_index_remove(port_info);
+
+    if(std_rbtree_remove(sai_port_info_table_get(), port_info) != port_info) {
+        SAI_PORT_LOG_ERR("Port 0x%"PRIx64" not found in port info table",
+                         port_info->sai_port_id);
+        ret_code = SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    sai_port_unlock();
+
+    return ret_code;
+}
+
 /* Assumption is port info table will be allocated during Init,
  * and it can be accessed without failure checks
  */
@@ -82,25 +218,55 @@ sai_port_info_table_t sai_port_info_table_get(void)
 
 sai_port_info_t *sai_port_info_get(sai_object_id_t port)
 {
-    sai_port_info_table_t port_info_table = sai_port_info_table_get();
+    sai_port_info_table_t port_info_table = NULL;
+    sai_port_info_t *port_info = NULL;
     sai_port_info_t port_info_t;
+    uint_t port_num = sai_uoid_npu_obj_id_get(port);
+
+    sai_port_lock();
+
+    if((port_num < sai_port_info_index_size) &&
+       (sai_port_info_index[port_num].sai_port_id == port)) {
+        port_info = sai_port_info_index[port_num].port_info;
+    }
+
+    if((port_info != NULL) && (port_info->sai_port_id == port)) {
+        sai_port_unlock();
+        return port_info;
+    }
 
-    memset(&port_info_t, 0, sizeof(sai_port_info_t));
+    /* Only the key is compared by the tree */
+    port_info_table = sai_port_info_table_get();
     port_info_t.sai_port_id = port;
 
     /* Port validation check is expected to be done before calling this */
-    return ((sai_port_info_t *) std_rbtree_getexact(port_info_table, &port_info_t));
+    port_info = (sai_port_info_t *) std_rbtree_getexact(port_info_table, &port_info_t);
+
+    if((port_info != NULL) && (port_num < sai_port_info_index_size)) {
+        sai_port_info_index[port_num].sai_port_id = port;
+        sai_port_info_index[port_num].port_info = port_info;
+    }
+
+    sai_port_unlock();
+
+    return port_info;
 }
 
-static inline bool sai_is_logical_port_valid(sai_object_id_t port)
+/* Get the port info of an active logical port */
+static inline sai_port_info_t *sai_port_valid_info_get(sai_object_id_t port)
 {
     sai_port_info_t *port_info_table = sai_port_info_get(port);
 
-    if(port_info_table == NULL) {
-        return false;
+    if((port_info_table == NULL) || (!port_info_table->port_valid)) {
+        return NULL;
     }
 
-    return (port_info_table->port_valid);
+    return port_info_table;
+}
+
+static inline bool sai_is_logical_port_valid(sai_object_id_t port)
+{
+    return (sai_port_valid_info_get(port) != NULL);
 }
 
 bool sai_is_port_valid(sai_object_id_t port)
@@ -124,14 +290,9 @@ sai_status_t sai_port_phy_type_get(sai_object_id_t port, sai_port_phy_t *phy_typ
 {
     STD_ASSERT(phy_type != NULL);
 
-    if(!sai_is_logical_port_valid(port)) {
-        SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
-        return SAI_STATUS_INVALID_OBJECT_ID;
-    }
-
-    sai_port_info_t *port_info_table = sai_port_info_get(port);
+    sai_port_info_t *port_info_table = sai_port_valid_info_get(port);
     if(port_info_table == NULL) {
-        SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid port", port);
+        SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
         return SAI_STATUS_INVALID_OBJECT_ID;
     }
 
@@ -144,15 +305,10 @@ sai_status_t sai_port_port_group_get(sai_object_id_t port, uint_t *port_group)
 {
     STD_ASSERT(port_group != NULL);
 
-    if(!sai_is_logical_port_valid(port)) {
-        SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
-        return SAI_STATUS_INVALID_PORT_NUMBER;
-    }
-
-    sai_port_info_t *port_info_table = sai_port_info_get(port);
+    sai_port_info_t *port_info_table = sai_port_valid_info_get(port);
     if(port_info_table == NULL) {
         SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
-        return SAI_STATUS_INVALID_OBJECT_ID;
+        return SAI_STATUS_INVALID_PORT_NUMBER;
     }
     *port_group = port_info_table->port_group;
 
@@ -165,12 +321,7 @@ sai_status_t sai_port_ext_phy_addr_get(sai_object_id_t port,
     sai_port_phy_t phy_type;
     STD_ASSERT(ext_phy_addr != NULL);
 
-    if(!sai_is_logical_port_valid(port)) {
-        SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
-        return SAI_STATUS_INVALID_OBJECT_ID;
-    }
-
-    sai_port_info_t *port_info_table = sai_port_info_get(port);
+    sai_port_info_t *port_info_table = sai_port_valid_info_get(port);
     if(port_info_table == NULL) {
         SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
         return SAI_STATUS_INVALID_OBJECT_ID;
@@ -213,6 +364,42 @@ sai_status_t sai_port_to_npu_local_port(sai_object_id_t port,
     return SAI_STATUS_SUCCESS;
 }
 
+/* Get the port info of a local port, from the local port index or else
+ * from a walk of the port info table that fills the index */
+static sai_port_info_t *sai_port_info_from_local_port_get(sai_npu_port_id_t local_port_id)
+{
+    sai_port_info_t *port_info_table = NULL;
+
+    sai_port_lock();
+
+    if(local_port_id < sai_port_local_port_index_size) {
+        port_info_table = sai_port_local_port_index[local_port_id].port_info;
+    }
+
+    if((port_info_table != NULL) &&
+       (port_info_table->local_port_id == local_port_id)) {
+        sai_port_unlock();
+        return port_info_table;
+    }
+
+    for (port_info_table = sai_port_info_getfirst(); (port_info_table != NULL);
+         port_info_table = sai_port_info_getnext(port_info_table)) {
+
+        if(port_info_table->local_port_id == local_port_id) {
+            if(local_port_id < sai_port_local_port_index_size) {
+                sai_port_local_port_index[local_port_id].sai_port_id =
+                    port_info_table->sai_port_id;
+                sai_port_local_port_index[local_port_id].port_info = port_info_table;
+            }
+            break;
+        }
+    }
+
+    sai_port_unlock();
+
+    return port_info_table;
+}
+
 sai_status_t sai_npu_local_port_to_sai_port(sai_npu_port_id_t local_port_id,
                                             sai_object_id_t *port)
 {
@@ -224,19 +411,33 @@ sai_status_t sai_npu_local_port_to_sai_port(sai_npu_port_id_t local_port_id,
         return SAI_STATUS_SUCCESS;
     }
 
-    for (port_info_table = sai_port_info_getfirst(); (port_info_table != NULL);
-         port_info_table = sai_port_info_getnext(port_info_table)) {
-
-        if(port_info_table->local_port_id == local_port_id) {
-            *port = port_info_table->sai_port_id;
-            return SAI_STATUS_SUCCESS;
-        }
+    port_info_table = sai_port_info_from_local_port_get(local_port_id);
+    if(port_info_table != NULL) {
+        *port = port_info_table->sai_port_id;
+        return SAI_STATUS_SUCCESS;
     }
 
     SAI_PORT_LOG_ERR("Unable to find mapping for npu port:%d", local_port_id);
     return SAI_STATUS_INVALID_OBJECT_ID;
 }
 
+sai_status_t sai_npu_local_port_to_physical_port(sai_npu_port_id_t local_port_id,
+                                                 sai_npu_port_id_t *phy_port_id)
+{
+    sai_port_info_t *port_info_table = NULL;
+
+    STD_ASSERT(phy_port_id != NULL);
+
+    port_info_table = sai_port_info_from_local_port_get(local_port_id);
+    if(port_info_table == NULL) {
+        SAI_PORT_LOG_ERR("Unable to find mapping for npu port:%d", local_port_id);
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    *phy_port_id = port_info_table->phy_port_id;
+    return SAI_STATUS_SUCCESS;
+}
+
 /* Conversion should be possible even for in-active ports */
 sai_status_t sai_port_to_physical_port(sai_object_id_t port,
                                        sai_npu_port_id_t *phy_port_id)
@@ -259,12 +460,7 @@ sai_status_t sai_port_max_lanes_get(sai_object_id_t port,
 {
     STD_ASSERT(max_lanes_per_port != NULL);
 
-    if(!sai_is_logical_port_valid(port)) {
-        SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
-        return SAI_STATUS_INVALID_OBJECT_ID;
-    }
-
-    sai_port_info_t *port_info_table = sai_port_info_get(port);
+    sai_port_info_t *port_info_table = sai_port_valid_info_get(port);
     if(port_info_table == NULL) {
         SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
         return SAI_STATUS_INVALID_OBJECT_ID;
@@ -279,12 +475,7 @@ sai_status_t sai_port_lane_bmap_get(sai_object_id_t port,
 {
     STD_ASSERT(port_lane_bmap != NULL);
 
-    if(!sai_is_logical_port_valid(port)) {
-        SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
-        return SAI_STATUS_INVALID_OBJECT_ID;
-    }
-
-    sai_port_info_t *port_info_table = sai_port_info_get(port);
+    sai_port_info_t *port_info_table = sai_port_valid_info_get(port);
     if(port_info_table == NULL) {
         SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
         return SAI_STATUS_INVALID_OBJECT_ID;
@@ -297,12 +488,7 @@ sai_status_t sai_port_lane_bmap_get(sai_object_id_t port,
 sai_status_t sai_port_lane_bmap_set(sai_object_id_t port,
                                     uint64_t port_lane_bmap)
 {
-    if(!sai_is_logical_port_valid(port)) {
-        SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
-        return SAI_STATUS_INVALID_OBJECT_ID;
-    }
-
-    sai_port_info_t *port_info_table = sai_port_info_get(port);
+    sai_port_info_t *port_info_table = sai_port_valid_info_get(port);
     if(port_info_table == NULL) {
         SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
         return SAI_STATUS_INVALID_OBJECT_ID;
@@ -316,12 +502,7 @@ sai_status_t sai_port_speed_get(sai_object_id_t port, sai_port_speed_t *speed)
 {
     STD_ASSERT(speed != NULL);
 
-    if(!sai_is_logical_port_valid(port)) {
-        SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
-        return SAI_STATUS_INVALID_OBJECT_ID;
-    }
-
-    sai_port_info_t *port_info_table = sai_port_info_get(port);
+    sai_port_info_t *port_info_table = sai_port_valid_info_get(port);
     if(port_info_table == NULL) {
         SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
         return SAI_STATUS_INVALID_OBJECT_ID;
@@ -338,12 +519,7 @@ sai_status_t sai_port_speed_set(sai_object_id_t port, sai_port_speed_t speed)
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
-    if(!sai_is_logical_port_valid(port)) {
-        SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
-        return SAI_STATUS_INVALID_OBJECT_ID;
-    }
-
-    sai_port_info_t *port_info_table = sai_port_info_get(port);
+    sai_port_info_t *port_info_table = sai_port_valid_info_get(port);
     if(port_info_table == NULL) {
         SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
         return SAI_STATUS_INVALID_OBJECT_ID;
@@ -394,12 +570,7 @@ sai_status_t sai_port_attr_supported_speed_get(sai_object_id_t port,
     sai_status_t ret_code = SAI_STATUS_SUCCESS;
     int32_t sai_port_supported_speed_list[SAI_PORT_CAP_SPEED_MAX] = {0};
 
-    if(!sai_is_logical_port_valid(port)) {
-        SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
-        return SAI_STATUS_INVALID_OBJECT_ID;
-    }
-
-    sai_port_info_t *sai_port_info = sai_port_info_get(port);
+    sai_port_info_t *sai_port_info = sai_port_valid_info_get(port);
     if(sai_port_info == NULL) {
         SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
         return SAI_STATUS_INVALID_OBJECT_ID;
@@ -476,12 +647,7 @@ sai_status_t sai_port_media_type_get(sai_object_id_t port,
 {
     STD_ASSERT(media_type != NULL);
 
-    if(!sai_is_logical_port_valid(port)) {
-        SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
-        return SAI_STATUS_INVALID_OBJECT_ID;
-    }
-
-    sai_port_info_t *port_info_table = sai_port_info_get(port);
+    sai_port_info_t *port_info_table = sai_port_valid_info_get(port);
     if(port_info_table == NULL) {
         SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
         return SAI_STATUS_INVALID_OBJECT_ID;
@@ -494,12 +660,7 @@ sai_status_t sai_port_media_type_get(sai_object_id_t port,
 sai_status_t sai_port_media_type_set(sai_object_id_t port,
                                      sai_port_media_type_t media_type)
 {
-    if(!sai_is_logical_port_valid(port)) {
-        SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
-        return SAI_STATUS_INVALID_OBJECT_ID;
-    }
-
-    sai_port_info_t *port_info_table = sai_port_info_get(port);
+    sai_port_info_t *port_info_table = sai_port_valid_info_get(port);
     if(port_info_table == NULL) {
         SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
         return SAI_STATUS_INVALID_OBJECT_ID;
@@ -517,12 +678,7 @@ sai_status_t sai_is_port_capb_supported(sai_object_id_t port,
     STD_ASSERT(value != NULL);
     *value = false;
 
-    if(!sai_is_logical_port_valid(port)) {
-        SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
-        return SAI_STATUS_INVALID_OBJECT_ID;
-    }
-
-    sai_port_info_t *sai_port_info_ptr = sai_port_info_get(port);
+    sai_port_info_t *sai_port_info_ptr = sai_port_valid_info_get(port);
     if(sai_port_info_ptr == NULL) {
         SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
         return SAI_STATUS_INVALID_OBJECT_ID;
@@ -538,12 +694,7 @@ sai_status_t sai_is_port_capb_supported(sai_object_id_t port,
 void sai_port_supported_capability_set(sai_object_id_t port,
                                        uint64_t capb_val)
 {
-    if(!sai_is_logical_port_valid(port)) {
-        SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
-        return;
-    }
-
-    sai_port_info_t *sai_port_info_ptr = sai_port_info_get(port);
+    sai_port_info_t *sai_port_info_ptr = sai_port_valid_info_get(port);
     if(sai_port_info_ptr == NULL) {
         SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
         return;
@@ -562,12 +713,7 @@ sai_status_t sai_is_port_capb_enabled(sai_object_id_t port,
     STD_ASSERT(value != NULL);
     *value = false;
 
-    if(!sai_is_logical_port_valid(port)) {
-        SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
-        return SAI_STATUS_INVALID_OBJECT_ID;
-    }
-
-    sai_port_info_t *sai_port_info_ptr = sai_port_info_get(port);
+    sai_port_info_t *sai_port_info_ptr = sai_port_valid_info_get(port);
     if(sai_port_info_ptr == NULL) {
         SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
         return SAI_STATUS_INVALID_OBJECT_ID;
@@ -582,12 +728,7 @@ sai_status_t sai_is_port_capb_enabled(sai_object_id_t port,
 
 void sai_port_capablility_enable(sai_object_id_t port, bool enable, uint64_t capb_val)
 {
-    if(!sai_is_logical_port_valid(port)) {
-        SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
-        return;
-    }
-
-    sai_port_info_t *sai_port_info_ptr = sai_port_info_get(port);
+    sai_port_info_t *sai_port_info_ptr = sai_port_valid_info_get(port);
     if(sai_port_info_ptr == NULL) {
         SAI_PORT_LOG_ERR("Port 0x%"PRIx64" is not a valid logical port", port);
         return;
@@ -18,6 +18,10 @@
 #include "saitypes.h"
 #include "sai_l3_util.h"
 #include "sai_l3_common.h"
+#include "sai_l3_ip_prefix.h"
+#include "sai_l3_nh_group_bucket.h"
+#include "sai_l3_nh_hash.h"
+#include "sai_l3_nh_resolve.h"
 #include "sai_debug_utils.h"
 #include "std_type_defs.h"
 #include "std_mac_utils.h"
@@ -44,21 +48,26 @@ void sai_fib_dump_help (void)
     SAI_DEBUG ("  void sai_fib_dump_all_rif (void)");
     SAI_DEBUG ("  void sai_fib_dump_nh (sai_object_id_t nh_id)");
     SAI_DEBUG ("  void sai_fib_dump_all_nh (void)");
+    SAI_DEBUG ("  void sai_fib_dump_nh_hash_info (void)");
+    SAI_DEBUG ("  void sai_fib_dump_nh_resolve_info (void)");
     SAI_DEBUG ("  void sai_fib_dump_neighbor_entry (uint_t af_family, ");
     SAI_DEBUG ("       const char *ip_str, sai_object_id_t rif_id)");
     SAI_DEBUG ("  void sai_fib_dump_all_neighbor_in_vr (sai_object_id_t vr_id)");
     SAI_DEBUG ("  void sai_fib_dump_nh_group (sai_object_id_t group_id)");
     SAI_DEBUG ("  void sai_fib_dump_all_nh_group (void)");
     SAI_DEBUG ("  void sai_fib_dump_nh_list_from_nh_group (sai_object_id_t group_id)");
+    SAI_DEBUG ("  void sai_fib_dump_nh_group_bucket_table (sai_object_id_t group_id)");
     SAI_DEBUG ("  void sai_fib_dump_route_entry (sai_object_id_t vrf, ");
     SAI_DEBUG ("       uint_t af, char *ip_str, uint_t prefix_len)");
     SAI_DEBUG ("  void sai_fib_dump_all_route_in_vr (sai_object_id_t vr_id)");
+    SAI_DEBUG ("  void sai_fib_dump_vr_route_stats (sai_object_id_t vr_id)");
     SAI_DEBUG ("  void sai_fib_dump_neighbor_mac_entry_tree (void)");
 }
 
 void sai_fib_dump_vr_node (sai_fib_vrf_t *p_vrf_node)
 {
-    char p_buf [SAI_FIB_DBG_MAX_BUFSZ];
+    char                     p_buf [SAI_FIB_DBG_MAX_BUFSZ];
+    sai_fib_vrf_mem_stats_t *p_mem_stats = NULL;
 
     if (p_vrf_node == NULL) {
         SAI_DEBUG ("VR node is NULL.");
@@ -68,7 +77,8 @@ void sai_fib_dump_vr_node (sai_fib_vrf_t *p_vrf_node)
     SAI_DEBUG ("*************** Dumping VR information ******************");
     SAI_DEBUG ("VR Id: 0x%"PRIx64", p_vrf_node: %p, V4 admin state: %s, "
                "V6 admin state: %s, IP Opt action: %d (%s), MAC: %s, "
-               "Number of RIFs: %d, IP NH tree: %p, Route tree: %p.",
+               "Number of RIFs: %d, IP NH tree: %p, Route tree: %p, "
+               "IPv4 routes: %d, IPv6 routes: %d.",
                p_vrf_node->vrf_id, p_vrf_node,
                (p_vrf_node->v4_admin_state)? "ON" : "OFF",
                (p_vrf_node->v6_admin_state)? "ON" : "OFF",
@@ -76,7 +86,20 @@ void sai_fib_dump_vr_node (sai_fib_vrf_t *p_vrf_node)
                sai_packet_action_str (p_vrf_node->ip_options_pkt_action),
                std_mac_to_string ((const hal_mac_addr_t *)&p_vrf_node->src_mac,
                p_buf, SAI_FIB_DBG_MAX_BUFSZ), p_vrf_node->num_rif,
-               p_vrf_node->sai_nh_tree, p_vrf_node->sai_route_tree);
+               p_vrf_node->sai_nh_tree, p_vrf_node->sai_route_tree,
+               p_vrf_node->route_stats.num_v4_routes,
+               p_vrf_node->route_stats.num_v6_routes);
+
+    p_mem_stats = &p_vrf_node->mem_stats;
+
+    SAI_DEBUG ("Memory: Routes: %d (%"PRIu64" bytes), Next Hops: %d "
+               "(%"PRIu64" bytes), Neighbor MAC entries: %d (%"PRIu64" bytes), "
+               "Radix: %"PRIu64" bytes, Total: %"PRIu64" bytes.",
+               p_mem_stats->num_routes, p_mem_stats->route_bytes,
+               p_mem_stats->num_nh, p_mem_stats->nh_bytes,
+               p_mem_stats->num_neighbor_mac_entries,
+               p_mem_stats->neighbor_mac_entry_bytes, p_mem_stats->radix_bytes,
+               sai_fib_vrf_mem_stats_total_bytes_get (p_mem_stats));
 }
 
 void sai_fib_dump_vr (sai_object_id_t vr_id)
@@ -139,6 +162,9 @@ void sai_fib_dump_rif_node (sai_fib_router_interface_t *p_rif_node)
                 SAI_FIB_DBG_MAX_BUFSZ), p_rif_node->ip_options_pkt_action,
                sai_packet_action_str (p_rif_node->ip_options_pkt_action),
                p_rif_node->ref_count);
+    SAI_DEBUG ("Memory: Next Hops: %d, Neighbors: %d, Bytes: %"PRIu64".",
+               p_rif_node->mem_stats.num_nh, p_rif_node->mem_stats.num_neighbors,
+               p_rif_node->mem_stats.bytes);
 }
 
 void sai_fib_dump_all_rif_in_vr (sai_object_id_t vr_id)
@@ -257,6 +283,15 @@ void sai_fib_dump_route_entry (sai_object_id_t vrf, uint_t af_family, char *ip_s
         return;
     }
 
+    if (sai_fib_ip_prefix_len_validate (key.prefix.addr_family, prefix_len) !=
+        SAI_STATUS_SUCCESS) {
+        SAI_DEBUG ("Prefix length %d is not valid.", prefix_len);
+
+        return;
+    }
+
+    sai_fib_ip_prefix_canonicalize (&key.prefix, prefix_len);
+
     key_len = sai_fib_addr_family_bitlen() + prefix_len;
 
     p_route =
@@ -275,10 +310,8 @@ void sai_fib_dump_route_entry (sai_object_id_t vrf, uint_t af_family, char *ip_s
 
 void sai_fib_dump_all_route_in_vr (sai_object_id_t vrf)
 {
-    sai_fib_route_key_t  route_node_key;
     sai_fib_vrf_t       *p_vrf_node = NULL;
     sai_fib_route_t     *p_route = NULL;
-    uint_t               key_len = 0;
     unsigned int         count = 0;
 
     p_vrf_node = sai_fib_vrf_node_get (vrf);
@@ -289,35 +322,54 @@ void sai_fib_dump_all_route_in_vr (sai_object_id_t vrf)
         return;
     }
 
-    memset (&route_node_key, 0, sizeof (sai_fib_route_key_t));
-
-    key_len  =  sai_fib_addr_family_bitlen();
-
-    p_route =
-        (sai_fib_route_t *) std_radix_getexact (p_vrf_node->sai_route_tree,
-                                                (uint8_t *)&route_node_key,
-                                                 key_len);
-
-    if (!p_route) {
-        p_route =
-            (sai_fib_route_t *) std_radix_getnext (p_vrf_node->sai_route_tree,
-                                                   (uint8_t *)&route_node_key,
-                                                   key_len);
-    }
-
     SAI_DEBUG ("******* Dumping all Route nodes *******");
-    while (p_route) {
+    for (p_route = sai_fib_route_get_first (p_vrf_node); p_route != NULL;
+         p_route = sai_fib_route_get_next (p_vrf_node, p_route)) {
         SAI_DEBUG (" Route Node %d.", ++count);
         sai_fib_dump_route_node (p_route);
+    }
+}
+
+void sai_fib_dump_vr_route_stats (sai_object_id_t vrf)
+{
+    sai_fib_vrf_route_stats_t stats;
+    uint_t                    prefix_len;
+    uint_t                    idx;
 
-        memcpy (&route_node_key, &p_route->key, sizeof (sai_fib_route_key_t));
+    if (sai_fib_vrf_route_stats_get (vrf, &stats) != SAI_STATUS_SUCCESS) {
+        SAI_DEBUG ("VR node does not exist with VRF ID 0x%"PRIx64".",
+                   vrf);
+        return;
+    }
 
-        key_len = sai_fib_addr_family_bitlen() + p_route->prefix_len;
+    SAI_DEBUG ("******* Dumping Route statistics for VRF 0x%"PRIx64" *******",
+               vrf);
+    SAI_DEBUG ("IPv4 routes: %d, IPv6 routes: %d.", stats.num_v4_routes,
+               stats.num_v6_routes);
+    SAI_DEBUG ("NH type NEXT_HOP: %d, NEXT_HOP_GROUP: %d, NONE: %d.",
+               stats.nh_type_count [SAI_FIB_ROUTE_STATS_NH_TYPE_NEXT_HOP],
+               stats.nh_type_count [SAI_FIB_ROUTE_STATS_NH_TYPE_NEXT_HOP_GROUP],
+               stats.nh_type_count [SAI_FIB_ROUTE_STATS_NH_TYPE_NONE]);
+
+    for (idx = 0; idx < SAI_FIB_ROUTE_STATS_PKT_ACTION_COUNT; idx++) {
+        if (stats.pkt_action_count [idx]) {
+            SAI_DEBUG ("Packet-action %s: %d.", sai_packet_action_str (idx),
+                       stats.pkt_action_count [idx]);
+        }
+    }
+
+    for (prefix_len = 0; prefix_len < SAI_FIB_V4_PREFIX_LEN_COUNT; prefix_len++) {
+        if (stats.v4_prefix_len_count [prefix_len]) {
+            SAI_DEBUG ("IPv4 /%d: %d.", prefix_len,
+                       stats.v4_prefix_len_count [prefix_len]);
+        }
+    }
 
-        p_route =
-            (sai_fib_route_t *) std_radix_getnext (p_vrf_node->sai_route_tree,
-                                                   (uint8_t *)&route_node_key,
-                                                   key_len);
+    for (prefix_len = 0; prefix_len < SAI_FIB_V6_PREFIX_LEN_COUNT; prefix_len++) {
+        if (stats.v6_prefix_len_count [prefix_len]) {
+            SAI_DEBUG ("IPv6 /%d: %d.", prefix_len,
+                       stats.v6_prefix_len_count [prefix_len]);
+        }
     }
 }
 
@@ -484,6 +536,13 @@ void sai_fib_dump_nh_group_node (sai_fib_nh_group_t *p_group)
                p_group->key.group_id, p_group,
                sai_fib_nh_group_type_str (p_group->type),
                p_group->nh_count, p_group->ref_count);
+
+    if (p_group->p_bucket_table) {
+        SAI_DEBUG ("Buckets: %d, Buckets reassigned: %d, Programmed: %s.",
+                   p_group->p_bucket_table->num_buckets,
+                   p_group->p_bucket_table->num_changes,
+                   (p_group->p_bucket_table->is_programmed) ? "Yes" : "No");
+    }
 }
 
 void sai_fib_dump_nh_group (sai_object_id_t group_id)
@@ -553,6 +612,56 @@ void sai_fib_dump_nh_list_from_nh_group (sai_object_id_t group_id)
     }
 }
 
+void sai_fib_dump_nh_group_bucket_table (sai_object_id_t group_id)
+{
+    sai_fib_nh_group_t              *p_nh_group = NULL;
+    sai_fib_nh_group_bucket_table_t *p_table = NULL;
+    sai_fib_wt_link_node_t          *p_nh_link_node = NULL;
+    sai_fib_nh_t                    *p_nh_node = NULL;
+    uint_t                           bucket;
+
+    p_nh_group = sai_fib_next_hop_group_get (group_id);
+
+    if (p_nh_group == NULL) {
+        SAI_DEBUG ("Next Hop Group node does not exist with ID "
+                   "0x%"PRIx64".", group_id);
+
+        return;
+    }
+
+    p_table = p_nh_group->p_bucket_table;
+
+    if (p_table == NULL) {
+        SAI_DEBUG ("Next Hop Group 0x%"PRIx64" has no bucket table.", group_id);
+
+        return;
+    }
+
+    SAI_DEBUG ("****** Dumping bucket table of NH Group Id: 0x%"PRIx64"******",
+               group_id);
+
+    SAI_DEBUG ("Buckets: %d, Buckets reassigned: %d, Programmed: %s.",
+               p_table->num_buckets, p_table->num_changes,
+               (p_table->is_programmed) ? "Yes" : "No");
+
+    for (p_nh_link_node = sai_fib_get_first_nh_from_nh_group (p_nh_group);
+         p_nh_link_node != NULL;
+         p_nh_link_node = sai_fib_get_next_nh_from_nh_group (p_nh_group, p_nh_link_node))
+    {
+        p_nh_node = sai_fib_get_nh_from_dll_link_node (&p_nh_link_node->link_node);
+
+        SAI_DEBUG (" Next Hop Id: 0x%"PRIx64", Weight: %d, Buckets: %d.",
+                   p_nh_node->next_hop_id, p_nh_link_node->weight,
+                   sai_fib_nh_group_bucket_count_get (p_nh_group,
+                                                      p_nh_node->next_hop_id));
+    }
+
+    for (bucket = 0; bucket < p_table->num_buckets; bucket++) {
+        SAI_DEBUG (" Bucket %4d: 0x%"PRIx64"", bucket,
+                   p_table->p_bucket_list [bucket]);
+    }
+}
+
 void sai_fib_dump_neighbor_mac_entry_tree (void)
 {
     sai_fib_nh_t   *p_nh_node = NULL;
@@ -598,3 +707,29 @@ void sai_fib_dump_neighbor_mac_entry_tree (void)
                              SAI_FIB_NEIGHBOR_MAC_ENTRY_TREE_KEY_LEN);
     }
 }
+
+void sai_fib_dump_nh_hash_info (void)
+{
+    sai_fib_nh_hash_t *p_hash = &sai_fib_access_global_config()->nh_hash;
+
+    if (!sai_fib_nh_hash_is_init ()) {
+        SAI_DEBUG ("Next Hop hash index is not initialized.");
+        return;
+    }
+
+    SAI_DEBUG ("Next Hop hash index buckets: %d, Nodes: %d, "
+               "Longest chain: %d.", p_hash->num_buckets, p_hash->num_entries,
+               sai_fib_nh_hash_max_chain_len_get ());
+}
+
+void sai_fib_dump_nh_resolve_info (void)
+{
+    uint_t count;
+    uint_t unresolved_count = 0;
+
+    count = sai_fib_nh_resolve_count_get (&unresolved_count);
+
+    SAI_DEBUG ("Recursive next hops registered: %d, Resolved: %d, "
+               "Unresolved: %d.", count, count - unresolved_count,
+               unresolved_count);
+}
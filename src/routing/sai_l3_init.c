@@ -15,12 +15,19 @@
 *
 *************************************************************************/
 
+/* Writer preferring reader-writer lock initializer */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include "sai_l3_util.h"
+#include "sai_l3_nh_hash.h"
+#include "sai_l3_nh_resolve.h"
 #include "sai_l3_api.h"
 #include "sai_switch_utils.h"
 #include "saitypes.h"
 #include "saistatus.h"
-#include "std_mutex_lock.h"
+#include <pthread.h>
 #include <string.h>
 
 /**************************************************************************
@@ -30,8 +37,14 @@ static sai_fib_global_t g_sai_fib_config = {
     is_init_complete: false,
 };
 
-/* Simple Mutex lock for accessing FIB resources */
-static std_mutex_lock_create_static_init_fast (g_sai_fib_lock);
+/* Reader-writer lock for accessing FIB resources. Writers are preferred so
+ * that a steady flow of readers does not starve the route updates */
+static pthread_rwlock_t g_sai_fib_lock =
+                        PTHREAD_RWLOCK_WRITER_NONRECURSIVE_INITIALIZER_NP;
+
+/* Number of times the FIB lock was taken for writing, read with the read
+ * lock held to detect FIB changes between two read lock holds */
+static uint64_t g_sai_fib_write_gen = 0;
 
 /***************************************************************************
  *                          Accessor Functions
@@ -46,12 +59,29 @@ sai_fib_global_t *sai_fib_access_global_config (void)
  ***************************************************************************/
 void sai_fib_lock (void)
 {
-    std_mutex_lock (&g_sai_fib_lock);
+    pthread_rwlock_wrlock (&g_sai_fib_lock);
+
+    g_sai_fib_write_gen++;
 }
 
 void sai_fib_unlock (void)
 {
-    std_mutex_unlock (&g_sai_fib_lock);
+    pthread_rwlock_unlock (&g_sai_fib_lock);
+}
+
+void sai_fib_read_lock (void)
+{
+    pthread_rwlock_rdlock (&g_sai_fib_lock);
+}
+
+void sai_fib_read_unlock (void)
+{
+    pthread_rwlock_unlock (&g_sai_fib_lock);
+}
+
+uint64_t sai_fib_write_gen_get (void)
+{
+    return g_sai_fib_write_gen;
 }
 
 sai_status_t sai_fib_global_init (void)
@@ -141,6 +171,14 @@ sai_status_t sai_fib_global_init (void)
 
             break;
         }
+
+        sai_rc = sai_fib_nh_hash_init (SAI_FIB_NH_HASH_DFLT_NUM_BUCKETS);
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            SAI_ROUTER_LOG_CRIT ("Failed to create Next Hop hash index.");
+
+            break;
+        }
     } while (0);
 
     if (sai_rc != SAI_STATUS_SUCCESS) {
@@ -177,6 +215,10 @@ void sai_fib_global_cleanup (void)
         std_radix_destroy (g_sai_fib_config.neighbor_mac_tree);
     }
 
+    sai_fib_nh_resolve_deinit ();
+
+    sai_fib_nh_hash_deinit ();
+
     memset (&g_sai_fib_config, 0, sizeof (sai_fib_global_t));
 
     g_sai_fib_config.is_init_complete = false;
@@ -0,0 +1,371 @@
+/************************************************************************
+* LEGALESE:   "Copyright (c) 2015, Dell Inc. All rights reserved."
+*
+* This source code is confidential, proprietary, and contains trade
+* secrets that are the sole property of Dell Inc.
+* Copy and/or distribution of this source code or disassembly or reverse
+* engineering of the resultant object code are strictly forbidden without
+* the written consent of Dell Inc.
+*
+************************************************************************/
+/**
+* @file sai_l3_ip_prefix.c
+*
+* @brief This file contains the IP prefix utility functions for SAI L3
+*        component.
+*
+*************************************************************************/
+
+#include "sai_l3_ip_prefix.h"
+#include "sai_l3_util.h"
+#include "saitypes.h"
+#include "saistatus.h"
+#include "std_type_defs.h"
+#include <string.h>
+#include <stdint.h>
+#include <arpa/inet.h>
+
+/* Bytes 10 and 11 of an IPv4-mapped IPv6 address, bytes 0 to 9 are zero */
+#define SAI_FIB_IPV4_MAPPED_MARKER_OFFSET  (10)
+#define SAI_FIB_IPV4_MAPPED_MARKER         (0xff)
+
+/***************************************************************************
+ *                          Private Functions
+ ***************************************************************************/
+/* Prefix lengths above the address length are clamped to a host mask */
+static inline sai_ip4_t sai_fib_ipv4_mask_get (uint_t prefix_len)
+{
+    if (prefix_len >= SAI_IPV4_ADDR_PREFIX_LEN) {
+        return 0xffffffff;
+    }
+
+    return ((prefix_len == 0) ? 0 :
+            htonl (0xffffffff << (SAI_IPV4_ADDR_PREFIX_LEN - prefix_len)));
+}
+
+static void sai_fib_ipv6_mask_get (uint_t prefix_len, uint8_t *p_mask)
+{
+    uint_t full_bytes;
+    uint_t rem_bits;
+
+    if (prefix_len > SAI_IPV6_ADDR_PREFIX_LEN) {
+        prefix_len = SAI_IPV6_ADDR_PREFIX_LEN;
+    }
+
+    full_bytes = prefix_len / BITS_PER_BYTE;
+    rem_bits = prefix_len % BITS_PER_BYTE;
+
+    memset (p_mask, 0, SAI_IPV6_ADDR_NUM_BYTES);
+    memset (p_mask, 0xff, full_bytes);
+
+    if (rem_bits) {
+        p_mask [full_bytes] = (uint8_t) (0xff << (BITS_PER_BYTE - rem_bits));
+    }
+}
+
+/* Returns true if (addr_1 ^ addr_2) & mask is zero */
+static inline bool sai_fib_ipv6_masked_equal (const uint8_t *p_addr_1,
+                                              const uint8_t *p_addr_2,
+                                              const uint8_t *p_mask)
+{
+    uint64_t addr_1 [2];
+    uint64_t addr_2 [2];
+    uint64_t mask [2];
+
+    memcpy (addr_1, p_addr_1, sizeof (addr_1));
+    memcpy (addr_2, p_addr_2, sizeof (addr_2));
+    memcpy (mask, p_mask, sizeof (mask));
+
+    return ((((addr_1 [0] ^ addr_2 [0]) & mask [0]) |
+             ((addr_1 [1] ^ addr_2 [1]) & mask [1])) == 0);
+}
+
+static inline void sai_fib_ipv6_mask_apply (uint8_t *p_addr,
+                                            const uint8_t *p_mask)
+{
+    uint64_t addr [2];
+    uint64_t mask [2];
+
+    memcpy (addr, p_addr, sizeof (addr));
+    memcpy (mask, p_mask, sizeof (mask));
+
+    addr [0] &= mask [0];
+    addr [1] &= mask [1];
+
+    memcpy (p_addr, addr, sizeof (addr));
+}
+
+static bool sai_fib_ipv6_bytes_are_v4_mapped (const uint8_t *p_addr)
+{
+    static const uint8_t v4_mapped_prefix [SAI_FIB_IPV4_MAPPED_MARKER_OFFSET + 2] =
+                        {0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                         SAI_FIB_IPV4_MAPPED_MARKER, SAI_FIB_IPV4_MAPPED_MARKER};
+
+    return (!memcmp (p_addr, v4_mapped_prefix, sizeof (v4_mapped_prefix)));
+}
+
+/*
+ * Bring an address to the family of the prefix it is compared with. An IPv4
+ * address is mapped to IPv6 and an IPv4-mapped IPv6 address to IPv4.
+ */
+static bool sai_fib_ip_addr_family_align (sai_ip_addr_family_t addr_family,
+                                          const sai_ip_address_t *p_ip_addr,
+                                          sai_ip_address_t *p_aligned_addr)
+{
+    if (p_ip_addr->addr_family == addr_family) {
+        *p_aligned_addr = *p_ip_addr;
+
+        return true;
+    }
+
+    if (addr_family == SAI_IP_ADDR_FAMILY_IPV6) {
+        return (sai_fib_ip_addr_v4_to_v4_mapped (p_ip_addr, p_aligned_addr) ==
+                SAI_STATUS_SUCCESS);
+    }
+
+    return (sai_fib_ip_addr_v4_mapped_to_v4 (p_ip_addr, p_aligned_addr) ==
+            SAI_STATUS_SUCCESS);
+}
+
+/***************************************************************************
+ *                          Public Functions
+ ***************************************************************************/
+sai_status_t sai_fib_ip_prefix_len_validate (sai_ip_addr_family_t addr_family,
+                                             uint_t prefix_len)
+{
+    if (addr_family == SAI_IP_ADDR_FAMILY_IPV4) {
+        return ((prefix_len <= SAI_IPV4_ADDR_PREFIX_LEN) ?
+                SAI_STATUS_SUCCESS : SAI_STATUS_INVALID_PARAMETER);
+    }
+
+    if (addr_family == SAI_IP_ADDR_FAMILY_IPV6) {
+        return ((prefix_len <= SAI_IPV6_ADDR_PREFIX_LEN) ?
+                SAI_STATUS_SUCCESS : SAI_STATUS_INVALID_PARAMETER);
+    }
+
+    return SAI_STATUS_INVALID_PARAMETER;
+}
+
+sai_status_t sai_fib_ip_prefix_mask_get (sai_ip_addr_family_t addr_family,
+                                         uint_t prefix_len,
+                                         sai_ip_address_t *p_mask)
+{
+    if ((p_mask == NULL) ||
+        (sai_fib_ip_prefix_len_validate (addr_family, prefix_len) !=
+         SAI_STATUS_SUCCESS)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    memset (p_mask, 0, sizeof (sai_ip_address_t));
+
+    p_mask->addr_family = addr_family;
+
+    if (addr_family == SAI_IP_ADDR_FAMILY_IPV4) {
+        p_mask->addr.ip4 = sai_fib_ipv4_mask_get (prefix_len);
+    } else {
+        sai_fib_ipv6_mask_get (prefix_len, p_mask->addr.ip6);
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_fib_ip_mask_to_prefix_len (const sai_ip_address_t *p_mask,
+                                            uint_t *p_prefix_len)
+{
+    sai_ip_address_t mask;
+    uint_t           prefix_len = 0;
+    uint_t           max_len;
+    uint_t           index;
+    uint32_t         v4_mask;
+
+    if ((p_mask == NULL) || (p_prefix_len == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (p_mask->addr_family == SAI_IP_ADDR_FAMILY_IPV4) {
+
+        v4_mask = ntohl (p_mask->addr.ip4);
+        prefix_len = (v4_mask == 0) ? 0 :
+                     (SAI_IPV4_ADDR_PREFIX_LEN - __builtin_ctz (v4_mask));
+
+    } else if (p_mask->addr_family == SAI_IP_ADDR_FAMILY_IPV6) {
+
+        max_len = SAI_IPV6_ADDR_NUM_BYTES;
+
+        for (index = 0; (index < max_len) && (p_mask->addr.ip6 [index] == 0xff);
+             index++) {
+            prefix_len += BITS_PER_BYTE;
+        }
+
+        if (index < max_len) {
+            prefix_len += __builtin_clz ((uint32_t) (uint8_t)
+                                         ~p_mask->addr.ip6 [index]) -
+                          ((sizeof (uint32_t) - 1) * BITS_PER_BYTE);
+        }
+
+    } else {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    /* The mask is contiguous if it is the mask of its prefix length */
+    sai_fib_ip_prefix_mask_get (p_mask->addr_family, prefix_len, &mask);
+
+    if (((p_mask->addr_family == SAI_IP_ADDR_FAMILY_IPV4) &&
+         (mask.addr.ip4 != p_mask->addr.ip4)) ||
+        ((p_mask->addr_family == SAI_IP_ADDR_FAMILY_IPV6) &&
+         (memcmp (mask.addr.ip6, p_mask->addr.ip6, SAI_IPV6_ADDR_NUM_BYTES)))) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    *p_prefix_len = prefix_len;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_fib_ip_prefix_canonicalize (sai_ip_address_t *p_ip_addr,
+                                             uint_t prefix_len)
+{
+    uint8_t mask [SAI_IPV6_ADDR_NUM_BYTES];
+
+    if (sai_fib_ip_prefix_len_validate (p_ip_addr->addr_family, prefix_len) !=
+        SAI_STATUS_SUCCESS) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (p_ip_addr->addr_family == SAI_IP_ADDR_FAMILY_IPV4) {
+
+        p_ip_addr->addr.ip4 &= sai_fib_ipv4_mask_get (prefix_len);
+
+    } else {
+
+        sai_fib_ipv6_mask_get (prefix_len, mask);
+        sai_fib_ipv6_mask_apply (p_ip_addr->addr.ip6, mask);
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+bool sai_fib_ip_prefix_is_canonical (const sai_ip_address_t *p_ip_addr,
+                                     uint_t prefix_len)
+{
+    sai_ip_address_t canonical_addr = *p_ip_addr;
+
+    if (sai_fib_ip_prefix_canonicalize (&canonical_addr, prefix_len) !=
+        SAI_STATUS_SUCCESS) {
+        return false;
+    }
+
+    if (p_ip_addr->addr_family == SAI_IP_ADDR_FAMILY_IPV4) {
+        return (canonical_addr.addr.ip4 == p_ip_addr->addr.ip4);
+    }
+
+    return (!memcmp (canonical_addr.addr.ip6, p_ip_addr->addr.ip6,
+                     SAI_IPV6_ADDR_NUM_BYTES));
+}
+
+bool sai_fib_ip_prefix_contains (const sai_ip_address_t *p_prefix,
+                                 uint_t prefix_len,
+                                 const sai_ip_address_t *p_ip_addr)
+{
+    sai_ip_address_t ip_addr;
+    uint8_t          mask [SAI_IPV6_ADDR_NUM_BYTES];
+
+    if (sai_fib_ip_prefix_len_validate (p_prefix->addr_family, prefix_len) !=
+        SAI_STATUS_SUCCESS) {
+        return false;
+    }
+
+    if (!sai_fib_ip_addr_family_align (p_prefix->addr_family, p_ip_addr,
+                                       &ip_addr)) {
+        return false;
+    }
+
+    if (p_prefix->addr_family == SAI_IP_ADDR_FAMILY_IPV4) {
+        return (((p_prefix->addr.ip4 ^ ip_addr.addr.ip4) &
+                 sai_fib_ipv4_mask_get (prefix_len)) == 0);
+    }
+
+    sai_fib_ipv6_mask_get (prefix_len, mask);
+
+    return (sai_fib_ipv6_masked_equal (p_prefix->addr.ip6, ip_addr.addr.ip6,
+                                       mask));
+}
+
+bool sai_fib_ip_prefix_covers (const sai_ip_address_t *p_prefix,
+                               uint_t prefix_len,
+                               const sai_ip_address_t *p_sub_prefix,
+                               uint_t sub_prefix_len)
+{
+    if (sai_fib_ip_prefix_len_validate (p_sub_prefix->addr_family,
+                                        sub_prefix_len) != SAI_STATUS_SUCCESS) {
+        return false;
+    }
+
+    /* Prefix length of the covered prefix in the family of the covering one */
+    if (p_prefix->addr_family != p_sub_prefix->addr_family) {
+
+        if (p_prefix->addr_family == SAI_IP_ADDR_FAMILY_IPV6) {
+            sub_prefix_len += SAI_FIB_IPV4_MAPPED_PREFIX_LEN;
+        } else if (sub_prefix_len >= SAI_FIB_IPV4_MAPPED_PREFIX_LEN) {
+            sub_prefix_len -= SAI_FIB_IPV4_MAPPED_PREFIX_LEN;
+        } else {
+            return false;
+        }
+    }
+
+    return ((sub_prefix_len >= prefix_len) &&
+            (sai_fib_ip_prefix_contains (p_prefix, prefix_len, p_sub_prefix)));
+}
+
+bool sai_fib_ip_addr_is_v4_mapped (const sai_ip_address_t *p_ip_addr)
+{
+    return ((p_ip_addr->addr_family == SAI_IP_ADDR_FAMILY_IPV6) &&
+            (sai_fib_ipv6_bytes_are_v4_mapped (p_ip_addr->addr.ip6)));
+}
+
+sai_status_t sai_fib_ip_addr_v4_to_v4_mapped (const sai_ip_address_t *p_v4_addr,
+                                              sai_ip_address_t *p_v6_addr)
+{
+    sai_ip4_t v4_addr;
+
+    if (p_v4_addr->addr_family != SAI_IP_ADDR_FAMILY_IPV4) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    v4_addr = p_v4_addr->addr.ip4;
+
+    memset (p_v6_addr, 0, sizeof (sai_ip_address_t));
+
+    p_v6_addr->addr_family = SAI_IP_ADDR_FAMILY_IPV6;
+    p_v6_addr->addr.ip6 [SAI_FIB_IPV4_MAPPED_MARKER_OFFSET] =
+                                                 SAI_FIB_IPV4_MAPPED_MARKER;
+    p_v6_addr->addr.ip6 [SAI_FIB_IPV4_MAPPED_MARKER_OFFSET + 1] =
+                                                 SAI_FIB_IPV4_MAPPED_MARKER;
+
+    memcpy (&p_v6_addr->addr.ip6 [SAI_IPV6_ADDR_NUM_BYTES -
+                                  SAI_IPV4_ADDR_NUM_BYTES],
+            &v4_addr, SAI_IPV4_ADDR_NUM_BYTES);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_fib_ip_addr_v4_mapped_to_v4 (const sai_ip_address_t *p_v6_addr,
+                                              sai_ip_address_t *p_v4_addr)
+{
+    sai_ip4_t v4_addr;
+
+    if (!sai_fib_ip_addr_is_v4_mapped (p_v6_addr)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    memcpy (&v4_addr, &p_v6_addr->addr.ip6 [SAI_IPV6_ADDR_NUM_BYTES -
+                                            SAI_IPV4_ADDR_NUM_BYTES],
+            SAI_IPV4_ADDR_NUM_BYTES);
+
+    memset (p_v4_addr, 0, sizeof (sai_ip_address_t));
+
+    p_v4_addr->addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    p_v4_addr->addr.ip4 = v4_addr;
+
+    return SAI_STATUS_SUCCESS;
+}
@@ -0,0 +1,429 @@
+/************************************************************************
+* LEGALESE:   "Copyright (c) 2015, Dell Inc. All rights reserved."
+*
+* This source code is confidential, proprietary, and contains trade
+* secrets that are the sole property of Dell Inc.
+* Copy and/or distribution of this source code or disassembly or reverse
+* engineering of the resultant object code are strictly forbidden without
+* the written consent of Dell Inc.
+*
+************************************************************************/
+/**
+* @file sai_l3_nh_group_bucket.c
+*
+* @brief This file contains the resilient hashing bucket table functions
+*        of the SAI L3 Next Hop Groups.
+*
+*************************************************************************/
+
+#include "sai_l3_nh_group_bucket.h"
+#include "sai_l3_util.h"
+#include "sai_l3_common.h"
+#include "sai_l3_api.h"
+#include "saitypes.h"
+#include "saistatus.h"
+#include "std_type_defs.h"
+#include <string.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+/**
+ * @brief Member of a NH group with its share of the buckets.
+ */
+typedef struct _sai_fib_nh_group_bucket_member_t {
+    sai_object_id_t  next_hop_id;
+    uint_t           weight;
+
+    /** Number of buckets due to the member */
+    uint_t           target;
+
+    /** Number of buckets assigned to the member */
+    uint_t           count;
+} sai_fib_nh_group_bucket_member_t;
+
+/***************************************************************************
+ *                          Private Functions
+ ***************************************************************************/
+static int sai_fib_nh_group_bucket_member_cmp (const void *p_a, const void *p_b)
+{
+    sai_object_id_t id_a = ((const sai_fib_nh_group_bucket_member_t *) p_a)->next_hop_id;
+    sai_object_id_t id_b = ((const sai_fib_nh_group_bucket_member_t *) p_b)->next_hop_id;
+
+    return ((id_a > id_b) - (id_a < id_b));
+}
+
+/* Members sorted by Next Hop Id. Caller frees the list */
+static sai_fib_nh_group_bucket_member_t *sai_fib_nh_group_bucket_members_get (
+                                                 sai_fib_nh_group_t *p_group,
+                                                 uint_t *p_count)
+{
+    sai_fib_nh_group_bucket_member_t *p_member_list = NULL;
+    sai_fib_wt_link_node_t           *p_link = NULL;
+    sai_fib_nh_t                     *p_next_hop = NULL;
+    uint_t                            count = 0;
+
+    for (p_link = sai_fib_get_first_nh_from_nh_group (p_group); p_link != NULL;
+         p_link = sai_fib_get_next_nh_from_nh_group (p_group, p_link)) {
+        count++;
+    }
+
+    p_member_list = (sai_fib_nh_group_bucket_member_t *)
+                    calloc (count + 1, sizeof (sai_fib_nh_group_bucket_member_t));
+
+    if (p_member_list == NULL) {
+        return NULL;
+    }
+
+    count = 0;
+
+    for (p_link = sai_fib_get_first_nh_from_nh_group (p_group); p_link != NULL;
+         p_link = sai_fib_get_next_nh_from_nh_group (p_group, p_link)) {
+
+        if (p_link->weight == 0) {
+            continue;
+        }
+
+        p_next_hop = sai_fib_get_nh_from_dll_link_node (&p_link->link_node);
+
+        p_member_list [count].next_hop_id = p_next_hop->next_hop_id;
+        p_member_list [count].weight = p_link->weight;
+        count++;
+    }
+
+    qsort (p_member_list, count, sizeof (sai_fib_nh_group_bucket_member_t),
+           sai_fib_nh_group_bucket_member_cmp);
+
+    *p_count = count;
+
+    return p_member_list;
+}
+
+/* Share of the buckets of each member, proportional to its weight. The
+ * remaining buckets go to the members with the largest remainders */
+static void sai_fib_nh_group_bucket_targets_set (
+                                 sai_fib_nh_group_bucket_member_t *p_member_list,
+                                 uint_t member_count, uint_t num_buckets)
+{
+    uint64_t total_weight = 0;
+    uint64_t remainder;
+    uint64_t max_remainder;
+    uint_t   assigned = 0;
+    uint_t   index;
+    uint_t   max_index;
+    bool    *p_bumped = NULL;
+
+    for (index = 0; index < member_count; index++) {
+        total_weight += p_member_list [index].weight;
+    }
+
+    if (total_weight == 0) {
+        return;
+    }
+
+    for (index = 0; index < member_count; index++) {
+        p_member_list [index].target = (uint_t)
+            (((uint64_t) num_buckets * p_member_list [index].weight) / total_weight);
+
+        assigned += p_member_list [index].target;
+    }
+
+    p_bumped = (bool *) calloc (member_count, sizeof (bool));
+
+    while (assigned < num_buckets) {
+
+        max_index = member_count;
+        max_remainder = 0;
+
+        for (index = 0; index < member_count; index++) {
+
+            if ((p_bumped) && (p_bumped [index])) {
+                continue;
+            }
+
+            remainder = ((uint64_t) num_buckets * p_member_list [index].weight) %
+                        total_weight;
+
+            if ((max_index == member_count) || (remainder > max_remainder)) {
+                max_index = index;
+                max_remainder = remainder;
+            }
+        }
+
+        /* Without memory to track the bumped members, fall back to the
+         * member order */
+        if ((p_bumped == NULL) || (max_index == member_count)) {
+            max_index = assigned % member_count;
+        } else {
+            p_bumped [max_index] = true;
+        }
+
+        p_member_list [max_index].target++;
+        assigned++;
+    }
+
+    free (p_bumped);
+}
+
+/***************************************************************************
+ *                          Public Functions
+ ***************************************************************************/
+sai_status_t sai_fib_nh_group_bucket_table_create (sai_fib_nh_group_t *p_group,
+                                                   uint_t num_buckets)
+{
+    sai_fib_nh_group_bucket_table_t *p_table = NULL;
+    uint_t                           changed_count = 0;
+    sai_status_t                     status;
+
+    if (p_group == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (p_group->p_bucket_table) {
+        return SAI_STATUS_ITEM_ALREADY_EXISTS;
+    }
+
+    if (num_buckets == 0) {
+        num_buckets = SAI_FIB_NH_GROUP_DFLT_NUM_BUCKETS;
+    }
+
+    if (num_buckets > SAI_FIB_NH_GROUP_MAX_NUM_BUCKETS) {
+        SAI_NH_GROUP_LOG_ERR ("Number of buckets %d is more than the maximum %d.",
+                              num_buckets, SAI_FIB_NH_GROUP_MAX_NUM_BUCKETS);
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    p_table = (sai_fib_nh_group_bucket_table_t *)
+              calloc (1, sizeof (sai_fib_nh_group_bucket_table_t));
+
+    if (p_table == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    p_table->p_bucket_list = (sai_object_id_t *) calloc (num_buckets,
+                                                         sizeof (sai_object_id_t));
+
+    if (p_table->p_bucket_list == NULL) {
+        free (p_table);
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    p_table->num_buckets = num_buckets;
+    p_group->p_bucket_table = p_table;
+
+    /* All the buckets are empty, the update assigns them all */
+    status = sai_fib_nh_group_bucket_table_update (p_group, NULL, &changed_count);
+
+    if (status != SAI_STATUS_SUCCESS) {
+        sai_fib_nh_group_bucket_table_destroy (p_group);
+
+        return status;
+    }
+
+    p_table->num_changes = 0;
+
+    SAI_NH_GROUP_LOG_TRACE ("Bucket table of %d buckets built for group "
+                            "0x%"PRIx64".", num_buckets, p_group->key.group_id);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_fib_nh_group_bucket_table_destroy (sai_fib_nh_group_t *p_group)
+{
+    if ((p_group == NULL) || (p_group->p_bucket_table == NULL)) {
+        return;
+    }
+
+    free (p_group->p_bucket_table->p_bucket_list);
+    free (p_group->p_bucket_table);
+
+    p_group->p_bucket_table = NULL;
+}
+
+sai_status_t sai_fib_nh_group_bucket_table_update (sai_fib_nh_group_t *p_group,
+                                                   uint_t *p_changed_list,
+                                                   uint_t *p_changed_count)
+{
+    sai_fib_nh_group_bucket_table_t  *p_table = NULL;
+    sai_fib_nh_group_bucket_member_t *p_member_list = NULL;
+    sai_fib_nh_group_bucket_member_t *p_member = NULL;
+    sai_fib_nh_group_bucket_member_t  member_key;
+    uint_t                           *p_free_list = NULL;
+    uint_t                            member_count = 0;
+    uint_t                            free_count = 0;
+    uint_t                            changed_count = 0;
+    uint_t                            cursor = 0;
+    uint_t                            scan;
+    uint_t                            index;
+    uint_t                            bucket;
+    sai_object_id_t                   next_hop_id;
+
+    if ((p_group == NULL) || (p_changed_count == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    p_table = p_group->p_bucket_table;
+
+    if (p_table == NULL) {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    p_member_list = sai_fib_nh_group_bucket_members_get (p_group, &member_count);
+    p_free_list = (uint_t *) calloc (p_table->num_buckets, sizeof (uint_t));
+
+    if ((p_member_list == NULL) || (p_free_list == NULL)) {
+        free (p_member_list);
+        free (p_free_list);
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sai_fib_nh_group_bucket_targets_set (p_member_list, member_count,
+                                         p_table->num_buckets);
+
+    memset (&member_key, 0, sizeof (member_key));
+
+    /* Keep the buckets of the members within their share */
+    for (bucket = 0; bucket < p_table->num_buckets; bucket++) {
+
+        member_key.next_hop_id = p_table->p_bucket_list [bucket];
+
+        p_member = (sai_fib_nh_group_bucket_member_t *)
+                   bsearch (&member_key, p_member_list, member_count,
+                            sizeof (sai_fib_nh_group_bucket_member_t),
+                            sai_fib_nh_group_bucket_member_cmp);
+
+        if ((p_member) && (p_member->count < p_member->target)) {
+            p_member->count++;
+        } else {
+            p_free_list [free_count++] = bucket;
+        }
+    }
+
+    /* Spread the free buckets on the members below their share */
+    for (index = 0; index < free_count; index++) {
+
+        bucket = p_free_list [index];
+        next_hop_id = SAI_NULL_OBJECT_ID;
+
+        for (scan = 0; scan < member_count; scan++) {
+
+            p_member = &p_member_list [cursor];
+            cursor = (cursor + 1) % member_count;
+
+            if (p_member->count < p_member->target) {
+                p_member->count++;
+                next_hop_id = p_member->next_hop_id;
+                break;
+            }
+        }
+
+        if (p_table->p_bucket_list [bucket] != next_hop_id) {
+            p_table->p_bucket_list [bucket] = next_hop_id;
+
+            if (p_changed_list) {
+                p_changed_list [changed_count] = bucket;
+            }
+
+            changed_count++;
+        }
+    }
+
+    free (p_member_list);
+    free (p_free_list);
+
+    p_table->num_changes += changed_count;
+    *p_changed_count = changed_count;
+
+    SAI_NH_GROUP_LOG_TRACE ("Group 0x%"PRIx64" members: %d, %d of %d buckets "
+                            "reassigned.", p_group->key.group_id, member_count,
+                            changed_count, p_table->num_buckets);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_fib_nh_group_bucket_table_sync (sai_fib_nh_group_t *p_group,
+                                    const sai_npu_nh_group_api_t *p_nh_group_api)
+{
+    sai_fib_nh_group_bucket_table_t *p_table = NULL;
+    uint_t                          *p_changed_list = NULL;
+    uint_t                           changed_count = 0;
+    sai_status_t                     status;
+
+    if ((p_group == NULL) || (p_group->p_bucket_table == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    p_table = p_group->p_bucket_table;
+
+    p_changed_list = (uint_t *) calloc (p_table->num_buckets, sizeof (uint_t));
+
+    if (p_changed_list == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    status = sai_fib_nh_group_bucket_table_update (p_group, p_changed_list,
+                                                   &changed_count);
+
+    if ((status == SAI_STATUS_SUCCESS) && (p_nh_group_api) &&
+        (p_nh_group_api->nh_group_bucket_update) &&
+        ((changed_count) || (!p_table->is_programmed))) {
+
+        status = p_nh_group_api->nh_group_bucket_update (p_group, p_table,
+                                     (p_table->is_programmed) ? p_changed_list : NULL,
+                                     (p_table->is_programmed) ? changed_count :
+                                     p_table->num_buckets);
+
+        if (status == SAI_STATUS_SUCCESS) {
+            p_table->is_programmed = true;
+        } else {
+            /* Buckets are out of sync, program all of them next time */
+            p_table->is_programmed = false;
+
+            SAI_NH_GROUP_LOG_ERR ("Failed to program %d buckets of group "
+                                  "0x%"PRIx64" in NPU, status: %d.",
+                                  changed_count, p_group->key.group_id, status);
+        }
+    }
+
+    free (p_changed_list);
+
+    return status;
+}
+
+sai_object_id_t sai_fib_nh_group_bucket_nh_id_get (sai_fib_nh_group_t *p_group,
+                                                   uint32_t hash)
+{
+    sai_fib_nh_group_bucket_table_t *p_table = NULL;
+
+    if ((p_group == NULL) || (p_group->p_bucket_table == NULL)) {
+        return SAI_NULL_OBJECT_ID;
+    }
+
+    p_table = p_group->p_bucket_table;
+
+    return (p_table->p_bucket_list [hash % p_table->num_buckets]);
+}
+
+uint_t sai_fib_nh_group_bucket_count_get (sai_fib_nh_group_t *p_group,
+                                          sai_object_id_t next_hop_id)
+{
+    sai_fib_nh_group_bucket_table_t *p_table = NULL;
+    uint_t                           bucket;
+    uint_t                           count = 0;
+
+    if ((p_group == NULL) || (p_group->p_bucket_table == NULL)) {
+        return 0;
+    }
+
+    p_table = p_group->p_bucket_table;
+
+    for (bucket = 0; bucket < p_table->num_buckets; bucket++) {
+        if (p_table->p_bucket_list [bucket] == next_hop_id) {
+            count++;
+        }
+    }
+
+    return count;
+}
@@ -0,0 +1,285 @@
+/************************************************************************
+* LEGALESE:   "Copyright (c) 2015, Dell Inc. All rights reserved."
+*
+* This source code is confidential, proprietary, and contains trade
+* secrets that are the sole property of Dell Inc.
+* Copy and/or distribution of this source code or disassembly or reverse
+* engineering of the resultant object code are strictly forbidden without
+* the written consent of Dell Inc.
+*
+************************************************************************/
+/**
+* @file sai_l3_nh_hash.c
+*
+* @brief This file contains the (RIF, IP) hash index functions of the SAI
+*        L3 Next Hop and Neighbor nodes.
+*
+*************************************************************************/
+
+#include "sai_l3_nh_hash.h"
+#include "sai_l3_util.h"
+#include "sai_l3_common.h"
+#include "saitypes.h"
+#include "saistatus.h"
+#include "std_type_defs.h"
+#include <string.h>
+#include <stdlib.h>
+
+/***************************************************************************
+ *                          Private Functions
+ ***************************************************************************/
+static sai_fib_nh_hash_t *sai_fib_nh_hash_get (void)
+{
+    return (&sai_fib_access_global_config()->nh_hash);
+}
+
+static uint_t sai_fib_nh_hash_addr_len_get (sai_ip_addr_family_t addr_family)
+{
+    return ((addr_family == SAI_IP_ADDR_FAMILY_IPV4) ?
+            SAI_IPV4_ADDR_NUM_BYTES : SAI_IPV6_ADDR_NUM_BYTES);
+}
+
+static uint64_t sai_fib_nh_hash_mix (uint64_t value)
+{
+    value ^= (value >> 33);
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= (value >> 33);
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= (value >> 33);
+
+    return value;
+}
+
+static uint64_t sai_fib_nh_hash_key_get (sai_object_id_t rif_id,
+                                         const sai_ip_address_t *p_ip_addr)
+{
+    const uint8_t *p_addr = (const uint8_t *) &p_ip_addr->addr;
+    uint64_t       hash;
+    uint64_t       word;
+    uint_t         addr_len;
+    uint_t         offset;
+
+    addr_len = sai_fib_nh_hash_addr_len_get (p_ip_addr->addr_family);
+
+    hash = sai_fib_nh_hash_mix (rif_id ^ p_ip_addr->addr_family);
+
+    for (offset = 0; offset < addr_len; offset += sizeof (uint32_t)) {
+        word = 0;
+        memcpy (&word, p_addr + offset, sizeof (uint32_t));
+
+        hash = sai_fib_nh_hash_mix (hash ^ word);
+    }
+
+    return hash;
+}
+
+static bool sai_fib_nh_hash_is_match (const sai_fib_nh_t *p_next_hop,
+                                      sai_object_id_t rif_id,
+                                      const sai_ip_address_t *p_ip_addr)
+{
+    const sai_ip_address_t *p_nh_ip_addr = &p_next_hop->key.info.ip_nh.ip_addr;
+
+    return ((p_next_hop->key.rif_id == rif_id) &&
+            (p_next_hop->key.nh_type == SAI_NEXT_HOP_IP) &&
+            (p_nh_ip_addr->addr_family == p_ip_addr->addr_family) &&
+            (!memcmp (&p_nh_ip_addr->addr, &p_ip_addr->addr,
+                      sai_fib_nh_hash_addr_len_get (p_ip_addr->addr_family))));
+}
+
+static uint_t sai_fib_nh_hash_bucket_get (const sai_fib_nh_hash_t *p_hash,
+                                          sai_object_id_t rif_id,
+                                          const sai_ip_address_t *p_ip_addr)
+{
+    return ((uint_t) (sai_fib_nh_hash_key_get (rif_id, p_ip_addr) &
+                      (p_hash->num_buckets - 1)));
+}
+
+/* Double the bucket array and move the nodes. Index is kept as is if the
+ * new array can not be allocated */
+static void sai_fib_nh_hash_grow (sai_fib_nh_hash_t *p_hash)
+{
+    sai_fib_nh_t **ap_bucket = NULL;
+    sai_fib_nh_t  *p_next_hop = NULL;
+    sai_fib_nh_t  *p_next = NULL;
+    uint_t         num_buckets = p_hash->num_buckets * 2;
+    uint_t         bucket;
+    uint_t         new_bucket;
+
+    ap_bucket = (sai_fib_nh_t **) calloc (num_buckets, sizeof (sai_fib_nh_t *));
+
+    if (ap_bucket == NULL) {
+        SAI_NEXTHOP_LOG_WARN ("Failed to grow Next Hop hash index to %d "
+                              "buckets.", num_buckets);
+        return;
+    }
+
+    for (bucket = 0; bucket < p_hash->num_buckets; bucket++) {
+
+        for (p_next_hop = p_hash->ap_bucket [bucket]; p_next_hop != NULL;
+             p_next_hop = p_next) {
+
+            p_next = p_next_hop->p_hash_next;
+
+            new_bucket = (uint_t) (sai_fib_nh_hash_key_get (
+                                        p_next_hop->key.rif_id,
+                                        &p_next_hop->key.info.ip_nh.ip_addr) &
+                                   (num_buckets - 1));
+
+            p_next_hop->p_hash_next = ap_bucket [new_bucket];
+            ap_bucket [new_bucket] = p_next_hop;
+        }
+    }
+
+    free (p_hash->ap_bucket);
+
+    p_hash->ap_bucket = ap_bucket;
+    p_hash->num_buckets = num_buckets;
+}
+
+/***************************************************************************
+ *                          Public Functions
+ ***************************************************************************/
+sai_status_t sai_fib_nh_hash_init (uint_t num_buckets)
+{
+    sai_fib_nh_hash_t *p_hash = sai_fib_nh_hash_get ();
+    uint_t             size = 1;
+
+    if (p_hash->ap_bucket) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if (num_buckets == 0) {
+        num_buckets = SAI_FIB_NH_HASH_DFLT_NUM_BUCKETS;
+    }
+
+    while (size < num_buckets) {
+        size <<= 1;
+    }
+
+    p_hash->ap_bucket = (sai_fib_nh_t **) calloc (size, sizeof (sai_fib_nh_t *));
+
+    if (p_hash->ap_bucket == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    p_hash->num_buckets = size;
+    p_hash->num_entries = 0;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_fib_nh_hash_deinit (void)
+{
+    sai_fib_nh_hash_t *p_hash = sai_fib_nh_hash_get ();
+
+    free (p_hash->ap_bucket);
+
+    memset (p_hash, 0, sizeof (sai_fib_nh_hash_t));
+}
+
+sai_status_t sai_fib_nh_hash_insert (sai_fib_nh_t *p_next_hop)
+{
+    sai_fib_nh_hash_t *p_hash = sai_fib_nh_hash_get ();
+    uint_t             bucket;
+
+    if (p_next_hop == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (p_hash->ap_bucket == NULL) {
+        return SAI_STATUS_UNINITIALIZED;
+    }
+
+    if (p_hash->num_entries >= p_hash->num_buckets) {
+        sai_fib_nh_hash_grow (p_hash);
+    }
+
+    bucket = sai_fib_nh_hash_bucket_get (p_hash, p_next_hop->key.rif_id,
+                                         &p_next_hop->key.info.ip_nh.ip_addr);
+
+    p_next_hop->p_hash_next = p_hash->ap_bucket [bucket];
+    p_hash->ap_bucket [bucket] = p_next_hop;
+    p_hash->num_entries++;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_fib_nh_hash_remove (sai_fib_nh_t *p_next_hop)
+{
+    sai_fib_nh_hash_t *p_hash = sai_fib_nh_hash_get ();
+    sai_fib_nh_t     **pp_link = NULL;
+    uint_t             bucket;
+
+    if ((p_next_hop == NULL) || (p_hash->ap_bucket == NULL)) {
+        return;
+    }
+
+    bucket = sai_fib_nh_hash_bucket_get (p_hash, p_next_hop->key.rif_id,
+                                         &p_next_hop->key.info.ip_nh.ip_addr);
+
+    for (pp_link = &p_hash->ap_bucket [bucket]; *pp_link != NULL;
+         pp_link = &(*pp_link)->p_hash_next) {
+
+        if (*pp_link == p_next_hop) {
+            *pp_link = p_next_hop->p_hash_next;
+            p_next_hop->p_hash_next = NULL;
+            p_hash->num_entries--;
+            break;
+        }
+    }
+}
+
+sai_fib_nh_t *sai_fib_nh_hash_lookup (sai_object_id_t rif_id,
+                                      const sai_ip_address_t *p_ip_addr)
+{
+    sai_fib_nh_hash_t *p_hash = sai_fib_nh_hash_get ();
+    sai_fib_nh_t      *p_next_hop = NULL;
+    uint_t             bucket;
+
+    if ((p_ip_addr == NULL) || (p_hash->ap_bucket == NULL)) {
+        return NULL;
+    }
+
+    bucket = sai_fib_nh_hash_bucket_get (p_hash, rif_id, p_ip_addr);
+
+    for (p_next_hop = p_hash->ap_bucket [bucket]; p_next_hop != NULL;
+         p_next_hop = p_next_hop->p_hash_next) {
+
+        if (sai_fib_nh_hash_is_match (p_next_hop, rif_id, p_ip_addr)) {
+            return p_next_hop;
+        }
+    }
+
+    return NULL;
+}
+
+bool sai_fib_nh_hash_is_init (void)
+{
+    return (sai_fib_nh_hash_get()->ap_bucket != NULL);
+}
+
+uint_t sai_fib_nh_hash_max_chain_len_get (void)
+{
+    sai_fib_nh_hash_t *p_hash = sai_fib_nh_hash_get ();
+    sai_fib_nh_t      *p_next_hop = NULL;
+    uint_t             bucket;
+    uint_t             len;
+    uint_t             max_len = 0;
+
+    for (bucket = 0; (p_hash->ap_bucket) && (bucket < p_hash->num_buckets);
+         bucket++) {
+
+        len = 0;
+
+        for (p_next_hop = p_hash->ap_bucket [bucket]; p_next_hop != NULL;
+             p_next_hop = p_next_hop->p_hash_next) {
+            len++;
+        }
+
+        if (len > max_len) {
+            max_len = len;
+        }
+    }
+
+    return max_len;
+}
@@ -0,0 +1,802 @@
+/************************************************************************
+* LEGALESE:   "Copyright (c) 2015, Dell Inc. All rights reserved."
+*
+* This source code is confidential, proprietary, and contains trade
+* secrets that are the sole property of Dell Inc.
+* Copy and/or distribution of this source code or disassembly or reverse
+* engineering of the resultant object code are strictly forbidden without
+* the written consent of Dell Inc.
+*
+************************************************************************/
+/**
+* @file sai_l3_nh_resolve.c
+*
+* @brief This file contains the recursive next hop resolution functions of
+*        the SAI L3 component.
+*
+*************************************************************************/
+
+#include "sai_l3_nh_resolve.h"
+#include "sai_l3_ip_prefix.h"
+#include "sai_l3_util.h"
+#include "sai_l3_common.h"
+#include "saitypes.h"
+#include "saistatus.h"
+#include "std_type_defs.h"
+#include "std_llist.h"
+#include "std_rbtree.h"
+#include "std_radix.h"
+#include "std_struct_utils.h"
+#include <string.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+/**
+ * @brief Key of a dependency list. The route is looked up by its prefix
+ * so that a dependency list never points to a freed route node.
+ * is_resolved is false for the list of the addresses of the VRF not
+ * covered by any route, with a zero prefix.
+ */
+typedef struct _sai_fib_nh_resolve_dep_key_t {
+    sai_object_id_t   vrf_id;
+    bool              is_resolved;
+    sai_ip_address_t  prefix;
+    uint_t            prefix_len;
+} sai_fib_nh_resolve_dep_key_t;
+
+/**
+ * @brief Addresses resolved by the same route.
+ */
+typedef struct _sai_fib_nh_resolve_dep_t {
+    sai_fib_nh_resolve_dep_key_t  key;
+
+    /** Nodes of type sai_fib_nh_resolve_entry_t */
+    std_dll_head                  entry_list;
+} sai_fib_nh_resolve_dep_t;
+
+/**
+ * @brief Key of a registered address.
+ */
+typedef struct _sai_fib_nh_resolve_entry_key_t {
+    sai_object_id_t   vrf_id;
+    sai_ip_address_t  ip_addr;
+} sai_fib_nh_resolve_entry_key_t;
+
+/**
+ * @brief Registered recursive next hop address.
+ */
+typedef struct _sai_fib_nh_resolve_entry_t {
+
+    /** Glue of the dependency list, must be the first field */
+    std_dll                          dep_glue;
+
+    sai_fib_nh_resolve_entry_key_t   key;
+
+    /** Dependency list of the resolving route */
+    sai_fib_nh_resolve_dep_t        *p_dep;
+
+    uint_t                           ref_count;
+    void                            *p_cookie;
+
+    /** Resolution last notified, to drop the changes reverted before a
+     * flush */
+    bool                             is_notified_resolved;
+    sai_object_id_t                  notified_nh_id;
+    sai_packet_action_t              notified_packet_action;
+
+    /** Entry is in the pending list */
+    bool                             is_pending;
+} sai_fib_nh_resolve_entry_t;
+
+/***************************************************************************
+ *                          GLOBALS
+ ***************************************************************************/
+static rbtree_handle g_sai_fib_nh_resolve_entry_tree = NULL;
+static rbtree_handle g_sai_fib_nh_resolve_dep_tree = NULL;
+
+static sai_fib_nh_resolve_notify_fn g_sai_fib_nh_resolve_notify_fn = NULL;
+
+static sai_fib_nh_resolve_entry_t **g_sai_fib_nh_resolve_pending = NULL;
+static sai_fib_nh_resolve_info_t   *g_sai_fib_nh_resolve_info_list = NULL;
+static uint_t                       g_sai_fib_nh_resolve_num_pending = 0;
+static uint_t                       g_sai_fib_nh_resolve_batch_size = 0;
+
+/***************************************************************************
+ *                          Private Functions
+ ***************************************************************************/
+static bool sai_fib_nh_resolve_is_init (void)
+{
+    return (g_sai_fib_nh_resolve_entry_tree != NULL);
+}
+
+static void sai_fib_nh_resolve_entry_key_set (sai_fib_nh_resolve_entry_key_t *p_key,
+                                              sai_object_id_t vrf_id,
+                                              const sai_ip_address_t *p_ip_addr)
+{
+    memset (p_key, 0, sizeof (sai_fib_nh_resolve_entry_key_t));
+
+    p_key->vrf_id = vrf_id;
+    p_key->ip_addr.addr_family = p_ip_addr->addr_family;
+
+    if (p_ip_addr->addr_family == SAI_IP_ADDR_FAMILY_IPV4) {
+        p_key->ip_addr.addr.ip4 = p_ip_addr->addr.ip4;
+    } else {
+        memcpy (p_key->ip_addr.addr.ip6, p_ip_addr->addr.ip6,
+                sizeof (sai_ip6_t));
+    }
+}
+
+static sai_fib_nh_resolve_entry_t *sai_fib_nh_resolve_entry_get (
+                                            sai_object_id_t vrf_id,
+                                            const sai_ip_address_t *p_ip_addr)
+{
+    sai_fib_nh_resolve_entry_t entry;
+
+    memset (&entry, 0, sizeof (entry));
+
+    sai_fib_nh_resolve_entry_key_set (&entry.key, vrf_id, p_ip_addr);
+
+    return ((sai_fib_nh_resolve_entry_t *)
+            std_rbtree_getexact (g_sai_fib_nh_resolve_entry_tree, &entry));
+}
+
+static sai_fib_nh_resolve_dep_t *sai_fib_nh_resolve_dep_get (
+                                                  sai_object_id_t vrf_id,
+                                                  sai_fib_route_t *p_route,
+                                                  bool is_create)
+{
+    sai_fib_nh_resolve_dep_t  dep;
+    sai_fib_nh_resolve_dep_t *p_dep = NULL;
+
+    memset (&dep, 0, sizeof (dep));
+
+    dep.key.vrf_id = vrf_id;
+
+    if (p_route) {
+        dep.key.is_resolved = true;
+        dep.key.prefix_len  = p_route->prefix_len;
+
+        sai_fib_ip_addr_copy (&dep.key.prefix, &p_route->key.prefix);
+    }
+
+    p_dep = (sai_fib_nh_resolve_dep_t *)
+            std_rbtree_getexact (g_sai_fib_nh_resolve_dep_tree, &dep);
+
+    if ((p_dep) || (!is_create)) {
+        return p_dep;
+    }
+
+    p_dep = (sai_fib_nh_resolve_dep_t *) calloc (1, sizeof (sai_fib_nh_resolve_dep_t));
+
+    if (p_dep == NULL) {
+        return NULL;
+    }
+
+    p_dep->key = dep.key;
+    std_dll_init (&p_dep->entry_list);
+
+    if (std_rbtree_insert (g_sai_fib_nh_resolve_dep_tree, p_dep) != STD_ERR_OK) {
+        free (p_dep);
+
+        return NULL;
+    }
+
+    return p_dep;
+}
+
+static void sai_fib_nh_resolve_dep_free_if_empty (sai_fib_nh_resolve_dep_t *p_dep)
+{
+    if ((p_dep == NULL) || (std_dll_getfirst (&p_dep->entry_list) != NULL)) {
+        return;
+    }
+
+    std_rbtree_remove (g_sai_fib_nh_resolve_dep_tree, p_dep);
+
+    free (p_dep);
+}
+
+/* Longest prefix match route of an address, excluding the routes longer
+ * than max_prefix_len */
+static sai_fib_route_t *sai_fib_nh_resolve_lpm_get (sai_object_id_t vrf_id,
+                                                    const sai_ip_address_t *p_ip_addr,
+                                                    uint_t max_prefix_len)
+{
+    sai_fib_vrf_t       *p_vrf_node = NULL;
+    sai_fib_route_key_t  key;
+
+    p_vrf_node = sai_fib_vrf_node_get (vrf_id);
+
+    if (p_vrf_node == NULL) {
+        return NULL;
+    }
+
+    memset (&key, 0, sizeof (key));
+
+    sai_fib_ip_addr_copy (&key.prefix, (sai_ip_address_t *) p_ip_addr);
+
+    return ((sai_fib_route_t *)
+            std_radix_getbest (p_vrf_node->sai_route_tree, (uint8_t *) &key,
+                               sai_fib_route_key_len_get (max_prefix_len)));
+}
+
+static uint_t sai_fib_nh_resolve_host_len_get (const sai_ip_address_t *p_ip_addr)
+{
+    return ((p_ip_addr->addr_family == SAI_IP_ADDR_FAMILY_IPV4) ?
+            SAI_IPV4_ADDR_NUM_BYTES * BITS_PER_BYTE :
+            SAI_IPV6_ADDR_NUM_BYTES * BITS_PER_BYTE);
+}
+
+/*
+ * Route resolving an entry. A route removed without the route remove hook
+ * is not in the tree anymore and the address resolves to its longest
+ * prefix match until the entry is moved by a hook or a refresh.
+ */
+static sai_fib_route_t *sai_fib_nh_resolve_entry_route_get (
+                                          sai_fib_nh_resolve_entry_t *p_entry)
+{
+    sai_fib_nh_resolve_dep_key_t *p_dep_key = &p_entry->p_dep->key;
+    sai_fib_vrf_t                *p_vrf_node = NULL;
+    sai_fib_route_key_t           key;
+    sai_fib_route_t              *p_route = NULL;
+
+    if (!p_dep_key->is_resolved) {
+        return NULL;
+    }
+
+    p_vrf_node = sai_fib_vrf_node_get (p_dep_key->vrf_id);
+
+    if (p_vrf_node == NULL) {
+        return NULL;
+    }
+
+    memset (&key, 0, sizeof (key));
+
+    sai_fib_ip_addr_copy (&key.prefix, &p_dep_key->prefix);
+
+    p_route = (sai_fib_route_t *)
+              std_radix_getexact (p_vrf_node->sai_route_tree, (uint8_t *) &key,
+                                  sai_fib_route_key_len_get (p_dep_key->prefix_len));
+
+    if (p_route == NULL) {
+        p_route = sai_fib_nh_resolve_lpm_get (p_entry->key.vrf_id,
+                                  &p_entry->key.ip_addr,
+                                  sai_fib_nh_resolve_host_len_get (&p_entry->key.ip_addr));
+    }
+
+    return p_route;
+}
+
+static void sai_fib_nh_resolve_info_fill (sai_fib_nh_resolve_entry_t *p_entry,
+                                          sai_fib_nh_resolve_info_t *p_info)
+{
+    sai_fib_route_t *p_route = sai_fib_nh_resolve_entry_route_get (p_entry);
+
+    memset (p_info, 0, sizeof (sai_fib_nh_resolve_info_t));
+
+    p_info->vrf_id   = p_entry->key.vrf_id;
+    p_info->p_cookie = p_entry->p_cookie;
+
+    sai_fib_ip_addr_copy (&p_info->ip_addr, &p_entry->key.ip_addr);
+
+    if (p_route == NULL) {
+        return;
+    }
+
+    p_info->is_resolved   = true;
+    p_info->prefix_len    = p_route->prefix_len;
+    p_info->nh_id         = sai_fib_route_node_nh_id_get (p_route);
+    p_info->packet_action = p_route->packet_action;
+
+    sai_fib_ip_addr_copy (&p_info->prefix, &p_route->key.prefix);
+}
+
+static void sai_fib_nh_resolve_notified_set (sai_fib_nh_resolve_entry_t *p_entry,
+                                             const sai_fib_nh_resolve_info_t *p_info)
+{
+    p_entry->is_notified_resolved   = p_info->is_resolved;
+    p_entry->notified_nh_id         = p_info->nh_id;
+    p_entry->notified_packet_action = p_info->packet_action;
+}
+
+static void sai_fib_nh_resolve_pending_add (sai_fib_nh_resolve_entry_t *p_entry)
+{
+    if (p_entry->is_pending) {
+        return;
+    }
+
+    if (g_sai_fib_nh_resolve_num_pending == g_sai_fib_nh_resolve_batch_size) {
+        sai_fib_nh_resolve_notify_flush ();
+    }
+
+    p_entry->is_pending = true;
+
+    g_sai_fib_nh_resolve_pending [g_sai_fib_nh_resolve_num_pending++] = p_entry;
+}
+
+static void sai_fib_nh_resolve_pending_remove (sai_fib_nh_resolve_entry_t *p_entry)
+{
+    uint_t index;
+
+    if (!p_entry->is_pending) {
+        return;
+    }
+
+    for (index = 0; index < g_sai_fib_nh_resolve_num_pending; index++) {
+
+        if (g_sai_fib_nh_resolve_pending [index] == p_entry) {
+            g_sai_fib_nh_resolve_pending [index] =
+                g_sai_fib_nh_resolve_pending [--g_sai_fib_nh_resolve_num_pending];
+            break;
+        }
+    }
+
+    p_entry->is_pending = false;
+}
+
+/* Move an entry to the dependency list of a route and queue the change */
+static sai_status_t sai_fib_nh_resolve_entry_move (sai_fib_nh_resolve_entry_t *p_entry,
+                                                   sai_fib_nh_resolve_dep_t *p_new_dep)
+{
+    sai_fib_nh_resolve_dep_t *p_old_dep = p_entry->p_dep;
+
+    if (p_old_dep == p_new_dep) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if (p_old_dep) {
+        std_dll_remove (&p_old_dep->entry_list, &p_entry->dep_glue);
+    }
+
+    std_dll_insertatback (&p_new_dep->entry_list, &p_entry->dep_glue);
+    p_entry->p_dep = p_new_dep;
+
+    sai_fib_nh_resolve_pending_add (p_entry);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Move the dependents of a route that are covered by the filter route, or
+ * all the dependents if there is no filter route */
+static void sai_fib_nh_resolve_dep_move (sai_fib_nh_resolve_dep_t *p_from_dep,
+                                         sai_fib_route_t *p_to_route,
+                                         const sai_fib_route_t *p_filter_route)
+{
+    sai_fib_nh_resolve_dep_t   *p_to_dep = NULL;
+    sai_fib_nh_resolve_entry_t *p_entry = NULL;
+    std_dll                    *p_glue = NULL;
+    std_dll                    *p_next_glue = NULL;
+
+    if (p_from_dep == NULL) {
+        return;
+    }
+
+    for (p_glue = std_dll_getfirst (&p_from_dep->entry_list); p_glue != NULL;
+         p_glue = p_next_glue) {
+
+        p_next_glue = std_dll_getnext (&p_from_dep->entry_list, p_glue);
+        p_entry = (sai_fib_nh_resolve_entry_t *) p_glue;
+
+        if ((p_filter_route) &&
+            ((p_entry->key.ip_addr.addr_family !=
+              p_filter_route->key.prefix.addr_family) ||
+             (!sai_fib_ip_prefix_contains (&p_filter_route->key.prefix,
+                                           p_filter_route->prefix_len,
+                                           &p_entry->key.ip_addr)))) {
+            continue;
+        }
+
+        if (p_to_dep == NULL) {
+            p_to_dep = sai_fib_nh_resolve_dep_get (p_from_dep->key.vrf_id,
+                                                   p_to_route, true);
+
+            if (p_to_dep == NULL) {
+                SAI_ROUTE_LOG_ERR ("Failed to allocate the dependency list of "
+                                   "route %p, VRF 0x%"PRIx64".", p_to_route,
+                                   p_from_dep->key.vrf_id);
+                return;
+            }
+        }
+
+        sai_fib_nh_resolve_entry_move (p_entry, p_to_dep);
+    }
+
+    sai_fib_nh_resolve_dep_free_if_empty (p_from_dep);
+}
+
+static sai_fib_route_t *sai_fib_nh_resolve_less_specific_get (sai_fib_route_t *p_route)
+{
+    if (p_route->prefix_len == 0) {
+        return NULL;
+    }
+
+    return sai_fib_nh_resolve_lpm_get (p_route->vrf_id, &p_route->key.prefix,
+                                       p_route->prefix_len - 1);
+}
+
+static void sai_fib_nh_resolve_entry_free (sai_fib_nh_resolve_entry_t *p_entry)
+{
+    sai_fib_nh_resolve_dep_t *p_dep = p_entry->p_dep;
+
+    sai_fib_nh_resolve_pending_remove (p_entry);
+
+    if (p_dep) {
+        std_dll_remove (&p_dep->entry_list, &p_entry->dep_glue);
+        sai_fib_nh_resolve_dep_free_if_empty (p_dep);
+    }
+
+    std_rbtree_remove (g_sai_fib_nh_resolve_entry_tree, p_entry);
+
+    free (p_entry);
+}
+
+/***************************************************************************
+ *                          Public Functions
+ ***************************************************************************/
+sai_status_t sai_fib_nh_resolve_init (sai_fib_nh_resolve_notify_fn notify_fn,
+                                      uint_t batch_size)
+{
+    if (sai_fib_nh_resolve_is_init ()) {
+        return SAI_STATUS_ITEM_ALREADY_EXISTS;
+    }
+
+    if (batch_size == 0) {
+        batch_size = SAI_FIB_NH_RESOLVE_DFLT_BATCH_SIZE;
+    }
+
+    do {
+        g_sai_fib_nh_resolve_entry_tree =
+            std_rbtree_create_simple ("SAI FIB NH resolve entry tree",
+                           STD_STR_OFFSET_OF (sai_fib_nh_resolve_entry_t, key),
+                           STD_STR_SIZE_OF (sai_fib_nh_resolve_entry_t, key));
+
+        g_sai_fib_nh_resolve_dep_tree =
+            std_rbtree_create_simple ("SAI FIB NH resolve dependency tree",
+                           STD_STR_OFFSET_OF (sai_fib_nh_resolve_dep_t, key),
+                           STD_STR_SIZE_OF (sai_fib_nh_resolve_dep_t, key));
+
+        g_sai_fib_nh_resolve_pending = (sai_fib_nh_resolve_entry_t **)
+            calloc (batch_size, sizeof (sai_fib_nh_resolve_entry_t *));
+
+        g_sai_fib_nh_resolve_info_list = (sai_fib_nh_resolve_info_t *)
+            calloc (batch_size, sizeof (sai_fib_nh_resolve_info_t));
+
+        if ((g_sai_fib_nh_resolve_entry_tree == NULL) ||
+            (g_sai_fib_nh_resolve_dep_tree == NULL) ||
+            (g_sai_fib_nh_resolve_pending == NULL) ||
+            (g_sai_fib_nh_resolve_info_list == NULL)) {
+            break;
+        }
+
+        g_sai_fib_nh_resolve_notify_fn = notify_fn;
+        g_sai_fib_nh_resolve_batch_size = batch_size;
+        g_sai_fib_nh_resolve_num_pending = 0;
+
+        return SAI_STATUS_SUCCESS;
+
+    } while (0);
+
+    SAI_ROUTER_LOG_CRIT ("Failed to allocate the next hop resolution data.");
+
+    sai_fib_nh_resolve_deinit ();
+
+    return SAI_STATUS_NO_MEMORY;
+}
+
+void sai_fib_nh_resolve_deinit (void)
+{
+    sai_fib_nh_resolve_entry_t *p_entry = NULL;
+    sai_fib_nh_resolve_dep_t   *p_dep = NULL;
+
+    if (g_sai_fib_nh_resolve_entry_tree) {
+        while ((p_entry = std_rbtree_getfirst (g_sai_fib_nh_resolve_entry_tree))) {
+            std_rbtree_remove (g_sai_fib_nh_resolve_entry_tree, p_entry);
+            free (p_entry);
+        }
+
+        std_rbtree_destroy (g_sai_fib_nh_resolve_entry_tree);
+    }
+
+    if (g_sai_fib_nh_resolve_dep_tree) {
+        while ((p_dep = std_rbtree_getfirst (g_sai_fib_nh_resolve_dep_tree))) {
+            std_rbtree_remove (g_sai_fib_nh_resolve_dep_tree, p_dep);
+            free (p_dep);
+        }
+
+        std_rbtree_destroy (g_sai_fib_nh_resolve_dep_tree);
+    }
+
+    free (g_sai_fib_nh_resolve_pending);
+    free (g_sai_fib_nh_resolve_info_list);
+
+    g_sai_fib_nh_resolve_entry_tree  = NULL;
+    g_sai_fib_nh_resolve_dep_tree    = NULL;
+    g_sai_fib_nh_resolve_pending     = NULL;
+    g_sai_fib_nh_resolve_info_list   = NULL;
+    g_sai_fib_nh_resolve_notify_fn   = NULL;
+    g_sai_fib_nh_resolve_num_pending = 0;
+    g_sai_fib_nh_resolve_batch_size  = 0;
+}
+
+sai_status_t sai_fib_nh_resolve_register (sai_object_id_t vrf_id,
+                                          const sai_ip_address_t *p_ip_addr,
+                                          void *p_cookie,
+                                          sai_fib_nh_resolve_info_t *p_info)
+{
+    sai_fib_nh_resolve_entry_t *p_entry = NULL;
+    sai_fib_nh_resolve_dep_t   *p_dep = NULL;
+    sai_fib_nh_resolve_info_t   info;
+    sai_fib_route_t            *p_route = NULL;
+
+    if (!sai_fib_nh_resolve_is_init ()) {
+        return SAI_STATUS_UNINITIALIZED;
+    }
+
+    if ((p_ip_addr == NULL) ||
+        ((p_ip_addr->addr_family != SAI_IP_ADDR_FAMILY_IPV4) &&
+         (p_ip_addr->addr_family != SAI_IP_ADDR_FAMILY_IPV6))) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (sai_fib_vrf_node_get (vrf_id) == NULL) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    p_entry = sai_fib_nh_resolve_entry_get (vrf_id, p_ip_addr);
+
+    if (p_entry) {
+        p_entry->ref_count++;
+
+        if (p_info) {
+            sai_fib_nh_resolve_info_fill (p_entry, p_info);
+        }
+
+        return SAI_STATUS_SUCCESS;
+    }
+
+    p_entry = (sai_fib_nh_resolve_entry_t *)
+              calloc (1, sizeof (sai_fib_nh_resolve_entry_t));
+
+    if (p_entry == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sai_fib_nh_resolve_entry_key_set (&p_entry->key, vrf_id, p_ip_addr);
+
+    p_entry->ref_count = 1;
+    p_entry->p_cookie  = p_cookie;
+
+    p_route = sai_fib_nh_resolve_lpm_get (vrf_id, p_ip_addr,
+                                          sai_fib_nh_resolve_host_len_get (p_ip_addr));
+
+    p_dep = sai_fib_nh_resolve_dep_get (vrf_id, p_route, true);
+
+    if ((p_dep == NULL) ||
+        (std_rbtree_insert (g_sai_fib_nh_resolve_entry_tree, p_entry) != STD_ERR_OK)) {
+
+        sai_fib_nh_resolve_dep_free_if_empty (p_dep);
+        free (p_entry);
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    std_dll_insertatback (&p_dep->entry_list, &p_entry->dep_glue);
+    p_entry->p_dep = p_dep;
+
+    /* Current resolution is returned, not notified */
+    sai_fib_nh_resolve_info_fill (p_entry, &info);
+    sai_fib_nh_resolve_notified_set (p_entry, &info);
+
+    if (p_info) {
+        *p_info = info;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_fib_nh_resolve_unregister (sai_object_id_t vrf_id,
+                                            const sai_ip_address_t *p_ip_addr)
+{
+    sai_fib_nh_resolve_entry_t *p_entry = NULL;
+
+    if (!sai_fib_nh_resolve_is_init ()) {
+        return SAI_STATUS_UNINITIALIZED;
+    }
+
+    if (p_ip_addr == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    p_entry = sai_fib_nh_resolve_entry_get (vrf_id, p_ip_addr);
+
+    if (p_entry == NULL) {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    if (--p_entry->ref_count == 0) {
+        sai_fib_nh_resolve_entry_free (p_entry);
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_fib_nh_resolve_info_get (sai_object_id_t vrf_id,
+                                          const sai_ip_address_t *p_ip_addr,
+                                          sai_fib_nh_resolve_info_t *p_info)
+{
+    sai_fib_nh_resolve_entry_t *p_entry = NULL;
+
+    if (!sai_fib_nh_resolve_is_init ()) {
+        return SAI_STATUS_UNINITIALIZED;
+    }
+
+    if ((p_ip_addr == NULL) || (p_info == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    p_entry = sai_fib_nh_resolve_entry_get (vrf_id, p_ip_addr);
+
+    if (p_entry == NULL) {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    sai_fib_nh_resolve_info_fill (p_entry, p_info);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_fib_nh_resolve_route_add (sai_fib_route_t *p_route)
+{
+    sai_fib_route_t *p_parent = NULL;
+
+    if ((!sai_fib_nh_resolve_is_init ()) || (p_route == NULL)) {
+        return;
+    }
+
+    /* Only the dependents of the less specific route can now resolve to
+     * the new route */
+    p_parent = sai_fib_nh_resolve_less_specific_get (p_route);
+
+    sai_fib_nh_resolve_dep_move (sai_fib_nh_resolve_dep_get (p_route->vrf_id,
+                                                             p_parent, false),
+                                 p_route, p_route);
+}
+
+void sai_fib_nh_resolve_route_remove (sai_fib_route_t *p_route)
+{
+    sai_fib_route_t *p_parent = NULL;
+
+    if ((!sai_fib_nh_resolve_is_init ()) || (p_route == NULL)) {
+        return;
+    }
+
+    p_parent = sai_fib_nh_resolve_less_specific_get (p_route);
+
+    sai_fib_nh_resolve_dep_move (sai_fib_nh_resolve_dep_get (p_route->vrf_id,
+                                                             p_route, false),
+                                 p_parent, NULL);
+}
+
+void sai_fib_nh_resolve_route_update (sai_fib_route_t *p_route)
+{
+    sai_fib_nh_resolve_dep_t *p_dep = NULL;
+    std_dll                  *p_glue = NULL;
+
+    if ((!sai_fib_nh_resolve_is_init ()) || (p_route == NULL)) {
+        return;
+    }
+
+    p_dep = sai_fib_nh_resolve_dep_get (p_route->vrf_id, p_route, false);
+
+    if (p_dep == NULL) {
+        return;
+    }
+
+    for (p_glue = std_dll_getfirst (&p_dep->entry_list); p_glue != NULL;
+         p_glue = std_dll_getnext (&p_dep->entry_list, p_glue)) {
+        sai_fib_nh_resolve_pending_add ((sai_fib_nh_resolve_entry_t *) p_glue);
+    }
+}
+
+void sai_fib_nh_resolve_refresh_all (void)
+{
+    sai_fib_nh_resolve_entry_t *p_entry = NULL;
+    sai_fib_nh_resolve_dep_t   *p_old_dep = NULL;
+    sai_fib_nh_resolve_dep_t   *p_dep = NULL;
+    sai_fib_route_t            *p_route = NULL;
+
+    if (!sai_fib_nh_resolve_is_init ()) {
+        return;
+    }
+
+    for (p_entry = std_rbtree_getfirst (g_sai_fib_nh_resolve_entry_tree);
+         p_entry != NULL;
+         p_entry = std_rbtree_getnext (g_sai_fib_nh_resolve_entry_tree, p_entry)) {
+
+        p_route = sai_fib_nh_resolve_lpm_get (p_entry->key.vrf_id,
+                                  &p_entry->key.ip_addr,
+                                  sai_fib_nh_resolve_host_len_get (&p_entry->key.ip_addr));
+
+        p_old_dep = p_entry->p_dep;
+        p_dep = sai_fib_nh_resolve_dep_get (p_entry->key.vrf_id, p_route, true);
+
+        if (p_dep == NULL) {
+            SAI_ROUTE_LOG_ERR ("Failed to allocate the dependency list of "
+                               "route %p, VRF 0x%"PRIx64".", p_route,
+                               p_entry->key.vrf_id);
+            continue;
+        }
+
+        sai_fib_nh_resolve_entry_move (p_entry, p_dep);
+
+        /* Route may have been updated in place */
+        sai_fib_nh_resolve_pending_add (p_entry);
+
+        if (p_old_dep != p_dep) {
+            sai_fib_nh_resolve_dep_free_if_empty (p_old_dep);
+        }
+    }
+}
+
+void sai_fib_nh_resolve_notify_flush (void)
+{
+    sai_fib_nh_resolve_entry_t *p_entry = NULL;
+    sai_fib_nh_resolve_info_t  *p_info = NULL;
+    uint_t                      index;
+    uint_t                      count = 0;
+
+    for (index = 0; index < g_sai_fib_nh_resolve_num_pending; index++) {
+
+        p_entry = g_sai_fib_nh_resolve_pending [index];
+        p_entry->is_pending = false;
+
+        p_info = &g_sai_fib_nh_resolve_info_list [count];
+
+        sai_fib_nh_resolve_info_fill (p_entry, p_info);
+
+        /* Changes reverted before the flush are not notified */
+        if ((p_info->is_resolved == p_entry->is_notified_resolved) &&
+            ((!p_info->is_resolved) ||
+             ((p_info->nh_id == p_entry->notified_nh_id) &&
+              (p_info->packet_action == p_entry->notified_packet_action)))) {
+            continue;
+        }
+
+        sai_fib_nh_resolve_notified_set (p_entry, p_info);
+        count++;
+    }
+
+    g_sai_fib_nh_resolve_num_pending = 0;
+
+    if ((count) && (g_sai_fib_nh_resolve_notify_fn)) {
+        g_sai_fib_nh_resolve_notify_fn (g_sai_fib_nh_resolve_info_list, count);
+    }
+
+    SAI_ROUTE_LOG_TRACE ("Notified %d next hop resolution changes.", count);
+}
+
+uint_t sai_fib_nh_resolve_count_get (uint_t *p_unresolved_count)
+{
+    sai_fib_nh_resolve_entry_t *p_entry = NULL;
+    uint_t                      count = 0;
+    uint_t                      unresolved_count = 0;
+
+    if (sai_fib_nh_resolve_is_init ()) {
+
+        for (p_entry = std_rbtree_getfirst (g_sai_fib_nh_resolve_entry_tree);
+             p_entry != NULL;
+             p_entry = std_rbtree_getnext (g_sai_fib_nh_resolve_entry_tree, p_entry)) {
+
+            count++;
+
+            if (sai_fib_nh_resolve_entry_route_get (p_entry) == NULL) {
+                unresolved_count++;
+            }
+        }
+    }
+
+    if (p_unresolved_count) {
+        *p_unresolved_count = unresolved_count;
+    }
+
+    return count;
+}
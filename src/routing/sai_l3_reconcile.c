@@ -0,0 +1,1118 @@
+/************************************************************************
+* LEGALESE:   "Copyright (c) 2015, Dell Inc. All rights reserved."
+*
+* This source code is confidential, proprietary, and contains trade
+* secrets that are the sole property of Dell Inc.
+* Copy and/or distribution of this source code or disassembly or reverse
+* engineering of the resultant object code are strictly forbidden without
+* the written consent of Dell Inc.
+*
+************************************************************************/
+/**
+* @file sai_l3_reconcile.c
+*
+* @brief This file contains the reconciliation functions of the SAI L3
+*        software FIB with the NPU.
+*
+*************************************************************************/
+
+#include "sai_l3_reconcile.h"
+#include "sai_l3_ip_prefix.h"
+#include "sai_l3_util.h"
+#include "sai_l3_common.h"
+#include "sai_l3_api.h"
+#include "sai_oid_utils.h"
+#include "sairoute.h"
+#include "sainexthop.h"
+#include "sainexthopgroup.h"
+#include "saitypes.h"
+#include "saistatus.h"
+#include "std_type_defs.h"
+#include "std_rbtree.h"
+#include <string.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+/** Bitmap of the differences queued for repair in a pass */
+#define SAI_FIB_RECONCILE_REPAIR_ADD     (0x1 << SAI_FIB_RECONCILE_DIFF_ADD)
+#define SAI_FIB_RECONCILE_REPAIR_REMOVE  (0x1 << SAI_FIB_RECONCILE_DIFF_REMOVE)
+#define SAI_FIB_RECONCILE_REPAIR_MODIFY  (0x1 << SAI_FIB_RECONCILE_DIFF_MODIFY)
+
+/**
+ * @brief Repair queued in the repair batch.
+ */
+typedef struct _sai_fib_reconcile_repair_t {
+    sai_fib_reconcile_obj_t        obj_type;
+    sai_fib_reconcile_diff_type_t  diff_type;
+    sai_fib_reconcile_key_t        key;
+    void                          *p_node;
+} sai_fib_reconcile_repair_t;
+
+/**
+ * @brief Cursor on the software FIB entries of an object.
+ */
+typedef struct _sai_fib_reconcile_sw_cursor_t {
+    sai_fib_reconcile_obj_t  obj_type;
+    sai_fib_vrf_t           *p_vrf_node;
+    void                    *p_node;
+} sai_fib_reconcile_sw_cursor_t;
+
+/**
+ * @brief Window of NPU keys of an object.
+ */
+typedef struct _sai_fib_reconcile_hw_window_t {
+    sai_fib_reconcile_key_t *p_key_list;
+    uint_t                   count;
+    uint_t                   index;
+
+    /** No more keys in the NPU */
+    bool                     is_end;
+
+    /** Last key read, the next window starts after it */
+    sai_fib_reconcile_key_t  last_key;
+} sai_fib_reconcile_hw_window_t;
+
+/**
+ * @brief Reconciliation context.
+ */
+typedef struct _sai_fib_reconcile_ctx_t {
+    const sai_fib_reconcile_params_t *p_params;
+    sai_fib_reconcile_result_t       *p_result;
+    uint_t                            batch_size;
+
+    sai_fib_reconcile_hw_window_t     hw_window;
+
+    sai_fib_reconcile_repair_t       *p_repair_list;
+    uint_t                            num_repairs;
+} sai_fib_reconcile_ctx_t;
+
+/***************************************************************************
+ *                          Private Functions
+ ***************************************************************************/
+static uint_t sai_fib_reconcile_ip_addr_len_get (sai_ip_addr_family_t addr_family)
+{
+    return ((addr_family == SAI_IP_ADDR_FAMILY_IPV4) ?
+            SAI_IPV4_ADDR_NUM_BYTES : SAI_IPV6_ADDR_NUM_BYTES);
+}
+
+static bool sai_fib_reconcile_ip_addr_is_equal (const sai_ip_address_t *p_ip_1,
+                                                const sai_ip_address_t *p_ip_2)
+{
+    return ((p_ip_1->addr_family == p_ip_2->addr_family) &&
+            (!memcmp (&p_ip_1->addr, &p_ip_2->addr,
+                      sai_fib_reconcile_ip_addr_len_get (p_ip_1->addr_family))));
+}
+
+static int sai_fib_reconcile_id_cmp (const void *p_a, const void *p_b)
+{
+    sai_object_id_t id_a = *(const sai_object_id_t *) p_a;
+    sai_object_id_t id_b = *(const sai_object_id_t *) p_b;
+
+    return ((id_a > id_b) - (id_a < id_b));
+}
+
+static void sai_fib_reconcile_sw_key_get (sai_fib_reconcile_obj_t obj_type,
+                                          void *p_node,
+                                          sai_fib_reconcile_key_t *p_key)
+{
+    sai_fib_route_t *p_route = NULL;
+
+    memset (p_key, 0, sizeof (sai_fib_reconcile_key_t));
+
+    switch (obj_type) {
+
+        case SAI_FIB_RECONCILE_OBJ_NEXT_HOP:
+            p_key->next_hop_id = ((sai_fib_nh_t *) p_node)->next_hop_id;
+            break;
+
+        case SAI_FIB_RECONCILE_OBJ_NH_GROUP:
+            p_key->group_id = ((sai_fib_nh_group_t *) p_node)->key.group_id;
+            break;
+
+        case SAI_FIB_RECONCILE_OBJ_ROUTE:
+            p_route = (sai_fib_route_t *) p_node;
+
+            p_key->route.vrf_id     = p_route->vrf_id;
+            p_key->route.prefix_len = p_route->prefix_len;
+
+            sai_fib_ip_addr_copy (&p_key->route.prefix, &p_route->key.prefix);
+            sai_fib_ip_prefix_canonicalize (&p_key->route.prefix,
+                                            p_route->prefix_len);
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void *sai_fib_reconcile_sw_route_from_vrf (
+                                     sai_fib_reconcile_sw_cursor_t *p_cursor)
+{
+    sai_fib_global_t *p_fib_global = sai_fib_access_global_config ();
+    sai_fib_route_t  *p_route = NULL;
+
+    while (p_cursor->p_vrf_node) {
+
+        p_route = sai_fib_route_get_first (p_cursor->p_vrf_node);
+
+        if (p_route) {
+            return p_route;
+        }
+
+        p_cursor->p_vrf_node = std_rbtree_getnext (p_fib_global->vrf_tree,
+                                                   p_cursor->p_vrf_node);
+    }
+
+    return NULL;
+}
+
+static void *sai_fib_reconcile_sw_first (sai_fib_reconcile_sw_cursor_t *p_cursor,
+                                         sai_fib_reconcile_obj_t obj_type)
+{
+    sai_fib_global_t *p_fib_global = sai_fib_access_global_config ();
+
+    memset (p_cursor, 0, sizeof (sai_fib_reconcile_sw_cursor_t));
+
+    p_cursor->obj_type = obj_type;
+
+    switch (obj_type) {
+
+        case SAI_FIB_RECONCILE_OBJ_NEXT_HOP:
+            p_cursor->p_node = std_rbtree_getfirst (p_fib_global->nh_id_tree);
+            break;
+
+        case SAI_FIB_RECONCILE_OBJ_NH_GROUP:
+            p_cursor->p_node = std_rbtree_getfirst (p_fib_global->nh_group_tree);
+            break;
+
+        case SAI_FIB_RECONCILE_OBJ_ROUTE:
+            p_cursor->p_vrf_node = std_rbtree_getfirst (p_fib_global->vrf_tree);
+            p_cursor->p_node = sai_fib_reconcile_sw_route_from_vrf (p_cursor);
+            break;
+
+        default:
+            break;
+    }
+
+    return p_cursor->p_node;
+}
+
+static void *sai_fib_reconcile_sw_next (sai_fib_reconcile_sw_cursor_t *p_cursor)
+{
+    sai_fib_global_t *p_fib_global = sai_fib_access_global_config ();
+
+    switch (p_cursor->obj_type) {
+
+        case SAI_FIB_RECONCILE_OBJ_NEXT_HOP:
+            p_cursor->p_node = std_rbtree_getnext (p_fib_global->nh_id_tree,
+                                                   p_cursor->p_node);
+            break;
+
+        case SAI_FIB_RECONCILE_OBJ_NH_GROUP:
+            p_cursor->p_node = std_rbtree_getnext (p_fib_global->nh_group_tree,
+                                                   p_cursor->p_node);
+            break;
+
+        case SAI_FIB_RECONCILE_OBJ_ROUTE:
+            p_cursor->p_node = sai_fib_route_get_next (p_cursor->p_vrf_node,
+                                       (sai_fib_route_t *) p_cursor->p_node);
+
+            if (p_cursor->p_node == NULL) {
+                p_cursor->p_vrf_node = std_rbtree_getnext (p_fib_global->vrf_tree,
+                                                           p_cursor->p_vrf_node);
+                p_cursor->p_node = sai_fib_reconcile_sw_route_from_vrf (p_cursor);
+            }
+            break;
+
+        default:
+            p_cursor->p_node = NULL;
+            break;
+    }
+
+    return p_cursor->p_node;
+}
+
+static sai_status_t sai_fib_reconcile_hw_window_fill (sai_fib_reconcile_ctx_t *p_ctx,
+                                                      sai_fib_reconcile_obj_t obj_type,
+                                                      bool is_first)
+{
+    sai_fib_reconcile_hw_window_t *p_window = &p_ctx->hw_window;
+    sai_status_t                   status;
+
+    p_window->count = 0;
+    p_window->index = 0;
+
+    if (p_window->is_end) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    status = p_ctx->p_params->hw_keys_get (obj_type,
+                                           (is_first) ? NULL : &p_window->last_key,
+                                           p_ctx->batch_size,
+                                           p_window->p_key_list,
+                                           &p_window->count);
+
+    if (status != SAI_STATUS_SUCCESS) {
+        SAI_ROUTER_LOG_ERR ("Failed to read NPU keys of object %d, status: %d.",
+                            obj_type, status);
+
+        return status;
+    }
+
+    if ((p_window->count == 0) || (p_window->count > p_ctx->batch_size)) {
+        p_window->count = 0;
+        p_window->is_end = true;
+    } else {
+        p_window->last_key = p_window->p_key_list [p_window->count - 1];
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static const sai_fib_reconcile_key_t *sai_fib_reconcile_hw_key_get (
+                                         sai_fib_reconcile_ctx_t *p_ctx)
+{
+    sai_fib_reconcile_hw_window_t *p_window = &p_ctx->hw_window;
+
+    return ((p_window->index < p_window->count) ?
+            &p_window->p_key_list [p_window->index] : NULL);
+}
+
+static sai_status_t sai_fib_reconcile_hw_key_next (sai_fib_reconcile_ctx_t *p_ctx,
+                                                   sai_fib_reconcile_obj_t obj_type)
+{
+    sai_fib_reconcile_hw_window_t *p_window = &p_ctx->hw_window;
+
+    p_window->index++;
+
+    if (p_window->index < p_window->count) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    return sai_fib_reconcile_hw_window_fill (p_ctx, obj_type, false);
+}
+
+/* Software group members, each next hop repeated as per its weight */
+static uint_t sai_fib_reconcile_group_sw_members_get (sai_fib_nh_group_t *p_group,
+                                                      sai_fib_nh_t **ap_next_hop,
+                                                      uint_t max_count)
+{
+    sai_fib_wt_link_node_t *p_link = NULL;
+    uint_t                  count = 0;
+    uint_t                  weight;
+
+    for (p_link = sai_fib_get_first_nh_from_nh_group (p_group); p_link != NULL;
+         p_link = sai_fib_get_next_nh_from_nh_group (p_group, p_link)) {
+
+        for (weight = 0; weight < p_link->weight; weight++) {
+
+            if ((ap_next_hop) && (count < max_count)) {
+                ap_next_hop [count] =
+                    sai_fib_get_nh_from_dll_link_node (&p_link->link_node);
+            }
+
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/* Read back the sorted member Ids of a group in NPU. Caller frees the list */
+static sai_status_t sai_fib_reconcile_group_hw_members_get (
+                                     sai_fib_reconcile_ctx_t *p_ctx,
+                                     sai_fib_nh_group_t *p_group,
+                                     sai_object_id_t **pp_id_list,
+                                     uint_t *p_count)
+{
+    sai_attribute_t  attr;
+    sai_object_id_t *p_id_list = NULL;
+    uint_t           max_count = p_group->nh_count + 1;
+    sai_status_t     status;
+
+    do {
+        free (p_id_list);
+
+        p_id_list = (sai_object_id_t *) calloc (max_count,
+                                                sizeof (sai_object_id_t));
+
+        if (p_id_list == NULL) {
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        memset (&attr, 0, sizeof (attr));
+
+        attr.id = SAI_NEXT_HOP_GROUP_ATTR_NEXT_HOP_LIST;
+        attr.value.objlist.count = max_count;
+        attr.value.objlist.list = p_id_list;
+
+        status = p_ctx->p_params->p_nh_group_api->nh_group_attr_get (p_group, 1,
+                                                                     &attr);
+
+        /* Retry once with the size returned by the NPU */
+        if ((status == SAI_STATUS_BUFFER_OVERFLOW) &&
+            (attr.value.objlist.count > max_count)) {
+            max_count = attr.value.objlist.count;
+            continue;
+        }
+
+        break;
+
+    } while (1);
+
+    if ((status != SAI_STATUS_SUCCESS) || (attr.value.objlist.count > max_count)) {
+        free (p_id_list);
+
+        return ((status != SAI_STATUS_SUCCESS) ? status : SAI_STATUS_FAILURE);
+    }
+
+    qsort (p_id_list, attr.value.objlist.count, sizeof (sai_object_id_t),
+           sai_fib_reconcile_id_cmp);
+
+    *pp_id_list = p_id_list;
+    *p_count = attr.value.objlist.count;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_object_id_t *sai_fib_reconcile_group_sw_member_ids_get (
+                                               sai_fib_nh_group_t *p_group,
+                                               uint_t *p_count)
+{
+    sai_fib_nh_t   **ap_next_hop = NULL;
+    sai_object_id_t *p_id_list = NULL;
+    uint_t           count;
+    uint_t           index;
+
+    count = sai_fib_reconcile_group_sw_members_get (p_group, NULL, 0);
+
+    ap_next_hop = (sai_fib_nh_t **) calloc (count + 1, sizeof (sai_fib_nh_t *));
+    p_id_list = (sai_object_id_t *) calloc (count + 1, sizeof (sai_object_id_t));
+
+    if ((ap_next_hop == NULL) || (p_id_list == NULL)) {
+        free (ap_next_hop);
+        free (p_id_list);
+
+        return NULL;
+    }
+
+    sai_fib_reconcile_group_sw_members_get (p_group, ap_next_hop, count);
+
+    for (index = 0; index < count; index++) {
+        p_id_list [index] = ap_next_hop [index]->next_hop_id;
+    }
+
+    free (ap_next_hop);
+
+    qsort (p_id_list, count, sizeof (sai_object_id_t), sai_fib_reconcile_id_cmp);
+
+    *p_count = count;
+
+    return p_id_list;
+}
+
+static bool sai_fib_reconcile_nh_is_modified (sai_fib_reconcile_ctx_t *p_ctx,
+                                              sai_fib_nh_t *p_next_hop)
+{
+    sai_attribute_t attr_list [3];
+
+    if ((p_ctx->p_params->p_nexthop_api == NULL) ||
+        (p_ctx->p_params->p_nexthop_api->nexthop_attribute_get == NULL)) {
+        return false;
+    }
+
+    memset (attr_list, 0, sizeof (attr_list));
+
+    attr_list [0].id = SAI_NEXT_HOP_ATTR_TYPE;
+    attr_list [1].id = SAI_NEXT_HOP_ATTR_IP;
+    attr_list [2].id = SAI_NEXT_HOP_ATTR_ROUTER_INTERFACE_ID;
+
+    if (p_ctx->p_params->p_nexthop_api->nexthop_attribute_get (p_next_hop, 3,
+                                                               attr_list) !=
+        SAI_STATUS_SUCCESS) {
+        return true;
+    }
+
+    return ((attr_list [0].value.s32 != (int32_t) p_next_hop->key.nh_type) ||
+            (!sai_fib_reconcile_ip_addr_is_equal (&attr_list [1].value.ipaddr,
+                                         &p_next_hop->key.info.ip_nh.ip_addr)) ||
+            (attr_list [2].value.oid != p_next_hop->key.rif_id));
+}
+
+static bool sai_fib_reconcile_group_is_modified (sai_fib_reconcile_ctx_t *p_ctx,
+                                                 sai_fib_nh_group_t *p_group)
+{
+    sai_attribute_t  attr;
+    sai_object_id_t *p_hw_id_list = NULL;
+    sai_object_id_t *p_sw_id_list = NULL;
+    uint_t           hw_count = 0;
+    uint_t           sw_count = 0;
+    bool             is_modified = true;
+
+    if ((p_ctx->p_params->p_nh_group_api == NULL) ||
+        (p_ctx->p_params->p_nh_group_api->nh_group_attr_get == NULL)) {
+        return false;
+    }
+
+    memset (&attr, 0, sizeof (attr));
+
+    attr.id = SAI_NEXT_HOP_GROUP_ATTR_TYPE;
+
+    if ((p_ctx->p_params->p_nh_group_api->nh_group_attr_get (p_group, 1,
+                                                             &attr) !=
+         SAI_STATUS_SUCCESS) ||
+        (attr.value.s32 != (int32_t) p_group->type)) {
+        return true;
+    }
+
+    if (sai_fib_reconcile_group_hw_members_get (p_ctx, p_group, &p_hw_id_list,
+                                                &hw_count) != SAI_STATUS_SUCCESS) {
+        return true;
+    }
+
+    p_sw_id_list = sai_fib_reconcile_group_sw_member_ids_get (p_group,
+                                                              &sw_count);
+
+    if ((p_sw_id_list) && (sw_count == hw_count) &&
+        (!memcmp (p_sw_id_list, p_hw_id_list,
+                  sw_count * sizeof (sai_object_id_t)))) {
+        is_modified = false;
+    }
+
+    free (p_hw_id_list);
+    free (p_sw_id_list);
+
+    return is_modified;
+}
+
+static bool sai_fib_reconcile_route_is_modified (sai_fib_reconcile_ctx_t *p_ctx,
+                                                 sai_fib_route_t *p_route)
+{
+    sai_attribute_t attr_list [3];
+
+    if ((p_ctx->p_params->p_route_api == NULL) ||
+        (p_ctx->p_params->p_route_api->route_attr_get == NULL)) {
+        return false;
+    }
+
+    memset (attr_list, 0, sizeof (attr_list));
+
+    attr_list [0].id = SAI_ROUTE_ATTR_PACKET_ACTION;
+    attr_list [1].id = SAI_ROUTE_ATTR_NEXT_HOP_ID;
+    attr_list [2].id = SAI_ROUTE_ATTR_META_DATA;
+
+    if (p_ctx->p_params->p_route_api->route_attr_get (p_route, 3, attr_list) !=
+        SAI_STATUS_SUCCESS) {
+        return true;
+    }
+
+    return ((attr_list [0].value.s32 != (int32_t) p_route->packet_action) ||
+            (attr_list [1].value.oid != sai_fib_route_node_nh_id_get (p_route)) ||
+            (attr_list [2].value.u32 != p_route->meta_data));
+}
+
+static bool sai_fib_reconcile_is_modified (sai_fib_reconcile_ctx_t *p_ctx,
+                                           sai_fib_reconcile_obj_t obj_type,
+                                           void *p_node)
+{
+    switch (obj_type) {
+
+        case SAI_FIB_RECONCILE_OBJ_NEXT_HOP:
+            return sai_fib_reconcile_nh_is_modified (p_ctx, p_node);
+
+        case SAI_FIB_RECONCILE_OBJ_NH_GROUP:
+            return sai_fib_reconcile_group_is_modified (p_ctx, p_node);
+
+        case SAI_FIB_RECONCILE_OBJ_ROUTE:
+            return sai_fib_reconcile_route_is_modified (p_ctx, p_node);
+
+        default:
+            return false;
+    }
+}
+
+static sai_status_t sai_fib_reconcile_nh_repair (sai_fib_reconcile_ctx_t *p_ctx,
+                                                 sai_fib_reconcile_repair_t *p_repair)
+{
+    const sai_npu_nexthop_api_t *p_nexthop_api = p_ctx->p_params->p_nexthop_api;
+    sai_fib_nh_t                 next_hop;
+    sai_fib_nh_t                *p_next_hop = p_repair->p_node;
+    sai_npu_object_id_t          npu_id = 0;
+    sai_status_t                 status = SAI_STATUS_NOT_SUPPORTED;
+
+    if (p_repair->diff_type == SAI_FIB_RECONCILE_DIFF_ADD) {
+
+        status = p_nexthop_api->nexthop_create (p_next_hop, &npu_id);
+
+        /* Next hop Id is known to the SAI user and can not change, so the
+         * NPU object created with a different Id is removed */
+        if ((status == SAI_STATUS_SUCCESS) &&
+            (npu_id != sai_uoid_npu_obj_id_get (p_next_hop->next_hop_id))) {
+
+            SAI_NEXTHOP_LOG_ERR ("Next hop 0x%"PRIx64" recreated in NPU with "
+                                 "a different Id 0x%"PRIx64", removing it.",
+                                 p_next_hop->next_hop_id, npu_id);
+
+            memset (&next_hop, 0, sizeof (next_hop));
+
+            next_hop.next_hop_id = sai_uoid_create (SAI_OBJECT_TYPE_NEXT_HOP,
+                                                    npu_id);
+
+            if (p_nexthop_api->nexthop_remove (&next_hop) != SAI_STATUS_SUCCESS) {
+                SAI_NEXTHOP_LOG_ERR ("Failed to remove Next hop Id 0x%"PRIx64
+                                     " from NPU.", next_hop.next_hop_id);
+            }
+
+            status = SAI_STATUS_FAILURE;
+        }
+
+    } else if (p_repair->diff_type == SAI_FIB_RECONCILE_DIFF_REMOVE) {
+
+        memset (&next_hop, 0, sizeof (next_hop));
+
+        next_hop.next_hop_id = p_repair->key.next_hop_id;
+
+        status = p_nexthop_api->nexthop_remove (&next_hop);
+    }
+
+    return status;
+}
+
+static sai_status_t sai_fib_reconcile_group_members_repair (
+                                         sai_fib_reconcile_ctx_t *p_ctx,
+                                         sai_fib_nh_group_t *p_group)
+{
+    const sai_npu_nh_group_api_t *p_nh_group_api = p_ctx->p_params->p_nh_group_api;
+    sai_fib_nh_t                **ap_sw_next_hop = NULL;
+    sai_fib_nh_t                **ap_next_hop = NULL;
+    sai_fib_nh_t                 *p_stale_list = NULL;
+    sai_object_id_t              *p_hw_id_list = NULL;
+    sai_fib_nh_t                 *p_next_hop = NULL;
+    uint_t                        hw_count = 0;
+    uint_t                        sw_count;
+    uint_t                        count = 0;
+    uint_t                        index;
+    uint_t                        hw_index;
+    sai_status_t                  status;
+
+    status = sai_fib_reconcile_group_hw_members_get (p_ctx, p_group,
+                                                     &p_hw_id_list, &hw_count);
+
+    if (status != SAI_STATUS_SUCCESS) {
+        return status;
+    }
+
+    sw_count = sai_fib_reconcile_group_sw_members_get (p_group, NULL, 0);
+
+    ap_sw_next_hop = (sai_fib_nh_t **) calloc (sw_count + 1,
+                                               sizeof (sai_fib_nh_t *));
+    ap_next_hop = (sai_fib_nh_t **) calloc (sw_count + hw_count + 1,
+                                            sizeof (sai_fib_nh_t *));
+    p_stale_list = (sai_fib_nh_t *) calloc (hw_count + 1, sizeof (sai_fib_nh_t));
+
+    do {
+        if ((ap_sw_next_hop == NULL) || (ap_next_hop == NULL) ||
+            (p_stale_list == NULL)) {
+            status = SAI_STATUS_NO_MEMORY;
+            break;
+        }
+
+        sai_fib_reconcile_group_sw_members_get (p_group, ap_sw_next_hop,
+                                                sw_count);
+
+        /* Members missing in NPU. A matched NPU member is consumed by
+         * clearing its Id, software next hop Ids are never 0 */
+        for (index = 0; index < sw_count; index++) {
+
+            for (hw_index = 0; hw_index < hw_count; hw_index++) {
+                if (p_hw_id_list [hw_index] ==
+                    ap_sw_next_hop [index]->next_hop_id) {
+                    p_hw_id_list [hw_index] = SAI_NULL_OBJECT_ID;
+                    break;
+                }
+            }
+
+            if (hw_index == hw_count) {
+                ap_next_hop [count++] = ap_sw_next_hop [index];
+            }
+        }
+
+        if (count) {
+            status = p_nh_group_api->add_nh_to_group (p_group, count,
+                                                      ap_next_hop);
+
+            if (status != SAI_STATUS_SUCCESS) {
+                break;
+            }
+        }
+
+        /* Stale members left in NPU */
+        count = 0;
+
+        for (hw_index = 0; hw_index < hw_count; hw_index++) {
+
+            if (p_hw_id_list [hw_index] == SAI_NULL_OBJECT_ID) {
+                continue;
+            }
+
+            p_next_hop = sai_fib_next_hop_node_get_from_id (
+                                                  p_hw_id_list [hw_index]);
+
+            if (p_next_hop == NULL) {
+                p_next_hop = &p_stale_list [hw_index];
+                p_next_hop->next_hop_id = p_hw_id_list [hw_index];
+            }
+
+            ap_next_hop [count++] = p_next_hop;
+        }
+
+        if (count) {
+            status = p_nh_group_api->remove_nh_from_group (p_group, count,
+                                                           ap_next_hop);
+        }
+
+    } while (0);
+
+    free (p_hw_id_list);
+    free (ap_sw_next_hop);
+    free (ap_next_hop);
+    free (p_stale_list);
+
+    return status;
+}
+
+static sai_status_t sai_fib_reconcile_group_repair (
+                                     sai_fib_reconcile_ctx_t *p_ctx,
+                                     sai_fib_reconcile_repair_t *p_repair)
+{
+    const sai_npu_nh_group_api_t *p_nh_group_api = p_ctx->p_params->p_nh_group_api;
+    sai_fib_nh_group_t            group;
+    sai_fib_nh_group_t           *p_group = p_repair->p_node;
+    sai_fib_nh_t                **ap_next_hop = NULL;
+    sai_npu_object_id_t           npu_id = 0;
+    sai_object_id_t               group_id;
+    uint_t                        count;
+    sai_status_t                  status = SAI_STATUS_NOT_SUPPORTED;
+
+    switch (p_repair->diff_type) {
+
+        case SAI_FIB_RECONCILE_DIFF_ADD:
+            count = sai_fib_reconcile_group_sw_members_get (p_group, NULL, 0);
+
+            ap_next_hop = (sai_fib_nh_t **) calloc (count + 1,
+                                                    sizeof (sai_fib_nh_t *));
+
+            if (ap_next_hop == NULL) {
+                status = SAI_STATUS_NO_MEMORY;
+                break;
+            }
+
+            sai_fib_reconcile_group_sw_members_get (p_group, ap_next_hop, count);
+
+            status = p_nh_group_api->nh_group_create (p_group, count,
+                                                      ap_next_hop, &npu_id);
+
+            free (ap_next_hop);
+
+            if ((status == SAI_STATUS_SUCCESS) &&
+                (npu_id != sai_uoid_npu_obj_id_get (p_group->key.group_id))) {
+
+                group_id = p_group->key.group_id;
+
+                SAI_NH_GROUP_LOG_ERR ("Group 0x%"PRIx64" recreated in NPU with "
+                                      "a different Id 0x%"PRIx64", removing it.",
+                                      group_id, npu_id);
+
+                /* Group node is switched to the NPU Id for the removal, the
+                 * NPU removes the members from the node member list */
+                p_group->key.group_id =
+                    sai_uoid_create (SAI_OBJECT_TYPE_NEXT_HOP_GROUP, npu_id);
+
+                if (p_nh_group_api->nh_group_remove (p_group) !=
+                    SAI_STATUS_SUCCESS) {
+                    SAI_NH_GROUP_LOG_ERR ("Failed to remove Group Id 0x%"PRIx64
+                                          " from NPU.", p_group->key.group_id);
+                }
+
+                p_group->key.group_id = group_id;
+
+                status = SAI_STATUS_FAILURE;
+            }
+            break;
+
+        case SAI_FIB_RECONCILE_DIFF_REMOVE:
+            memset (&group, 0, sizeof (group));
+
+            group.key.group_id = p_repair->key.group_id;
+            std_dll_init (&group.nh_list);
+
+            status = p_nh_group_api->nh_group_remove (&group);
+            break;
+
+        case SAI_FIB_RECONCILE_DIFF_MODIFY:
+            status = sai_fib_reconcile_group_members_repair (p_ctx, p_group);
+            break;
+
+        default:
+            break;
+    }
+
+    return status;
+}
+
+static sai_status_t sai_fib_reconcile_route_repair (
+                                     sai_fib_reconcile_ctx_t *p_ctx,
+                                     sai_fib_reconcile_repair_t *p_repair)
+{
+    const sai_npu_route_api_t *p_route_api = p_ctx->p_params->p_route_api;
+    sai_fib_route_t            route;
+    sai_fib_route_t           *p_route = p_repair->p_node;
+    sai_status_t               status = SAI_STATUS_NOT_SUPPORTED;
+
+    switch (p_repair->diff_type) {
+
+        case SAI_FIB_RECONCILE_DIFF_ADD:
+            status = p_route_api->route_create (p_route);
+            break;
+
+        case SAI_FIB_RECONCILE_DIFF_REMOVE:
+            memset (&route, 0, sizeof (route));
+
+            route.vrf_id     = p_repair->key.route.vrf_id;
+            route.prefix_len = p_repair->key.route.prefix_len;
+
+            sai_fib_ip_addr_copy (&route.key.prefix, &p_repair->key.route.prefix);
+
+            status = p_route_api->route_remove (&route);
+            break;
+
+        case SAI_FIB_RECONCILE_DIFF_MODIFY:
+            /* NPU API has no route attribute set, so the route is removed
+             * and created again. Traffic to the prefix falls to the next
+             * less specific route, or is dropped, until the create is done */
+            SAI_ROUTE_LOG_INFO ("Route VRF 0x%"PRIx64" prefix len %d "
+                                "reprogrammed, traffic is hit.",
+                                p_route->vrf_id, p_route->prefix_len);
+
+            status = p_route_api->route_remove (p_route);
+
+            if (status == SAI_STATUS_SUCCESS) {
+                status = p_route_api->route_create (p_route);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return status;
+}
+
+static void sai_fib_reconcile_repair_flush (sai_fib_reconcile_ctx_t *p_ctx)
+{
+    sai_fib_reconcile_repair_t *p_repair = NULL;
+    uint_t                      index;
+    sai_status_t                status;
+
+    for (index = 0; index < p_ctx->num_repairs; index++) {
+
+        p_repair = &p_ctx->p_repair_list [index];
+
+        switch (p_repair->obj_type) {
+
+            case SAI_FIB_RECONCILE_OBJ_NEXT_HOP:
+                status = sai_fib_reconcile_nh_repair (p_ctx, p_repair);
+                break;
+
+            case SAI_FIB_RECONCILE_OBJ_NH_GROUP:
+                status = sai_fib_reconcile_group_repair (p_ctx, p_repair);
+                break;
+
+            case SAI_FIB_RECONCILE_OBJ_ROUTE:
+                status = sai_fib_reconcile_route_repair (p_ctx, p_repair);
+                break;
+
+            default:
+                status = SAI_STATUS_FAILURE;
+                break;
+        }
+
+        if (status == SAI_STATUS_SUCCESS) {
+            p_ctx->p_result->repair_count [p_repair->obj_type]
+                                          [p_repair->diff_type]++;
+        } else {
+            SAI_ROUTER_LOG_ERR ("Failed to repair object %d, difference %d, "
+                                "status: %d.", p_repair->obj_type,
+                                p_repair->diff_type, status);
+
+            p_ctx->p_result->repair_fail_count [p_repair->obj_type]
+                                               [p_repair->diff_type]++;
+        }
+    }
+
+    p_ctx->num_repairs = 0;
+}
+
+static void sai_fib_reconcile_diff_handle (sai_fib_reconcile_ctx_t *p_ctx,
+                                           sai_fib_reconcile_obj_t obj_type,
+                                           sai_fib_reconcile_diff_type_t diff_type,
+                                           const sai_fib_reconcile_key_t *p_key,
+                                           void *p_node, bool report,
+                                           uint_t repair_mask)
+{
+    sai_fib_reconcile_diff_t    diff;
+    sai_fib_reconcile_repair_t *p_repair = NULL;
+
+    if (report) {
+        p_ctx->p_result->diff_count [obj_type][diff_type]++;
+
+        if (p_ctx->p_params->diff_fn) {
+            diff.obj_type  = obj_type;
+            diff.diff_type = diff_type;
+            diff.key       = *p_key;
+            diff.p_node    = p_node;
+
+            p_ctx->p_params->diff_fn (&diff, p_ctx->p_params->p_cookie);
+        }
+    }
+
+    if (!(repair_mask & (0x1 << diff_type))) {
+        return;
+    }
+
+    p_repair = &p_ctx->p_repair_list [p_ctx->num_repairs++];
+
+    p_repair->obj_type  = obj_type;
+    p_repair->diff_type = diff_type;
+    p_repair->key       = *p_key;
+    p_repair->p_node    = p_node;
+
+    if (p_ctx->num_repairs == p_ctx->batch_size) {
+        sai_fib_reconcile_repair_flush (p_ctx);
+    }
+}
+
+/* Merge the software FIB and NPU entries of an object */
+static sai_status_t sai_fib_reconcile_obj_run (sai_fib_reconcile_ctx_t *p_ctx,
+                                               sai_fib_reconcile_obj_t obj_type,
+                                               bool report, uint_t repair_mask)
+{
+    sai_fib_reconcile_sw_cursor_t  sw_cursor;
+    sai_fib_reconcile_key_t        sw_key;
+    const sai_fib_reconcile_key_t *p_hw_key = NULL;
+    void                          *p_node = NULL;
+    bool                           check_modify;
+    int                            cmp;
+    sai_status_t                   status;
+
+    check_modify = (report || (repair_mask & SAI_FIB_RECONCILE_REPAIR_MODIFY));
+
+    memset (&p_ctx->hw_window.last_key, 0, sizeof (sai_fib_reconcile_key_t));
+    p_ctx->hw_window.is_end = false;
+
+    status = sai_fib_reconcile_hw_window_fill (p_ctx, obj_type, true);
+
+    if (status != SAI_STATUS_SUCCESS) {
+        return status;
+    }
+
+    p_node = sai_fib_reconcile_sw_first (&sw_cursor, obj_type);
+    p_hw_key = sai_fib_reconcile_hw_key_get (p_ctx);
+
+    while ((p_node) || (p_hw_key)) {
+
+        if (p_node) {
+            sai_fib_reconcile_sw_key_get (obj_type, p_node, &sw_key);
+        }
+
+        if (p_node == NULL) {
+            cmp = 1;
+        } else if (p_hw_key == NULL) {
+            cmp = -1;
+        } else {
+            cmp = sai_fib_reconcile_key_compare (obj_type, &sw_key, p_hw_key);
+        }
+
+        if (cmp < 0) {
+            sai_fib_reconcile_diff_handle (p_ctx, obj_type,
+                                           SAI_FIB_RECONCILE_DIFF_ADD, &sw_key,
+                                           p_node, report, repair_mask);
+        } else if (cmp > 0) {
+            sai_fib_reconcile_diff_handle (p_ctx, obj_type,
+                                           SAI_FIB_RECONCILE_DIFF_REMOVE,
+                                           p_hw_key, NULL, report, repair_mask);
+        } else if ((check_modify) &&
+                   (sai_fib_reconcile_is_modified (p_ctx, obj_type, p_node))) {
+            sai_fib_reconcile_diff_handle (p_ctx, obj_type,
+                                           SAI_FIB_RECONCILE_DIFF_MODIFY, &sw_key,
+                                           p_node, report, repair_mask);
+        }
+
+        if (cmp <= 0) {
+            p_node = sai_fib_reconcile_sw_next (&sw_cursor);
+        }
+
+        if (cmp >= 0) {
+            status = sai_fib_reconcile_hw_key_next (p_ctx, obj_type);
+
+            if (status != SAI_STATUS_SUCCESS) {
+                return status;
+            }
+
+            p_hw_key = sai_fib_reconcile_hw_key_get (p_ctx);
+        }
+    }
+
+    sai_fib_reconcile_repair_flush (p_ctx);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static bool sai_fib_reconcile_params_validate (
+                                   const sai_fib_reconcile_params_t *p_params)
+{
+    if (p_params->hw_keys_get == NULL) {
+        return false;
+    }
+
+    if (!p_params->repair) {
+        return true;
+    }
+
+    return ((p_params->p_nexthop_api) && (p_params->p_nh_group_api) &&
+            (p_params->p_route_api));
+}
+
+/***************************************************************************
+ *                          Public Functions
+ ***************************************************************************/
+int sai_fib_reconcile_key_compare (sai_fib_reconcile_obj_t obj_type,
+                                   const sai_fib_reconcile_key_t *p_key_1,
+                                   const sai_fib_reconcile_key_t *p_key_2)
+{
+    const sai_fib_reconcile_route_key_t *p_route_1 = &p_key_1->route;
+    const sai_fib_reconcile_route_key_t *p_route_2 = &p_key_2->route;
+    int                                  cmp;
+
+    /* FIB rbtrees compare the key bytes */
+    if (obj_type != SAI_FIB_RECONCILE_OBJ_ROUTE) {
+        return (memcmp (&p_key_1->next_hop_id, &p_key_2->next_hop_id,
+                        sizeof (sai_object_id_t)));
+    }
+
+    cmp = memcmp (&p_route_1->vrf_id, &p_route_2->vrf_id,
+                  sizeof (sai_object_id_t));
+
+    if (cmp) {
+        return cmp;
+    }
+
+    /* Order of the VRF route tree, for prefixes with the host bits cleared */
+    cmp = memcmp (&p_route_1->prefix.addr_family, &p_route_2->prefix.addr_family,
+                  sizeof (p_route_1->prefix.addr_family));
+
+    if (cmp) {
+        return cmp;
+    }
+
+    cmp = memcmp (&p_route_1->prefix.addr, &p_route_2->prefix.addr,
+                  sai_fib_reconcile_ip_addr_len_get (p_route_1->prefix.addr_family));
+
+    if (cmp) {
+        return cmp;
+    }
+
+    return ((p_route_1->prefix_len > p_route_2->prefix_len) -
+            (p_route_1->prefix_len < p_route_2->prefix_len));
+}
+
+sai_status_t sai_fib_reconcile_run (const sai_fib_reconcile_params_t *p_params,
+                                    sai_fib_reconcile_result_t *p_result)
+{
+    sai_fib_reconcile_ctx_t ctx;
+    sai_status_t            status;
+    uint_t                  repair_mask;
+
+    if ((p_params == NULL) || (p_result == NULL) ||
+        (!sai_fib_reconcile_params_validate (p_params))) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    memset (p_result, 0, sizeof (sai_fib_reconcile_result_t));
+    memset (&ctx, 0, sizeof (ctx));
+
+    ctx.p_params   = p_params;
+    ctx.p_result   = p_result;
+    ctx.batch_size = (p_params->batch_size) ? p_params->batch_size :
+                     SAI_FIB_RECONCILE_DFLT_BATCH_SIZE;
+
+    ctx.hw_window.p_key_list = (sai_fib_reconcile_key_t *)
+                               calloc (ctx.batch_size,
+                                       sizeof (sai_fib_reconcile_key_t));
+    ctx.p_repair_list = (sai_fib_reconcile_repair_t *)
+                        calloc (ctx.batch_size,
+                                sizeof (sai_fib_reconcile_repair_t));
+
+    if ((ctx.hw_window.p_key_list == NULL) || (ctx.p_repair_list == NULL)) {
+        free (ctx.hw_window.p_key_list);
+        free (ctx.p_repair_list);
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    repair_mask = (p_params->repair) ?
+                  (SAI_FIB_RECONCILE_REPAIR_ADD | SAI_FIB_RECONCILE_REPAIR_MODIFY |
+                   SAI_FIB_RECONCILE_REPAIR_REMOVE) : 0;
+
+    /* Next hops and groups are created before the routes using them and
+     * removed after the routes, in separate passes */
+    do {
+        status = sai_fib_reconcile_obj_run (&ctx, SAI_FIB_RECONCILE_OBJ_NEXT_HOP,
+                                            true, repair_mask &
+                                            SAI_FIB_RECONCILE_REPAIR_ADD);
+
+        if (status != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        status = sai_fib_reconcile_obj_run (&ctx, SAI_FIB_RECONCILE_OBJ_NH_GROUP,
+                                            true, repair_mask &
+                                            (SAI_FIB_RECONCILE_REPAIR_ADD |
+                                             SAI_FIB_RECONCILE_REPAIR_MODIFY));
+
+        if (status != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        status = sai_fib_reconcile_obj_run (&ctx, SAI_FIB_RECONCILE_OBJ_ROUTE,
+                                            true, repair_mask);
+
+        if ((status != SAI_STATUS_SUCCESS) || (!p_params->repair)) {
+            break;
+        }
+
+        status = sai_fib_reconcile_obj_run (&ctx, SAI_FIB_RECONCILE_OBJ_NH_GROUP,
+                                            false, SAI_FIB_RECONCILE_REPAIR_REMOVE);
+
+        if (status != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        status = sai_fib_reconcile_obj_run (&ctx, SAI_FIB_RECONCILE_OBJ_NEXT_HOP,
+                                            false, SAI_FIB_RECONCILE_REPAIR_REMOVE);
+    } while (0);
+
+    free (ctx.hw_window.p_key_list);
+    free (ctx.p_repair_list);
+
+    SAI_ROUTER_LOG_INFO ("FIB reconciliation done, status: %d, routes add: %d, "
+                         "remove: %d, modify: %d.", status,
+                         p_result->diff_count [SAI_FIB_RECONCILE_OBJ_ROUTE]
+                                              [SAI_FIB_RECONCILE_DIFF_ADD],
+                         p_result->diff_count [SAI_FIB_RECONCILE_OBJ_ROUTE]
+                                              [SAI_FIB_RECONCILE_DIFF_REMOVE],
+                         p_result->diff_count [SAI_FIB_RECONCILE_OBJ_ROUTE]
+                                              [SAI_FIB_RECONCILE_DIFF_MODIFY]);
+
+    return status;
+}
@@ -0,0 +1,1314 @@
+/************************************************************************
+* LEGALESE:   "Copyright (c) 2015, Dell Inc. All rights reserved."
+*
+* This source code is confidential, proprietary, and contains trade
+* secrets that are the sole property of Dell Inc.
+* Copy and/or distribution of this source code or disassembly or reverse
+* engineering of the resultant object code are strictly forbidden without
+* the written consent of Dell Inc.
+*
+************************************************************************/
+/**
+* @file sai_l3_route_txn.c
+*
+* @brief This file contains the journal based transaction functions for
+*        SAI L3 Route, Next Hop and Next Hop Group changes.
+*
+*************************************************************************/
+
+#include "sai_l3_route_txn.h"
+#include "sai_l3_ip_prefix.h"
+#include "sai_l3_nh_group_bucket.h"
+#include "sai_l3_nh_resolve.h"
+#include "sai_l3_util.h"
+#include "sai_l3_common.h"
+#include "sai_l3_api.h"
+#include "sai_oid_utils.h"
+#include "saitypes.h"
+#include "saistatus.h"
+#include "std_type_defs.h"
+#include "std_llist.h"
+#include "std_rbtree.h"
+#include "std_radix.h"
+#include "std_struct_utils.h"
+#include <string.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+/**
+ * @brief Key of a staged route or next hop op. Routes are keyed on the VRF
+ * and prefix, next hop creates on the RIF and IP address and next hop
+ * removes on the node.
+ */
+typedef struct _sai_fib_route_txn_index_key_t {
+    sai_fib_route_txn_op_t  op;
+    sai_object_id_t         obj_id;
+    sai_ip_address_t        ip_addr;
+    uint_t                  prefix_len;
+    const void             *p_node;
+} sai_fib_route_txn_index_key_t;
+
+/**
+ * @brief Journal index node of a staged route or next hop op.
+ */
+typedef struct _sai_fib_route_txn_index_node_t {
+    sai_fib_route_txn_index_key_t  key;
+} sai_fib_route_txn_index_node_t;
+
+/**
+ * @brief Change of the reference count of a next hop by the staged ops.
+ */
+typedef struct _sai_fib_route_txn_nh_ref_node_t {
+    sai_fib_nh_t  *p_next_hop;
+    int            ref_delta;
+} sai_fib_route_txn_nh_ref_node_t;
+
+/***************************************************************************
+ *                          Private Functions
+ ***************************************************************************/
+static sai_status_t sai_fib_route_txn_entry_alloc (
+                                        sai_fib_route_txn_t *p_txn,
+                                        sai_fib_route_txn_op_t op,
+                                        sai_fib_route_txn_entry_t **pp_entry)
+{
+    sai_fib_route_txn_entry_t *p_journal = NULL;
+    uint_t                     max_entries;
+
+    if (p_txn->state != SAI_FIB_ROUTE_TXN_STATE_OPEN) {
+        SAI_ROUTE_LOG_ERR ("Transaction %p is not open, state: %d.",
+                           p_txn, p_txn->state);
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    if (p_txn->num_entries == p_txn->max_entries) {
+
+        max_entries = (p_txn->max_entries) ?
+            (p_txn->max_entries * 2) : SAI_FIB_ROUTE_TXN_DFLT_JOURNAL_SIZE;
+
+        p_journal = (sai_fib_route_txn_entry_t *)
+            realloc (p_txn->p_journal,
+                     max_entries * sizeof (sai_fib_route_txn_entry_t));
+
+        if (p_journal == NULL) {
+            SAI_ROUTE_LOG_CRIT ("Failed to grow transaction journal to %d "
+                                "entries.", max_entries);
+
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        p_txn->p_journal   = p_journal;
+        p_txn->max_entries = max_entries;
+    }
+
+    *pp_entry = &p_txn->p_journal [p_txn->num_entries];
+
+    memset (*pp_entry, 0, sizeof (sai_fib_route_txn_entry_t));
+    (*pp_entry)->op = op;
+
+    p_txn->num_entries++;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static void sai_fib_route_txn_entry_link_free (sai_fib_route_txn_entry_t *p_entry)
+{
+    if (p_entry->p_nh_link) {
+        free (p_entry->p_nh_link);
+        p_entry->p_nh_link = NULL;
+    }
+
+    if (p_entry->p_group_link) {
+        free (p_entry->p_group_link);
+        p_entry->p_group_link = NULL;
+    }
+}
+
+static bool sai_fib_route_txn_is_member_op (sai_fib_route_txn_op_t op)
+{
+    return ((op == SAI_FIB_ROUTE_TXN_OP_NH_GROUP_MEMBER_ADD) ||
+            (op == SAI_FIB_ROUTE_TXN_OP_NH_GROUP_MEMBER_REMOVE));
+}
+
+static void sai_fib_route_txn_index_key_set (sai_fib_route_txn_index_key_t *p_key,
+                                             sai_fib_route_txn_op_t op,
+                                             const void *p_node)
+{
+    const sai_fib_route_t *p_route = p_node;
+    const sai_fib_nh_t    *p_next_hop = p_node;
+
+    /* Key is compared as a byte string */
+    memset (p_key, 0, sizeof (sai_fib_route_txn_index_key_t));
+
+    p_key->op = op;
+
+    switch (op) {
+
+        case SAI_FIB_ROUTE_TXN_OP_ROUTE_CREATE:
+        case SAI_FIB_ROUTE_TXN_OP_ROUTE_REMOVE:
+            p_key->obj_id     = p_route->vrf_id;
+            p_key->prefix_len = p_route->prefix_len;
+
+            sai_fib_ip_addr_copy (&p_key->ip_addr, &p_route->key.prefix);
+            break;
+
+        case SAI_FIB_ROUTE_TXN_OP_NEXT_HOP_CREATE:
+            p_key->obj_id = p_next_hop->key.rif_id;
+
+            sai_fib_ip_addr_copy (&p_key->ip_addr,
+                                  sai_fib_next_hop_ip_addr ((sai_fib_nh_t *) p_next_hop));
+            break;
+
+        default:
+            p_key->p_node = p_node;
+            break;
+    }
+}
+
+/* Check if an op on the same route key or next hop is in the journal */
+static bool sai_fib_route_txn_entry_is_staged (sai_fib_route_txn_t *p_txn,
+                                               sai_fib_route_txn_op_t op,
+                                               const void *p_node)
+{
+    sai_fib_route_txn_index_node_t index_node;
+
+    sai_fib_route_txn_index_key_set (&index_node.key, op, p_node);
+
+    return (std_rbtree_getexact (p_txn->entry_index_tree, &index_node) != NULL);
+}
+
+/* Next hop whose reference count is changed by a journal entry */
+static int sai_fib_route_txn_entry_nh_ref_delta_get (
+                                        const sai_fib_route_txn_entry_t *p_entry,
+                                        sai_fib_nh_t **pp_next_hop)
+{
+    switch (p_entry->op) {
+
+        case SAI_FIB_ROUTE_TXN_OP_ROUTE_CREATE:
+        case SAI_FIB_ROUTE_TXN_OP_ROUTE_REMOVE:
+            if ((p_entry->obj.p_route->nh_type != SAI_OBJECT_TYPE_NEXT_HOP) ||
+                (p_entry->obj.p_route->nh_info.nh_node == NULL)) {
+                return 0;
+            }
+
+            *pp_next_hop = p_entry->obj.p_route->nh_info.nh_node;
+
+            return ((p_entry->op == SAI_FIB_ROUTE_TXN_OP_ROUTE_CREATE) ? 1 : -1);
+
+        case SAI_FIB_ROUTE_TXN_OP_NH_GROUP_MEMBER_ADD:
+        case SAI_FIB_ROUTE_TXN_OP_NH_GROUP_MEMBER_REMOVE:
+            *pp_next_hop = p_entry->obj.member.p_next_hop;
+
+            return ((p_entry->op == SAI_FIB_ROUTE_TXN_OP_NH_GROUP_MEMBER_ADD) ?
+                    1 : -1);
+
+        default:
+            return 0;
+    }
+}
+
+static sai_status_t sai_fib_route_txn_nh_ref_update (sai_fib_route_txn_t *p_txn,
+                                                     sai_fib_nh_t *p_next_hop,
+                                                     int ref_delta)
+{
+    sai_fib_route_txn_nh_ref_node_t  ref_node;
+    sai_fib_route_txn_nh_ref_node_t *p_ref_node = NULL;
+
+    memset (&ref_node, 0, sizeof (ref_node));
+    ref_node.p_next_hop = p_next_hop;
+
+    p_ref_node = (sai_fib_route_txn_nh_ref_node_t *)
+                 std_rbtree_getexact (p_txn->nh_ref_tree, &ref_node);
+
+    if (p_ref_node == NULL) {
+        p_ref_node = (sai_fib_route_txn_nh_ref_node_t *)
+                     calloc (1, sizeof (sai_fib_route_txn_nh_ref_node_t));
+
+        if (p_ref_node == NULL) {
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        p_ref_node->p_next_hop = p_next_hop;
+
+        if (std_rbtree_insert (p_txn->nh_ref_tree, p_ref_node) != STD_ERR_OK) {
+            free (p_ref_node);
+
+            return SAI_STATUS_NO_MEMORY;
+        }
+    }
+
+    p_ref_node->ref_delta += ref_delta;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Index a staged journal entry and count its next hop reference */
+static sai_status_t sai_fib_route_txn_entry_track (sai_fib_route_txn_t *p_txn,
+                                                   sai_fib_route_txn_entry_t *p_entry)
+{
+    sai_fib_route_txn_index_node_t *p_index_node = NULL;
+    sai_fib_nh_t                   *p_next_hop = NULL;
+    int                             ref_delta;
+
+    if (!sai_fib_route_txn_is_member_op (p_entry->op)) {
+
+        p_index_node = (sai_fib_route_txn_index_node_t *)
+                       calloc (1, sizeof (sai_fib_route_txn_index_node_t));
+
+        if (p_index_node == NULL) {
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        sai_fib_route_txn_index_key_set (&p_index_node->key, p_entry->op,
+                                         p_entry->obj.p_route);
+
+        if (std_rbtree_insert (p_txn->entry_index_tree, p_index_node) !=
+            STD_ERR_OK) {
+            free (p_index_node);
+
+            return SAI_STATUS_NO_MEMORY;
+        }
+    }
+
+    ref_delta = sai_fib_route_txn_entry_nh_ref_delta_get (p_entry, &p_next_hop);
+
+    if ((ref_delta) &&
+        (sai_fib_route_txn_nh_ref_update (p_txn, p_next_hop, ref_delta) !=
+         SAI_STATUS_SUCCESS)) {
+
+        if (p_index_node) {
+            std_rbtree_remove (p_txn->entry_index_tree, p_index_node);
+            free (p_index_node);
+        }
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static void sai_fib_route_txn_entry_untrack (sai_fib_route_txn_t *p_txn,
+                                             sai_fib_route_txn_entry_t *p_entry)
+{
+    sai_fib_route_txn_index_node_t  index_node;
+    sai_fib_route_txn_index_node_t *p_index_node = NULL;
+    sai_fib_nh_t                   *p_next_hop = NULL;
+    int                             ref_delta;
+
+    if (!sai_fib_route_txn_is_member_op (p_entry->op)) {
+
+        sai_fib_route_txn_index_key_set (&index_node.key, p_entry->op,
+                                         p_entry->obj.p_route);
+
+        p_index_node = (sai_fib_route_txn_index_node_t *)
+                       std_rbtree_getexact (p_txn->entry_index_tree, &index_node);
+
+        if (p_index_node) {
+            std_rbtree_remove (p_txn->entry_index_tree, p_index_node);
+            free (p_index_node);
+        }
+    }
+
+    ref_delta = sai_fib_route_txn_entry_nh_ref_delta_get (p_entry, &p_next_hop);
+
+    /* Node of the next hop exists, the update does not allocate */
+    if (ref_delta) {
+        sai_fib_route_txn_nh_ref_update (p_txn, p_next_hop, -ref_delta);
+    }
+}
+
+/* Stage an entry allocated by sai_fib_route_txn_entry_alloc, the entry is
+ * dropped if it can not be tracked */
+static sai_status_t sai_fib_route_txn_entry_stage (sai_fib_route_txn_t *p_txn,
+                                                   sai_fib_route_txn_entry_t *p_entry)
+{
+    if (sai_fib_route_txn_entry_track (p_txn, p_entry) != SAI_STATUS_SUCCESS) {
+        SAI_ROUTE_LOG_CRIT ("Failed to index transaction %p entry, op: %d.",
+                            p_txn, p_entry->op);
+
+        sai_fib_route_txn_entry_link_free (p_entry);
+        p_txn->num_entries--;
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static void sai_fib_route_txn_index_free (sai_fib_route_txn_t *p_txn)
+{
+    void *p_node = NULL;
+
+    if (p_txn->entry_index_tree) {
+        while ((p_node = std_rbtree_getfirst (p_txn->entry_index_tree))) {
+            std_rbtree_remove (p_txn->entry_index_tree, p_node);
+            free (p_node);
+        }
+
+        std_rbtree_destroy (p_txn->entry_index_tree);
+        p_txn->entry_index_tree = NULL;
+    }
+
+    if (p_txn->nh_ref_tree) {
+        while ((p_node = std_rbtree_getfirst (p_txn->nh_ref_tree))) {
+            std_rbtree_remove (p_txn->nh_ref_tree, p_node);
+            free (p_node);
+        }
+
+        std_rbtree_destroy (p_txn->nh_ref_tree);
+        p_txn->nh_ref_tree = NULL;
+    }
+}
+
+/* Route and group member references of a next hop once the journal is
+ * applied. Group members are counted in the next hop ref_count, as done by
+ * the member link on commit */
+static int sai_fib_route_txn_nh_ref_count_get (sai_fib_route_txn_t *p_txn,
+                                               sai_fib_nh_t *p_next_hop)
+{
+    sai_fib_route_txn_nh_ref_node_t  ref_node;
+    sai_fib_route_txn_nh_ref_node_t *p_ref_node = NULL;
+    int                              ref_count = p_next_hop->ref_count;
+
+    memset (&ref_node, 0, sizeof (ref_node));
+    ref_node.p_next_hop = p_next_hop;
+
+    p_ref_node = (sai_fib_route_txn_nh_ref_node_t *)
+                 std_rbtree_getexact (p_txn->nh_ref_tree, &ref_node);
+
+    if (p_ref_node) {
+        ref_count += p_ref_node->ref_delta;
+    }
+
+    return ref_count;
+}
+
+static sai_status_t sai_fib_route_txn_member_stage (
+                                                sai_fib_route_txn_t *p_txn,
+                                                sai_fib_route_txn_op_t op,
+                                                sai_fib_nh_group_t *p_group,
+                                                uint_t next_hop_count,
+                                                sai_fib_nh_t *ap_next_hop [])
+{
+    sai_fib_route_txn_entry_t *p_entry = NULL;
+    sai_status_t               sai_rc = SAI_STATUS_SUCCESS;
+    uint_t                     num_entries;
+    uint_t                     index;
+
+    if ((p_group == NULL) || (next_hop_count == 0) || (ap_next_hop == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    num_entries = p_txn->num_entries;
+
+    for (index = 0; index < next_hop_count; index++) {
+
+        if (ap_next_hop [index] == NULL) {
+            sai_rc = SAI_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        /* Next hop staged for removal can not be added back */
+        if ((op == SAI_FIB_ROUTE_TXN_OP_NH_GROUP_MEMBER_ADD) &&
+            (sai_fib_route_txn_entry_is_staged (p_txn,
+                                                SAI_FIB_ROUTE_TXN_OP_NEXT_HOP_REMOVE,
+                                                ap_next_hop [index]))) {
+            SAI_NH_GROUP_LOG_ERR ("Next Hop 0x%"PRIx64" is staged for removal, "
+                                  "can not add it to NH Group 0x%"PRIx64".",
+                                  ap_next_hop [index]->next_hop_id,
+                                  p_group->key.group_id);
+
+            sai_rc = SAI_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        sai_rc = sai_fib_route_txn_entry_alloc (p_txn, op, &p_entry);
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        p_entry->obj.member.p_group    = p_group;
+        p_entry->obj.member.p_next_hop = ap_next_hop [index];
+
+        sai_rc = sai_fib_route_txn_entry_stage (p_txn, p_entry);
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        if (op != SAI_FIB_ROUTE_TXN_OP_NH_GROUP_MEMBER_ADD) {
+            continue;
+        }
+
+        p_entry->p_nh_link = (sai_fib_wt_link_node_t *)
+            calloc (1, sizeof (sai_fib_wt_link_node_t));
+        p_entry->p_group_link = (sai_fib_wt_link_node_t *)
+            calloc (1, sizeof (sai_fib_wt_link_node_t));
+
+        if ((p_entry->p_nh_link == NULL) || (p_entry->p_group_link == NULL)) {
+            SAI_NH_GROUP_LOG_CRIT ("Failed to allocate link nodes for NH "
+                                   "Group 0x%"PRIx64".", p_group->key.group_id);
+
+            sai_rc = SAI_STATUS_NO_MEMORY;
+            break;
+        }
+    }
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+
+        /* Unstage all the members of this call */
+        while (p_txn->num_entries > num_entries) {
+            p_txn->num_entries--;
+            sai_fib_route_txn_entry_untrack (p_txn,
+                               &p_txn->p_journal [p_txn->num_entries]);
+            sai_fib_route_txn_entry_link_free (
+                               &p_txn->p_journal [p_txn->num_entries]);
+        }
+    }
+
+    return sai_rc;
+}
+
+static uint_t sai_fib_route_txn_member_batch_get (sai_fib_route_txn_t *p_txn,
+                                                  uint_t start_index,
+                                                  sai_fib_nh_t *ap_next_hop [])
+{
+    sai_fib_route_txn_entry_t *p_first = &p_txn->p_journal [start_index];
+    sai_fib_route_txn_entry_t *p_entry = NULL;
+    uint_t                     count = 0;
+
+    while (((start_index + count) < p_txn->num_entries) &&
+           (count < SAI_FIB_ROUTE_TXN_MAX_NH_BATCH)) {
+
+        p_entry = &p_txn->p_journal [start_index + count];
+
+        if ((p_entry->op != p_first->op) ||
+            (p_entry->obj.member.p_group != p_first->obj.member.p_group)) {
+            break;
+        }
+
+        ap_next_hop [count] = p_entry->obj.member.p_next_hop;
+        count++;
+    }
+
+    return count;
+}
+
+static sai_status_t sai_fib_route_txn_entry_hw_apply (sai_fib_route_txn_t *p_txn,
+                                                      uint_t index)
+{
+    sai_fib_route_txn_entry_t *p_entry = &p_txn->p_journal [index];
+    sai_fib_nh_t              *ap_next_hop [SAI_FIB_ROUTE_TXN_MAX_NH_BATCH];
+    sai_npu_object_id_t        npu_id = 0;
+    sai_status_t               sai_rc = SAI_STATUS_FAILURE;
+    uint_t                     count = 1;
+    uint_t                     batch;
+
+    switch (p_entry->op) {
+
+        case SAI_FIB_ROUTE_TXN_OP_NEXT_HOP_CREATE:
+            sai_rc = p_txn->p_nexthop_api->nexthop_create (
+                                          p_entry->obj.p_next_hop, &npu_id);
+
+            if (sai_rc == SAI_STATUS_SUCCESS) {
+                p_entry->obj.p_next_hop->next_hop_id =
+                    sai_uoid_create (SAI_OBJECT_TYPE_NEXT_HOP, npu_id);
+            }
+            break;
+
+        case SAI_FIB_ROUTE_TXN_OP_NEXT_HOP_REMOVE:
+            sai_rc = p_txn->p_nexthop_api->nexthop_remove (
+                                          p_entry->obj.p_next_hop);
+            break;
+
+        case SAI_FIB_ROUTE_TXN_OP_NH_GROUP_MEMBER_ADD:
+            count = sai_fib_route_txn_member_batch_get (p_txn, index,
+                                                        ap_next_hop);
+
+            sai_rc = p_txn->p_nh_group_api->add_nh_to_group (
+                              p_entry->obj.member.p_group, count, ap_next_hop);
+            break;
+
+        case SAI_FIB_ROUTE_TXN_OP_NH_GROUP_MEMBER_REMOVE:
+            count = sai_fib_route_txn_member_batch_get (p_txn, index,
+                                                        ap_next_hop);
+
+            sai_rc = p_txn->p_nh_group_api->remove_nh_from_group (
+                              p_entry->obj.member.p_group, count, ap_next_hop);
+            break;
+
+        case SAI_FIB_ROUTE_TXN_OP_ROUTE_CREATE:
+            sai_rc = p_txn->p_route_api->route_create (p_entry->obj.p_route);
+            break;
+
+        case SAI_FIB_ROUTE_TXN_OP_ROUTE_REMOVE:
+            sai_rc = p_txn->p_route_api->route_remove (p_entry->obj.p_route);
+            break;
+
+        default:
+            break;
+    }
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        return sai_rc;
+    }
+
+    p_entry->hw_batch_count = count;
+
+    for (batch = 0; batch < count; batch++) {
+        p_txn->p_journal [index + batch].is_hw_done = true;
+    }
+
+    return sai_rc;
+}
+
+/* Next hop restored in NPU with a new Id. The node is not referenced by
+ * the NPU routes and groups, so it is moved to the new Id */
+static void sai_fib_route_txn_nh_id_update (sai_fib_nh_t *p_next_hop,
+                                            sai_npu_object_id_t npu_id)
+{
+    sai_fib_global_t *p_fib_global = sai_fib_access_global_config ();
+    sai_object_id_t   next_hop_id = p_next_hop->next_hop_id;
+
+    std_rbtree_remove (p_fib_global->nh_id_tree, p_next_hop);
+
+    p_next_hop->next_hop_id = sai_uoid_create (SAI_OBJECT_TYPE_NEXT_HOP,
+                                               npu_id);
+
+    std_rbtree_insert (p_fib_global->nh_id_tree, p_next_hop);
+
+    SAI_NEXTHOP_LOG_CRIT ("Next Hop 0x%"PRIx64" restored in NPU with a "
+                          "different Id, Next Hop Id is now 0x%"PRIx64". "
+                          "SAI user Id 0x%"PRIx64" is stale.", next_hop_id,
+                          p_next_hop->next_hop_id, next_hop_id);
+}
+
+static sai_status_t sai_fib_route_txn_entry_hw_revert (sai_fib_route_txn_t *p_txn,
+                                                       uint_t index)
+{
+    sai_fib_route_txn_entry_t *p_entry = &p_txn->p_journal [index];
+    sai_fib_nh_t              *ap_next_hop [SAI_FIB_ROUTE_TXN_MAX_NH_BATCH];
+    sai_npu_object_id_t        npu_id = 0;
+    sai_status_t               sai_rc = SAI_STATUS_FAILURE;
+    uint_t                     batch;
+
+    for (batch = 0; sai_fib_route_txn_is_member_op (p_entry->op) &&
+         (batch < p_entry->hw_batch_count); batch++) {
+        ap_next_hop [batch] = p_txn->p_journal [index + batch].obj.member.p_next_hop;
+    }
+
+    switch (p_entry->op) {
+
+        case SAI_FIB_ROUTE_TXN_OP_NEXT_HOP_CREATE:
+            sai_rc = p_txn->p_nexthop_api->nexthop_remove (
+                                          p_entry->obj.p_next_hop);
+            break;
+
+        case SAI_FIB_ROUTE_TXN_OP_NEXT_HOP_REMOVE:
+            sai_rc = p_txn->p_nexthop_api->nexthop_create (
+                                          p_entry->obj.p_next_hop, &npu_id);
+
+            if ((sai_rc == SAI_STATUS_SUCCESS) &&
+                (npu_id != sai_uoid_npu_obj_id_get (
+                                  p_entry->obj.p_next_hop->next_hop_id))) {
+                sai_fib_route_txn_nh_id_update (p_entry->obj.p_next_hop, npu_id);
+            }
+            break;
+
+        case SAI_FIB_ROUTE_TXN_OP_NH_GROUP_MEMBER_ADD:
+            sai_rc = p_txn->p_nh_group_api->remove_nh_from_group (
+                                          p_entry->obj.member.p_group,
+                                          p_entry->hw_batch_count, ap_next_hop);
+            break;
+
+        case SAI_FIB_ROUTE_TXN_OP_NH_GROUP_MEMBER_REMOVE:
+            sai_rc = p_txn->p_nh_group_api->add_nh_to_group (
+                                          p_entry->obj.member.p_group,
+                                          p_entry->hw_batch_count, ap_next_hop);
+            break;
+
+        case SAI_FIB_ROUTE_TXN_OP_ROUTE_CREATE:
+            sai_rc = p_txn->p_route_api->route_remove (p_entry->obj.p_route);
+            break;
+
+        case SAI_FIB_ROUTE_TXN_OP_ROUTE_REMOVE:
+            sai_rc = p_txn->p_route_api->route_create (p_entry->obj.p_route);
+            break;
+
+        default:
+            break;
+    }
+
+    return sai_rc;
+}
+
+static void sai_fib_route_txn_hw_rollback (sai_fib_route_txn_t *p_txn,
+                                           uint_t failed_index)
+{
+    sai_fib_route_txn_entry_t *p_entry = NULL;
+    sai_status_t               sai_rc;
+    uint_t                     index = failed_index;
+
+    while (index > 0) {
+        index--;
+
+        p_entry = &p_txn->p_journal [index];
+
+        /* Entries of a batch are reverted by the first entry of the batch */
+        if ((!p_entry->is_hw_done) || (p_entry->hw_batch_count == 0)) {
+            continue;
+        }
+
+        sai_rc = sai_fib_route_txn_entry_hw_revert (p_txn, index);
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            SAI_ROUTE_LOG_CRIT ("Failed to revert transaction entry %d, "
+                                "op: %d in NPU, rc: %d.", index,
+                                p_entry->op, sai_rc);
+        }
+
+        p_entry->is_hw_done = false;
+    }
+}
+
+static void sai_fib_route_txn_member_link (sai_fib_route_txn_entry_t *p_entry)
+{
+    sai_fib_nh_group_t     *p_group = p_entry->obj.member.p_group;
+    sai_fib_nh_t           *p_next_hop = p_entry->obj.member.p_next_hop;
+    sai_fib_wt_link_node_t *p_link = NULL;
+
+    p_link = sai_fib_nh_group_find_nh_link_node (p_group, p_next_hop);
+
+    if (p_link == NULL) {
+        p_link = p_entry->p_nh_link;
+        p_entry->p_nh_link = NULL;
+
+        p_link->link_node.self = p_next_hop;
+        std_dll_insertatback (&p_group->nh_list, &p_link->link_node.dll_glue);
+    }
+
+    p_link->weight++;
+
+    p_link = sai_fib_nh_find_group_link_node (p_next_hop, p_group);
+
+    if (p_link == NULL) {
+        p_link = p_entry->p_group_link;
+        p_entry->p_group_link = NULL;
+
+        p_link->link_node.self = p_group;
+        std_dll_insertatback (&p_next_hop->nh_group_list,
+                              &p_link->link_node.dll_glue);
+    }
+
+    p_link->weight++;
+
+    p_next_hop->ref_count++;
+    p_group->nh_count++;
+}
+
+static void sai_fib_route_txn_member_unlink (sai_fib_route_txn_entry_t *p_entry)
+{
+    sai_fib_nh_group_t     *p_group = p_entry->obj.member.p_group;
+    sai_fib_nh_t           *p_next_hop = p_entry->obj.member.p_next_hop;
+    sai_fib_wt_link_node_t *p_link = NULL;
+
+    p_link = sai_fib_nh_group_find_nh_link_node (p_group, p_next_hop);
+
+    if (p_link) {
+        p_link->weight--;
+
+        if (p_link->weight == 0) {
+            std_dll_remove (&p_group->nh_list, &p_link->link_node.dll_glue);
+            free (p_link);
+        }
+    }
+
+    p_link = sai_fib_nh_find_group_link_node (p_next_hop, p_group);
+
+    if (p_link) {
+        p_link->weight--;
+
+        if (p_link->weight == 0) {
+            std_dll_remove (&p_next_hop->nh_group_list,
+                            &p_link->link_node.dll_glue);
+            free (p_link);
+        }
+    }
+
+    if (p_next_hop->ref_count) {
+        p_next_hop->ref_count--;
+    }
+
+    if (p_group->nh_count) {
+        p_group->nh_count--;
+    }
+}
+
+static void sai_fib_route_txn_route_nh_ref_update (sai_fib_route_t *p_route,
+                                                   bool is_add)
+{
+    uint_t *p_ref_count = NULL;
+
+    if ((p_route->nh_type == SAI_OBJECT_TYPE_NEXT_HOP) &&
+        (p_route->nh_info.nh_node)) {
+
+        p_ref_count = &p_route->nh_info.nh_node->ref_count;
+
+    } else if ((p_route->nh_type == SAI_OBJECT_TYPE_NEXT_HOP_GROUP) &&
+               (p_route->nh_info.group_node)) {
+
+        p_ref_count = &p_route->nh_info.group_node->ref_count;
+    }
+
+    if (p_ref_count == NULL) {
+        return;
+    }
+
+    if (is_add) {
+        (*p_ref_count)++;
+    } else if (*p_ref_count) {
+        (*p_ref_count)--;
+    }
+}
+
+static void sai_fib_route_txn_entry_sw_apply (sai_fib_route_txn_entry_t *p_entry)
+{
+    sai_fib_global_t *p_fib_global = sai_fib_access_global_config ();
+    sai_fib_vrf_t    *p_vrf_node = NULL;
+    sai_fib_nh_t     *p_next_hop = NULL;
+    sai_fib_route_t  *p_route = NULL;
+
+    switch (p_entry->op) {
+
+        case SAI_FIB_ROUTE_TXN_OP_NEXT_HOP_CREATE:
+            p_next_hop = p_entry->obj.p_next_hop;
+            p_vrf_node = sai_fib_vrf_node_get (p_next_hop->vrf_id);
+
+            p_next_hop->owner_flag |= (0x1 << SAI_FIB_OWNER_NEXT_HOP);
+
+            sai_fib_nh_tree_insert (p_vrf_node, p_next_hop);
+            std_rbtree_insert (p_fib_global->nh_id_tree, p_next_hop);
+            break;
+
+        case SAI_FIB_ROUTE_TXN_OP_NEXT_HOP_REMOVE:
+            p_next_hop = p_entry->obj.p_next_hop;
+            p_vrf_node = sai_fib_vrf_node_get (p_next_hop->vrf_id);
+
+            std_rbtree_remove (p_fib_global->nh_id_tree, p_next_hop);
+
+            p_next_hop->owner_flag &= ~(0x1 << SAI_FIB_OWNER_NEXT_HOP);
+
+            /* Node stays in the NH tree while the neighbor owns it */
+            if (!sai_fib_is_owner_neighbor (p_next_hop)) {
+                sai_fib_nh_tree_remove (p_vrf_node, p_next_hop);
+            } else {
+                sai_fib_nh_mem_stats_owner_sync (p_next_hop);
+            }
+            break;
+
+        case SAI_FIB_ROUTE_TXN_OP_NH_GROUP_MEMBER_ADD:
+            sai_fib_route_txn_member_link (p_entry);
+            break;
+
+        case SAI_FIB_ROUTE_TXN_OP_NH_GROUP_MEMBER_REMOVE:
+            sai_fib_route_txn_member_unlink (p_entry);
+            break;
+
+        case SAI_FIB_ROUTE_TXN_OP_ROUTE_CREATE:
+            p_route = p_entry->obj.p_route;
+            p_vrf_node = sai_fib_vrf_node_get (p_route->vrf_id);
+
+            p_route->rt_head.rth_addr = (uint8_t *) &p_route->key;
+
+            std_radix_insert (p_vrf_node->sai_route_tree, &p_route->rt_head,
+                              sai_fib_route_key_len_get (p_route->prefix_len));
+
+            sai_fib_vrf_route_stats_update (p_vrf_node, p_route, true);
+
+            sai_fib_route_txn_route_nh_ref_update (p_route, true);
+
+            sai_fib_nh_resolve_route_add (p_route);
+            break;
+
+        case SAI_FIB_ROUTE_TXN_OP_ROUTE_REMOVE:
+            p_route = p_entry->obj.p_route;
+            p_vrf_node = sai_fib_vrf_node_get (p_route->vrf_id);
+
+            std_radix_remove (p_vrf_node->sai_route_tree, &p_route->rt_head);
+
+            sai_fib_vrf_route_stats_update (p_vrf_node, p_route, false);
+
+            sai_fib_route_txn_route_nh_ref_update (p_route, false);
+
+            sai_fib_nh_resolve_route_remove (p_route);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/* Reassign the resilient hashing buckets of the groups with member changes */
+static void sai_fib_route_txn_bucket_tables_sync (sai_fib_route_txn_t *p_txn)
+{
+    sai_fib_route_txn_entry_t *p_entry = NULL;
+    sai_fib_nh_group_t        *p_prev_group = NULL;
+    uint_t                     index;
+
+    for (index = 0; index < p_txn->num_entries; index++) {
+
+        p_entry = &p_txn->p_journal [index];
+
+        if ((!sai_fib_route_txn_is_member_op (p_entry->op)) ||
+            (p_entry->obj.member.p_group == p_prev_group) ||
+            (p_entry->obj.member.p_group->p_bucket_table == NULL)) {
+            continue;
+        }
+
+        p_prev_group = p_entry->obj.member.p_group;
+
+        if (sai_fib_nh_group_bucket_table_sync (p_prev_group,
+                                                p_txn->p_nh_group_api) !=
+            SAI_STATUS_SUCCESS) {
+            SAI_ROUTE_LOG_ERR ("Transaction %p failed to update the buckets "
+                               "of group 0x%"PRIx64".", p_txn,
+                               p_prev_group->key.group_id);
+        }
+    }
+}
+
+static void sai_fib_route_txn_node_release (sai_fib_route_txn_t *p_txn,
+                                            sai_fib_route_txn_op_t op,
+                                            void *p_node)
+{
+    if (p_txn->release_fn) {
+        p_txn->release_fn (op, p_node);
+
+    } else {
+        /* Readers hold the FIB read lock, none can reference the node while
+         * the transaction holds the FIB lock */
+        free (p_node);
+    }
+}
+
+/***************************************************************************
+ *                          Public Functions
+ ***************************************************************************/
+sai_status_t sai_fib_route_txn_begin (const sai_npu_route_api_t *p_route_api,
+                                      const sai_npu_nexthop_api_t *p_nexthop_api,
+                                      const sai_npu_nh_group_api_t *p_nh_group_api,
+                                      sai_fib_route_txn_release_fn release_fn,
+                                      sai_fib_route_txn_t **pp_txn)
+{
+    sai_fib_route_txn_t *p_txn = NULL;
+
+    if ((p_route_api == NULL) || (p_nexthop_api == NULL) ||
+        (p_nh_group_api == NULL) || (pp_txn == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    p_txn = (sai_fib_route_txn_t *) calloc (1, sizeof (sai_fib_route_txn_t));
+
+    if (p_txn == NULL) {
+        SAI_ROUTE_LOG_CRIT ("Failed to allocate route transaction.");
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    p_txn->entry_index_tree =
+        std_rbtree_create_simple ("SAI FIB route txn entry index",
+                       STD_STR_OFFSET_OF (sai_fib_route_txn_index_node_t, key),
+                       STD_STR_SIZE_OF (sai_fib_route_txn_index_node_t, key));
+
+    p_txn->nh_ref_tree =
+        std_rbtree_create_simple ("SAI FIB route txn next hop references",
+                       STD_STR_OFFSET_OF (sai_fib_route_txn_nh_ref_node_t,
+                                          p_next_hop),
+                       STD_STR_SIZE_OF (sai_fib_route_txn_nh_ref_node_t,
+                                        p_next_hop));
+
+    if ((p_txn->entry_index_tree == NULL) || (p_txn->nh_ref_tree == NULL)) {
+        SAI_ROUTE_LOG_CRIT ("Failed to allocate route transaction index.");
+
+        sai_fib_route_txn_index_free (p_txn);
+        free (p_txn);
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    p_txn->state          = SAI_FIB_ROUTE_TXN_STATE_OPEN;
+    p_txn->release_fn     = release_fn;
+    p_txn->p_route_api    = p_route_api;
+    p_txn->p_nexthop_api  = p_nexthop_api;
+    p_txn->p_nh_group_api = p_nh_group_api;
+
+    *pp_txn = p_txn;
+
+    SAI_ROUTE_LOG_TRACE ("Route transaction %p begin.", p_txn);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_fib_route_txn_route_create (sai_fib_route_txn_t *p_txn,
+                                             sai_fib_route_t *p_route)
+{
+    sai_fib_route_txn_entry_t *p_entry = NULL;
+    sai_fib_vrf_t             *p_vrf_node = NULL;
+    sai_status_t               sai_rc;
+
+    if ((p_txn == NULL) || (p_route == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    p_vrf_node = sai_fib_vrf_node_get (p_route->vrf_id);
+
+    if (p_vrf_node == NULL) {
+        SAI_ROUTE_LOG_ERR ("VRF 0x%"PRIx64" not found.", p_route->vrf_id);
+
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    if (sai_fib_ip_prefix_len_validate (p_route->key.prefix.addr_family,
+                                        p_route->prefix_len) !=
+        SAI_STATUS_SUCCESS) {
+        SAI_ROUTE_LOG_ERR ("Invalid prefix length %d for route in VRF "
+                           "0x%"PRIx64".", p_route->prefix_len, p_route->vrf_id);
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    /* Route node is stored with the host bits of the prefix cleared */
+    sai_fib_ip_prefix_canonicalize (&p_route->key.prefix, p_route->prefix_len);
+
+    if (std_radix_getexact (p_vrf_node->sai_route_tree,
+                            (uint8_t *) &p_route->key,
+                            sai_fib_route_key_len_get (p_route->prefix_len))) {
+        return SAI_STATUS_ITEM_ALREADY_EXISTS;
+    }
+
+    if (sai_fib_route_txn_entry_is_staged (p_txn, SAI_FIB_ROUTE_TXN_OP_ROUTE_CREATE,
+                                           p_route)) {
+        SAI_ROUTE_LOG_ERR ("Route in VRF 0x%"PRIx64" with prefix length %d "
+                           "is already staged for create.", p_route->vrf_id,
+                           p_route->prefix_len);
+
+        return SAI_STATUS_ITEM_ALREADY_EXISTS;
+    }
+
+    if ((p_route->nh_type == SAI_OBJECT_TYPE_NEXT_HOP) &&
+        (p_route->nh_info.nh_node) &&
+        (sai_fib_route_txn_entry_is_staged (p_txn, SAI_FIB_ROUTE_TXN_OP_NEXT_HOP_REMOVE,
+                                            p_route->nh_info.nh_node))) {
+        SAI_ROUTE_LOG_ERR ("Route next hop 0x%"PRIx64" is staged for removal.",
+                           p_route->nh_info.nh_node->next_hop_id);
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    sai_rc = sai_fib_route_txn_entry_alloc (p_txn,
+                                            SAI_FIB_ROUTE_TXN_OP_ROUTE_CREATE,
+                                            &p_entry);
+
+    if (sai_rc == SAI_STATUS_SUCCESS) {
+        p_entry->obj.p_route = p_route;
+
+        sai_rc = sai_fib_route_txn_entry_stage (p_txn, p_entry);
+    }
+
+    return sai_rc;
+}
+
+sai_status_t sai_fib_route_txn_route_remove (sai_fib_route_txn_t *p_txn,
+                                             sai_fib_route_t *p_route)
+{
+    sai_fib_route_txn_entry_t *p_entry = NULL;
+    sai_fib_vrf_t             *p_vrf_node = NULL;
+    sai_status_t               sai_rc;
+
+    if ((p_txn == NULL) || (p_route == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    p_vrf_node = sai_fib_vrf_node_get (p_route->vrf_id);
+
+    if ((p_vrf_node == NULL) ||
+        (std_radix_getexact (p_vrf_node->sai_route_tree,
+                             (uint8_t *) &p_route->key,
+                             sai_fib_route_key_len_get (p_route->prefix_len))
+         != &p_route->rt_head)) {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    if (sai_fib_route_txn_entry_is_staged (p_txn, SAI_FIB_ROUTE_TXN_OP_ROUTE_REMOVE,
+                                           p_route)) {
+        SAI_ROUTE_LOG_ERR ("Route in VRF 0x%"PRIx64" with prefix length %d "
+                           "is already staged for remove.", p_route->vrf_id,
+                           p_route->prefix_len);
+
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    sai_rc = sai_fib_route_txn_entry_alloc (p_txn,
+                                            SAI_FIB_ROUTE_TXN_OP_ROUTE_REMOVE,
+                                            &p_entry);
+
+    if (sai_rc == SAI_STATUS_SUCCESS) {
+        p_entry->obj.p_route = p_route;
+
+        sai_rc = sai_fib_route_txn_entry_stage (p_txn, p_entry);
+    }
+
+    return sai_rc;
+}
+
+sai_status_t sai_fib_route_txn_next_hop_create (sai_fib_route_txn_t *p_txn,
+                                                sai_fib_nh_t *p_next_hop)
+{
+    sai_fib_route_txn_entry_t *p_entry = NULL;
+    sai_status_t               sai_rc;
+
+    if ((p_txn == NULL) || (p_next_hop == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (sai_fib_vrf_node_get (p_next_hop->vrf_id) == NULL) {
+        SAI_NEXTHOP_LOG_ERR ("VRF 0x%"PRIx64" not found.", p_next_hop->vrf_id);
+
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    if (sai_fib_ip_next_hop_node_get (p_next_hop->key.rif_id,
+                                      sai_fib_next_hop_ip_addr (p_next_hop))) {
+        return SAI_STATUS_ITEM_ALREADY_EXISTS;
+    }
+
+    if (sai_fib_route_txn_entry_is_staged (p_txn,
+                                           SAI_FIB_ROUTE_TXN_OP_NEXT_HOP_CREATE,
+                                           p_next_hop)) {
+        SAI_NEXTHOP_LOG_ERR ("Next Hop on RIF 0x%"PRIx64" is already staged "
+                             "for create.", p_next_hop->key.rif_id);
+
+        return SAI_STATUS_ITEM_ALREADY_EXISTS;
+    }
+
+    sai_rc = sai_fib_route_txn_entry_alloc (p_txn,
+                                            SAI_FIB_ROUTE_TXN_OP_NEXT_HOP_CREATE,
+                                            &p_entry);
+
+    if (sai_rc == SAI_STATUS_SUCCESS) {
+        p_entry->obj.p_next_hop = p_next_hop;
+
+        sai_rc = sai_fib_route_txn_entry_stage (p_txn, p_entry);
+    }
+
+    return sai_rc;
+}
+
+sai_status_t sai_fib_route_txn_next_hop_remove (sai_fib_route_txn_t *p_txn,
+                                                sai_fib_nh_t *p_next_hop)
+{
+    sai_fib_route_txn_entry_t *p_entry = NULL;
+    sai_status_t               sai_rc;
+
+    if ((p_txn == NULL) || (p_next_hop == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (sai_fib_next_hop_node_get_from_id (p_next_hop->next_hop_id)
+        != p_next_hop) {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    if (sai_fib_route_txn_entry_is_staged (p_txn,
+                                           SAI_FIB_ROUTE_TXN_OP_NEXT_HOP_REMOVE,
+                                           p_next_hop)) {
+        SAI_NEXTHOP_LOG_ERR ("Next Hop 0x%"PRIx64" is already staged for "
+                             "remove.", p_next_hop->next_hop_id);
+
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    /* Routes and groups staged earlier in the journal are counted */
+    if (sai_fib_route_txn_nh_ref_count_get (p_txn, p_next_hop) > 0) {
+        SAI_NEXTHOP_LOG_ERR ("Next Hop 0x%"PRIx64" is in use by routes or "
+                             "NH Groups, ref_count: %d.", p_next_hop->next_hop_id,
+                             p_next_hop->ref_count);
+
+        return SAI_STATUS_OBJECT_IN_USE;
+    }
+
+    sai_rc = sai_fib_route_txn_entry_alloc (p_txn,
+                                            SAI_FIB_ROUTE_TXN_OP_NEXT_HOP_REMOVE,
+                                            &p_entry);
+
+    if (sai_rc == SAI_STATUS_SUCCESS) {
+        p_entry->obj.p_next_hop = p_next_hop;
+
+        sai_rc = sai_fib_route_txn_entry_stage (p_txn, p_entry);
+    }
+
+    return sai_rc;
+}
+
+sai_status_t sai_fib_route_txn_nh_group_member_add (sai_fib_route_txn_t *p_txn,
+                                                    sai_fib_nh_group_t *p_group,
+                                                    uint_t next_hop_count,
+                                                    sai_fib_nh_t *ap_next_hop [])
+{
+    if (p_txn == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return (sai_fib_route_txn_member_stage (p_txn,
+                                            SAI_FIB_ROUTE_TXN_OP_NH_GROUP_MEMBER_ADD,
+                                            p_group, next_hop_count,
+                                            ap_next_hop));
+}
+
+sai_status_t sai_fib_route_txn_nh_group_member_remove (
+                                                    sai_fib_route_txn_t *p_txn,
+                                                    sai_fib_nh_group_t *p_group,
+                                                    uint_t next_hop_count,
+                                                    sai_fib_nh_t *ap_next_hop [])
+{
+    if (p_txn == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return (sai_fib_route_txn_member_stage (p_txn,
+                                            SAI_FIB_ROUTE_TXN_OP_NH_GROUP_MEMBER_REMOVE,
+                                            p_group, next_hop_count,
+                                            ap_next_hop));
+}
+
+sai_status_t sai_fib_route_txn_commit (sai_fib_route_txn_t *p_txn,
+                                       uint_t *p_failed_index)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    uint_t       index;
+
+    if (p_txn == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (p_txn->state != SAI_FIB_ROUTE_TXN_STATE_OPEN) {
+        SAI_ROUTE_LOG_ERR ("Transaction %p is not open, state: %d.",
+                           p_txn, p_txn->state);
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    /* Program the journal in NPU. Member changes of a batch are marked
+     * done by the first entry of the batch */
+    for (index = 0; index < p_txn->num_entries; index++) {
+
+        if (p_txn->p_journal [index].is_hw_done) {
+            continue;
+        }
+
+        sai_rc = sai_fib_route_txn_entry_hw_apply (p_txn, index);
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            break;
+        }
+    }
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_ROUTE_LOG_ERR ("Transaction %p entry %d, op: %d failed in NPU, "
+                           "rc: %d. Rolling back %d entries.", p_txn, index,
+                           p_txn->p_journal [index].op, sai_rc, index);
+
+        p_txn->failed_index = index;
+
+        sai_fib_route_txn_hw_rollback (p_txn, index);
+
+        p_txn->state = SAI_FIB_ROUTE_TXN_STATE_ROLLED_BACK;
+
+        if (p_failed_index) {
+            *p_failed_index = index;
+        }
+
+        return sai_rc;
+    }
+
+    /* All entries are programmed in NPU, move the software FIB once */
+    for (index = 0; index < p_txn->num_entries; index++) {
+        sai_fib_route_txn_entry_sw_apply (&p_txn->p_journal [index]);
+    }
+
+    sai_fib_route_txn_bucket_tables_sync (p_txn);
+
+    sai_fib_nh_resolve_notify_flush ();
+
+    p_txn->state = SAI_FIB_ROUTE_TXN_STATE_COMMITTED;
+
+    SAI_ROUTE_LOG_TRACE ("Transaction %p committed %d entries.", p_txn,
+                         p_txn->num_entries);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_fib_route_txn_end (sai_fib_route_txn_t *p_txn)
+{
+    sai_fib_route_txn_entry_t *p_entry = NULL;
+    bool                       is_committed;
+    uint_t                     index;
+
+    if (p_txn == NULL) {
+        return;
+    }
+
+    is_committed = (p_txn->state == SAI_FIB_ROUTE_TXN_STATE_COMMITTED);
+
+    for (index = 0; index < p_txn->num_entries; index++) {
+
+        p_entry = &p_txn->p_journal [index];
+
+        sai_fib_route_txn_entry_link_free (p_entry);
+
+        switch (p_entry->op) {
+
+            case SAI_FIB_ROUTE_TXN_OP_ROUTE_CREATE:
+                if (!is_committed) {
+                    sai_fib_route_txn_node_release (p_txn, p_entry->op,
+                                                    p_entry->obj.p_route);
+                }
+                break;
+
+            case SAI_FIB_ROUTE_TXN_OP_ROUTE_REMOVE:
+                if (is_committed) {
+                    sai_fib_route_txn_node_release (p_txn, p_entry->op,
+                                                    p_entry->obj.p_route);
+                }
+                break;
+
+            case SAI_FIB_ROUTE_TXN_OP_NEXT_HOP_CREATE:
+                if (!is_committed) {
+                    sai_fib_route_txn_node_release (p_txn, p_entry->op,
+                                                    p_entry->obj.p_next_hop);
+                }
+                break;
+
+            case SAI_FIB_ROUTE_TXN_OP_NEXT_HOP_REMOVE:
+                /* Node is still owned by the neighbor if it is present */
+                if ((is_committed) &&
+                    (!sai_fib_is_owner_neighbor (p_entry->obj.p_next_hop))) {
+                    sai_fib_route_txn_node_release (p_txn, p_entry->op,
+                                                    p_entry->obj.p_next_hop);
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    SAI_ROUTE_LOG_TRACE ("Route transaction %p end, state: %d.", p_txn,
+                         p_txn->state);
+
+    sai_fib_route_txn_index_free (p_txn);
+
+    free (p_txn->p_journal);
+    free (p_txn);
+}
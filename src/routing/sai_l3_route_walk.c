@@ -0,0 +1,619 @@
+/************************************************************************
+* LEGALESE:   "Copyright (c) 2015, Dell Inc. All rights reserved."
+*
+* This source code is confidential, proprietary, and contains trade
+* secrets that are the sole property of Dell Inc.
+* Copy and/or distribution of this source code or disassembly or reverse
+* engineering of the resultant object code are strictly forbidden without
+* the written consent of Dell Inc.
+*
+************************************************************************/
+/**
+* @file sai_l3_route_walk.c
+*
+* @brief This file contains the route walk functions for SAI L3 component.
+*
+*************************************************************************/
+
+#include "sai_l3_route_walk.h"
+#include "sai_l3_ip_prefix.h"
+#include "sai_l3_util.h"
+#include "sai_l3_common.h"
+#include "saitypes.h"
+#include "saistatus.h"
+#include "std_type_defs.h"
+#include "std_rbtree.h"
+#include "std_radix.h"
+#include <pthread.h>
+#include <string.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+/**
+ * @brief Parallel route walk job shared by the worker threads.
+ */
+typedef struct _sai_fib_route_walk_job_t {
+    const sai_fib_route_walk_range_t  *p_range_list;
+    uint_t                             num_ranges;
+
+    /** Index of the next range to walk */
+    uint_t                             next_range;
+
+    const sai_fib_route_walk_filter_t *p_filter;
+    sai_fib_route_walk_fn              walk_fn;
+    void                              *p_cookie;
+
+    /** First error returned by a range walk */
+    sai_status_t                       status;
+
+    /** FIB write generation of the walked view */
+    uint64_t                           fib_write_gen;
+} sai_fib_route_walk_job_t;
+
+/**
+ * @brief Position of a chunked range walk. Holds a copy of the key of the
+ * last visited route, so the walk resumes from the key once the FIB read
+ * lock is taken again, even if the route was removed in between.
+ */
+typedef struct _sai_fib_route_walk_cursor_t {
+    sai_fib_route_key_t  key;
+    uint_t               key_len;
+
+    /** true once a route of the range was visited */
+    bool                 is_started;
+} sai_fib_route_walk_cursor_t;
+
+/***************************************************************************
+ *                          Private Functions
+ ***************************************************************************/
+static inline const uint8_t *sai_fib_route_walk_addr_bytes_get (
+                                           const sai_ip_address_t *p_ip_addr)
+{
+    return ((p_ip_addr->addr_family == SAI_IP_ADDR_FAMILY_IPV4) ?
+            (const uint8_t *) &p_ip_addr->addr.ip4 : p_ip_addr->addr.ip6);
+}
+
+/* Range index of an address, its leading split_bits */
+static inline uint_t sai_fib_route_walk_range_index_get (
+                                           const sai_ip_address_t *p_ip_addr,
+                                           uint_t split_bits)
+{
+    if (split_bits == 0) {
+        return 0;
+    }
+
+    return (sai_fib_route_walk_addr_bytes_get (p_ip_addr) [0] >>
+            (BITS_PER_BYTE - split_bits));
+}
+
+/*
+ * Start key of a range. A route of the range shorter than split_bits has
+ * the trailing zero bits of the range index cleared, so the start key is
+ * shortened to the last set bit of the index to be ordered before them.
+ */
+static uint_t sai_fib_route_walk_range_key_get (
+                                     const sai_fib_route_walk_range_t *p_range,
+                                     sai_fib_route_key_t *p_key)
+{
+    uint8_t *p_addr = NULL;
+
+    memset (p_key, 0, sizeof (sai_fib_route_key_t));
+
+    p_key->prefix.addr_family = p_range->addr_family;
+
+    if (p_range->index == 0) {
+        return sai_fib_route_key_len_get (0);
+    }
+
+    p_addr = (uint8_t *) sai_fib_route_walk_addr_bytes_get (&p_key->prefix);
+
+    p_addr [0] = (uint8_t) (p_range->index <<
+                            (BITS_PER_BYTE - p_range->split_bits));
+
+    return sai_fib_route_key_len_get (p_range->split_bits -
+                                      __builtin_ctz (p_range->index));
+}
+
+static sai_status_t sai_fib_route_walk_range_validate (
+                                     const sai_fib_route_walk_range_t *p_range)
+{
+    if ((p_range->split_bits > SAI_FIB_ROUTE_WALK_MAX_SPLIT_BITS) ||
+        (p_range->index >= (1u << p_range->split_bits)) ||
+        ((p_range->addr_family != SAI_IP_ADDR_FAMILY_IPV4) &&
+         (p_range->addr_family != SAI_IP_ADDR_FAMILY_IPV6))) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/*
+ * Walk the routes of a range from the cursor. At most max_routes routes are
+ * visited if max_routes is not 0, and the cursor is then set to the last
+ * visited route. Caller holds the FIB read lock.
+ */
+static sai_status_t sai_fib_route_walk_range_resume (
+                                     const sai_fib_route_walk_range_t *p_range,
+                                     const sai_fib_route_walk_filter_t *p_filter,
+                                     sai_fib_route_walk_fn walk_fn,
+                                     void *p_cookie,
+                                     sai_fib_route_walk_cursor_t *p_cursor,
+                                     uint_t max_routes, bool *p_is_done)
+{
+    sai_fib_vrf_t   *p_vrf_node = NULL;
+    sai_fib_route_t *p_route = NULL;
+    uint_t           num_routes = 0;
+    sai_status_t     status;
+
+    *p_is_done = true;
+
+    p_vrf_node = sai_fib_vrf_node_get (p_range->vrf_id);
+
+    if (p_vrf_node == NULL) {
+
+        /* VRF removed while the lock was released, nothing left to walk */
+        if (p_cursor->is_started) {
+            return SAI_STATUS_SUCCESS;
+        }
+
+        SAI_ROUTE_LOG_ERR ("VRF 0x%"PRIx64" not found.", p_range->vrf_id);
+
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    if (!p_cursor->is_started) {
+        p_cursor->key_len = sai_fib_route_walk_range_key_get (p_range,
+                                                              &p_cursor->key);
+
+        p_route = (sai_fib_route_t *)
+                  std_radix_getexact (p_vrf_node->sai_route_tree,
+                                      (uint8_t *) &p_cursor->key,
+                                      p_cursor->key_len);
+    }
+
+    if (p_route == NULL) {
+        p_route = (sai_fib_route_t *)
+                  std_radix_getnext (p_vrf_node->sai_route_tree,
+                                     (uint8_t *) &p_cursor->key,
+                                     p_cursor->key_len);
+    }
+
+    /* Routes of a range are contiguous in the tree */
+    for (; p_route != NULL;
+         p_route = sai_fib_route_get_next (p_vrf_node, p_route)) {
+
+        if ((p_route->key.prefix.addr_family != p_range->addr_family) ||
+            (sai_fib_route_walk_range_index_get (&p_route->key.prefix,
+                                                 p_range->split_bits) !=
+             p_range->index)) {
+            break;
+        }
+
+        if ((max_routes != 0) && (num_routes == max_routes)) {
+            *p_is_done = false;
+            break;
+        }
+
+        num_routes++;
+
+        /* Keep the cursor on the last visited route */
+        memcpy (&p_cursor->key, &p_route->key, sizeof (sai_fib_route_key_t));
+
+        p_cursor->key_len = sai_fib_route_key_len_get (p_route->prefix_len);
+        p_cursor->is_started = true;
+
+        if (!sai_fib_route_walk_filter_match (p_route, p_filter)) {
+            continue;
+        }
+
+        status = walk_fn (p_route, p_cookie);
+
+        if (status != SAI_STATUS_SUCCESS) {
+            return status;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/*
+ * Walk a range of a parallel walk in chunks of SAI_FIB_ROUTE_WALK_CHUNK_SIZE
+ * routes, with the FIB read lock released between the chunks. The walk is
+ * stopped if a writer took the FIB lock since the walk started, so that
+ * all the chunks are walked on the same FIB.
+ */
+static sai_status_t sai_fib_route_walk_range_chunked (
+                                     const sai_fib_route_walk_range_t *p_range,
+                                     sai_fib_route_walk_job_t *p_job)
+{
+    sai_fib_route_walk_cursor_t cursor;
+    bool                        is_done = false;
+    sai_status_t                status = SAI_STATUS_SUCCESS;
+
+    memset (&cursor, 0, sizeof (cursor));
+
+    while ((!is_done) &&
+           (__atomic_load_n (&p_job->status, __ATOMIC_ACQUIRE) ==
+            SAI_STATUS_SUCCESS)) {
+
+        sai_fib_read_lock ();
+
+        if (sai_fib_write_gen_get () != p_job->fib_write_gen) {
+            sai_fib_read_unlock ();
+
+            SAI_ROUTE_LOG_INFO ("FIB changed during the route walk of VRF "
+                                "0x%"PRIx64", walk is stopped.",
+                                p_range->vrf_id);
+
+            status = SAI_STATUS_OBJECT_IN_USE;
+            break;
+        }
+
+        status = sai_fib_route_walk_range_resume (p_range, p_job->p_filter,
+                                                  p_job->walk_fn,
+                                                  p_job->p_cookie, &cursor,
+                                                  SAI_FIB_ROUTE_WALK_CHUNK_SIZE,
+                                                  &is_done);
+
+        sai_fib_read_unlock ();
+
+        if (status != SAI_STATUS_SUCCESS) {
+            break;
+        }
+    }
+
+    return status;
+}
+
+static void *sai_fib_route_walk_worker (void *p_arg)
+{
+    sai_fib_route_walk_job_t *p_job = (sai_fib_route_walk_job_t *) p_arg;
+    sai_status_t              expected;
+    sai_status_t              status;
+    uint_t                    index;
+
+    while (__atomic_load_n (&p_job->status, __ATOMIC_ACQUIRE) ==
+           SAI_STATUS_SUCCESS) {
+
+        index = __atomic_fetch_add (&p_job->next_range, 1, __ATOMIC_RELAXED);
+
+        if (index >= p_job->num_ranges) {
+            break;
+        }
+
+        status = sai_fib_route_walk_range_chunked (&p_job->p_range_list [index],
+                                                   p_job);
+
+        if (status != SAI_STATUS_SUCCESS) {
+            expected = SAI_STATUS_SUCCESS;
+
+            __atomic_compare_exchange_n (&p_job->status, &expected, status,
+                                         false, __ATOMIC_ACQ_REL,
+                                         __ATOMIC_RELAXED);
+        }
+    }
+
+    return NULL;
+}
+
+static uint_t sai_fib_route_walk_vrf_list_get (sai_object_id_t *p_vrf_list,
+                                               uint_t max_count)
+{
+    sai_fib_global_t *p_fib_global = sai_fib_access_global_config ();
+    sai_fib_vrf_t    *p_vrf_node = NULL;
+    uint_t            count = 0;
+
+    for (p_vrf_node = std_rbtree_getfirst (p_fib_global->vrf_tree);
+         (p_vrf_node != NULL) && (count < max_count);
+         p_vrf_node = std_rbtree_getnext (p_fib_global->vrf_tree, p_vrf_node)) {
+
+        if (p_vrf_list) {
+            p_vrf_list [count] = p_vrf_node->vrf_id;
+        }
+
+        count++;
+    }
+
+    return count;
+}
+
+/***************************************************************************
+ *                          Public Functions
+ ***************************************************************************/
+bool sai_fib_route_walk_filter_match (sai_fib_route_t *p_route,
+                                      const sai_fib_route_walk_filter_t *p_filter)
+{
+    if (p_filter == NULL) {
+        return true;
+    }
+
+    if ((p_filter->flags & SAI_FIB_ROUTE_WALK_FILTER_ADDR_FAMILY) &&
+        (p_route->key.prefix.addr_family != p_filter->addr_family)) {
+        return false;
+    }
+
+    if ((p_filter->flags & SAI_FIB_ROUTE_WALK_FILTER_PREFIX_LEN) &&
+        ((p_route->prefix_len < p_filter->min_prefix_len) ||
+         (p_route->prefix_len > p_filter->max_prefix_len))) {
+        return false;
+    }
+
+    if ((p_filter->flags & SAI_FIB_ROUTE_WALK_FILTER_PREFIX) &&
+        ((p_route->key.prefix.addr_family != p_filter->prefix.addr_family) ||
+         (!sai_fib_ip_prefix_covers (&p_filter->prefix, p_filter->prefix_len,
+                                     &p_route->key.prefix,
+                                     p_route->prefix_len)))) {
+        return false;
+    }
+
+    if ((p_filter->flags & SAI_FIB_ROUTE_WALK_FILTER_NH_ID) &&
+        (sai_fib_route_node_nh_id_get (p_route) != p_filter->nh_id)) {
+        return false;
+    }
+
+    return true;
+}
+
+sai_status_t sai_fib_route_walk (sai_object_id_t vrf_id,
+                                 const sai_fib_route_walk_filter_t *p_filter,
+                                 sai_fib_route_walk_fn walk_fn, void *p_cookie)
+{
+    sai_fib_route_walk_range_t range;
+    sai_fib_vrf_t             *p_vrf_node = NULL;
+    sai_fib_route_t           *p_route = NULL;
+    sai_status_t               status;
+
+    if (walk_fn == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    memset (&range, 0, sizeof (range));
+
+    range.vrf_id = vrf_id;
+
+    /* Walk only the part of the tree that can match the filter */
+    if ((p_filter) && (p_filter->flags & SAI_FIB_ROUTE_WALK_FILTER_PREFIX)) {
+
+        if (sai_fib_ip_prefix_len_validate (p_filter->prefix.addr_family,
+                                            p_filter->prefix_len) !=
+            SAI_STATUS_SUCCESS) {
+            return SAI_STATUS_INVALID_PARAMETER;
+        }
+
+        range.addr_family = p_filter->prefix.addr_family;
+        range.split_bits = (p_filter->prefix_len < SAI_FIB_ROUTE_WALK_MAX_SPLIT_BITS) ?
+                           p_filter->prefix_len : SAI_FIB_ROUTE_WALK_MAX_SPLIT_BITS;
+        range.index = sai_fib_route_walk_range_index_get (&p_filter->prefix,
+                                                          range.split_bits);
+
+        return sai_fib_route_walk_range (&range, p_filter, walk_fn, p_cookie);
+    }
+
+    if ((p_filter) && (p_filter->flags & SAI_FIB_ROUTE_WALK_FILTER_ADDR_FAMILY)) {
+
+        range.addr_family = p_filter->addr_family;
+
+        return sai_fib_route_walk_range (&range, p_filter, walk_fn, p_cookie);
+    }
+
+    p_vrf_node = sai_fib_vrf_node_get (vrf_id);
+
+    if (p_vrf_node == NULL) {
+        SAI_ROUTE_LOG_ERR ("VRF 0x%"PRIx64" not found.", vrf_id);
+
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    for (p_route = sai_fib_route_get_first (p_vrf_node); p_route != NULL;
+         p_route = sai_fib_route_get_next (p_vrf_node, p_route)) {
+
+        if (!sai_fib_route_walk_filter_match (p_route, p_filter)) {
+            continue;
+        }
+
+        status = walk_fn (p_route, p_cookie);
+
+        if (status != SAI_STATUS_SUCCESS) {
+            return status;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_fib_route_walk_ranges_get (sai_object_id_t vrf_id,
+                                            uint_t split_bits,
+                                            sai_fib_route_walk_range_t *p_range_list,
+                                            uint_t *p_count)
+{
+    static const sai_ip_addr_family_t addr_family_list [] =
+                          {SAI_IP_ADDR_FAMILY_IPV4, SAI_IP_ADDR_FAMILY_IPV6};
+    uint_t num_ranges;
+    uint_t af_index;
+    uint_t index;
+    uint_t count = 0;
+
+    if ((p_count == NULL) || (split_bits > SAI_FIB_ROUTE_WALK_MAX_SPLIT_BITS)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    num_ranges = (sizeof (addr_family_list) / sizeof (addr_family_list [0])) <<
+                 split_bits;
+
+    if (p_range_list == NULL) {
+        *p_count = num_ranges;
+
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if (*p_count < num_ranges) {
+        *p_count = num_ranges;
+
+        return SAI_STATUS_BUFFER_OVERFLOW;
+    }
+
+    for (af_index = 0;
+         af_index < (sizeof (addr_family_list) / sizeof (addr_family_list [0]));
+         af_index++) {
+
+        for (index = 0; index < (1u << split_bits); index++) {
+
+            p_range_list [count].vrf_id      = vrf_id;
+            p_range_list [count].addr_family = addr_family_list [af_index];
+            p_range_list [count].split_bits  = split_bits;
+            p_range_list [count].index       = index;
+
+            count++;
+        }
+    }
+
+    *p_count = count;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_fib_route_walk_range (const sai_fib_route_walk_range_t *p_range,
+                                       const sai_fib_route_walk_filter_t *p_filter,
+                                       sai_fib_route_walk_fn walk_fn,
+                                       void *p_cookie)
+{
+    sai_fib_route_walk_cursor_t cursor;
+    bool                        is_done;
+
+    if ((p_range == NULL) || (walk_fn == NULL) ||
+        (sai_fib_route_walk_range_validate (p_range) != SAI_STATUS_SUCCESS)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    memset (&cursor, 0, sizeof (cursor));
+
+    return sai_fib_route_walk_range_resume (p_range, p_filter, walk_fn,
+                                            p_cookie, &cursor, 0, &is_done);
+}
+
+sai_status_t sai_fib_route_walk_parallel (const sai_object_id_t *p_vrf_list,
+                                          uint_t vrf_count, uint_t split_bits,
+                                          uint_t num_threads,
+                                          const sai_fib_route_walk_filter_t *p_filter,
+                                          sai_fib_route_walk_fn walk_fn,
+                                          void *p_cookie)
+{
+    sai_fib_route_walk_job_t    job;
+    sai_fib_route_walk_range_t *p_range_list = NULL;
+    sai_object_id_t            *p_all_vrf_list = NULL;
+    pthread_t                   thread_list [SAI_FIB_ROUTE_WALK_MAX_THREADS];
+    uint_t                      num_started = 0;
+    uint_t                      ranges_per_vrf = 0;
+    uint_t                      count;
+    uint_t                      index;
+    bool                        is_locked = false;
+    sai_status_t                status = SAI_STATUS_SUCCESS;
+
+    if ((walk_fn == NULL) || ((p_vrf_list == NULL) && (vrf_count != 0)) ||
+        (split_bits > SAI_FIB_ROUTE_WALK_MAX_SPLIT_BITS) ||
+        (num_threads > SAI_FIB_ROUTE_WALK_MAX_THREADS)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    sai_fib_route_walk_ranges_get (SAI_NULL_OBJECT_ID, split_bits, NULL,
+                                   &ranges_per_vrf);
+
+    sai_fib_read_lock ();
+    is_locked = true;
+
+    do {
+        if (p_vrf_list == NULL) {
+
+            vrf_count = sai_fib_route_walk_vrf_list_get (NULL, UINT32_MAX);
+
+            p_all_vrf_list = (sai_object_id_t *)
+                             calloc (vrf_count + 1, sizeof (sai_object_id_t));
+
+            if (p_all_vrf_list == NULL) {
+                status = SAI_STATUS_NO_MEMORY;
+                break;
+            }
+
+            vrf_count = sai_fib_route_walk_vrf_list_get (p_all_vrf_list,
+                                                         vrf_count);
+            p_vrf_list = p_all_vrf_list;
+        }
+
+        p_range_list = (sai_fib_route_walk_range_t *)
+                       calloc ((vrf_count * ranges_per_vrf) + 1,
+                               sizeof (sai_fib_route_walk_range_t));
+
+        if (p_range_list == NULL) {
+            status = SAI_STATUS_NO_MEMORY;
+            break;
+        }
+
+        for (index = 0; index < vrf_count; index++) {
+
+            if (sai_fib_vrf_node_get (p_vrf_list [index]) == NULL) {
+                SAI_ROUTE_LOG_ERR ("VRF 0x%"PRIx64" not found.",
+                                   p_vrf_list [index]);
+
+                status = SAI_STATUS_INVALID_OBJECT_ID;
+                break;
+            }
+
+            count = ranges_per_vrf;
+
+            sai_fib_route_walk_ranges_get (p_vrf_list [index], split_bits,
+                                           &p_range_list [index * ranges_per_vrf],
+                                           &count);
+        }
+
+        if (status != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        memset (&job, 0, sizeof (job));
+
+        job.p_range_list = p_range_list;
+        job.num_ranges   = vrf_count * ranges_per_vrf;
+        job.p_filter     = p_filter;
+        job.walk_fn      = walk_fn;
+        job.p_cookie     = p_cookie;
+        job.status       = SAI_STATUS_SUCCESS;
+
+        job.fib_write_gen = sai_fib_write_gen_get ();
+
+        /* Workers take the read lock per chunk of routes */
+        sai_fib_read_unlock ();
+        is_locked = false;
+
+        /* Calling thread is one of the workers */
+        for (index = 1; index < num_threads; index++) {
+
+            if (pthread_create (&thread_list [num_started], NULL,
+                                sai_fib_route_walk_worker, &job) != 0) {
+                SAI_ROUTE_LOG_WARN ("Failed to start route walk worker, "
+                                    "walking with %d threads.",
+                                    num_started + 1);
+                break;
+            }
+
+            num_started++;
+        }
+
+        sai_fib_route_walk_worker (&job);
+
+        for (index = 0; index < num_started; index++) {
+            pthread_join (thread_list [index], NULL);
+        }
+
+        status = job.status;
+
+    } while (0);
+
+    if (is_locked) {
+        sai_fib_read_unlock ();
+    }
+
+    free (p_range_list);
+    free (p_all_vrf_list);
+
+    return status;
+}
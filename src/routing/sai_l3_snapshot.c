@@ -0,0 +1,1579 @@
+/************************************************************************
+* LEGALESE:   "Copyright (c) 2015, Dell Inc. All rights reserved."
+*
+* This source code is confidential, proprietary, and contains trade
+* secrets that are the sole property of Dell Inc.
+* Copy and/or distribution of this source code or disassembly or reverse
+* engineering of the resultant object code are strictly forbidden without
+* the written consent of Dell Inc.
+*
+************************************************************************/
+/**
+* @file sai_l3_snapshot.c
+*
+* @brief This file contains the binary snapshot save and load functions
+*        of the SAI L3 FIB.
+*
+*************************************************************************/
+
+#include "sai_l3_snapshot.h"
+#include "sai_l3_nh_group_bucket.h"
+#include "sai_l3_ip_prefix.h"
+#include "sai_l3_util.h"
+#include "sai_l3_common.h"
+#include "saitypes.h"
+#include "saistatus.h"
+#include "std_type_defs.h"
+#include "std_llist.h"
+#include "std_rbtree.h"
+#include "std_radix.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Map of a FIB node pointer to its index in the snapshot.
+ */
+typedef struct _sai_fib_snapshot_ptr_map_t {
+    const void *p_node;
+    uint32_t    index;
+} sai_fib_snapshot_ptr_map_t;
+
+/**
+ * @brief Context for the snapshot load. Nodes of each section are linked
+ * in the FIB in order, num_linked nodes of a section are in the FIB.
+ */
+typedef struct _sai_fib_snapshot_load_ctx_t {
+    const uint8_t                 *p_buf;
+    const sai_fib_snapshot_hdr_t  *p_hdr;
+
+    sai_fib_vrf_t                **ap_vrf;
+    sai_fib_router_interface_t   **ap_rif;
+    sai_fib_nh_t                 **ap_nh;
+    sai_fib_nh_group_t           **ap_group;
+    sai_fib_route_t              **ap_route;
+
+    uint32_t                       num_linked [SAI_FIB_SNAPSHOT_SECTION_MAX];
+} sai_fib_snapshot_load_ctx_t;
+
+static const uint32_t sai_fib_snapshot_record_size [SAI_FIB_SNAPSHOT_SECTION_MAX] = {
+    sizeof (sai_fib_snapshot_vrf_t),
+    sizeof (sai_fib_snapshot_rif_t),
+    sizeof (sai_fib_snapshot_nh_t),
+    sizeof (sai_fib_snapshot_nh_group_t),
+    sizeof (sai_fib_snapshot_nh_group_member_t),
+    sizeof (sai_fib_snapshot_nh_group_bucket_t),
+    sizeof (sai_fib_snapshot_route_t),
+};
+
+/***************************************************************************
+ *                          Private Functions
+ ***************************************************************************/
+static inline uint64_t sai_fib_snapshot_align (uint64_t len)
+{
+    return ((len + SAI_FIB_SNAPSHOT_ALIGN - 1) &
+            ~((uint64_t) SAI_FIB_SNAPSHOT_ALIGN - 1));
+}
+
+static inline const void *sai_fib_snapshot_record_get (
+                                     const sai_fib_snapshot_load_ctx_t *p_ctx,
+                                     sai_fib_snapshot_section_t section,
+                                     uint32_t index)
+{
+    const sai_fib_snapshot_section_hdr_t *p_section =
+                                          &p_ctx->p_hdr->section [section];
+
+    return (p_ctx->p_buf + p_section->offset +
+            ((uint64_t) index * p_section->record_size));
+}
+
+static inline uint32_t sai_fib_snapshot_count_get (
+                                     const sai_fib_snapshot_load_ctx_t *p_ctx,
+                                     sai_fib_snapshot_section_t section)
+{
+    return (p_ctx->p_hdr->section [section].count);
+}
+
+static uint_t sai_fib_snapshot_ip_addr_len_get (uint_t addr_family)
+{
+    return ((addr_family == SAI_IP_ADDR_FAMILY_IPV4) ?
+            SAI_IPV4_ADDR_NUM_BYTES : SAI_IPV6_ADDR_NUM_BYTES);
+}
+
+static void sai_fib_snapshot_ip_addr_to_record (const sai_ip_address_t *p_ip,
+                                                uint32_t *p_addr_family,
+                                                uint8_t *p_addr)
+{
+    *p_addr_family = p_ip->addr_family;
+
+    if (p_ip->addr_family == SAI_IP_ADDR_FAMILY_IPV4) {
+        memcpy (p_addr, &p_ip->addr.ip4, SAI_IPV4_ADDR_NUM_BYTES);
+    } else {
+        memcpy (p_addr, &p_ip->addr.ip6, SAI_IPV6_ADDR_NUM_BYTES);
+    }
+}
+
+static void sai_fib_snapshot_ip_addr_from_record (sai_ip_address_t *p_ip,
+                                                  uint32_t addr_family,
+                                                  const uint8_t *p_addr)
+{
+    p_ip->addr_family = addr_family;
+
+    if (addr_family == SAI_IP_ADDR_FAMILY_IPV4) {
+        memcpy (&p_ip->addr.ip4, p_addr, SAI_IPV4_ADDR_NUM_BYTES);
+    } else {
+        memcpy (&p_ip->addr.ip6, p_addr, SAI_IPV6_ADDR_NUM_BYTES);
+    }
+}
+
+static sai_fib_nh_t *sai_fib_snapshot_nh_get_next (sai_fib_vrf_t *p_vrf_node,
+                                                   sai_fib_nh_t *p_next_hop)
+{
+    sai_fib_nh_key_t key;
+
+    if (p_next_hop) {
+        return ((sai_fib_nh_t *)
+                std_radix_getnext (p_vrf_node->sai_nh_tree,
+                                   (uint8_t *) &p_next_hop->key,
+                                   SAI_FIB_NH_IP_ADDR_TREE_KEY_LEN));
+    }
+
+    memset (&key, 0, sizeof (sai_fib_nh_key_t));
+
+    p_next_hop = (sai_fib_nh_t *)
+                 std_radix_getexact (p_vrf_node->sai_nh_tree, (uint8_t *) &key,
+                                     SAI_FIB_NH_IP_ADDR_TREE_KEY_LEN);
+
+    if (p_next_hop == NULL) {
+        p_next_hop = (sai_fib_nh_t *)
+                     std_radix_getnext (p_vrf_node->sai_nh_tree,
+                                        (uint8_t *) &key,
+                                        SAI_FIB_NH_IP_ADDR_TREE_KEY_LEN);
+    }
+
+    return p_next_hop;
+}
+
+static void sai_fib_snapshot_counts_get (uint32_t count [])
+{
+    sai_fib_global_t       *p_fib_global = sai_fib_access_global_config ();
+    sai_fib_vrf_t          *p_vrf_node = NULL;
+    sai_fib_router_interface_t *p_rif_node = NULL;
+    sai_fib_nh_t           *p_next_hop = NULL;
+    sai_fib_nh_group_t     *p_group = NULL;
+    sai_fib_wt_link_node_t *p_link = NULL;
+    sai_fib_route_t        *p_route = NULL;
+
+    memset (count, 0, SAI_FIB_SNAPSHOT_SECTION_MAX * sizeof (uint32_t));
+
+    for (p_vrf_node = std_rbtree_getfirst (p_fib_global->vrf_tree);
+         p_vrf_node != NULL;
+         p_vrf_node = std_rbtree_getnext (p_fib_global->vrf_tree, p_vrf_node)) {
+
+        count [SAI_FIB_SNAPSHOT_SECTION_VRF]++;
+
+        for (p_next_hop = sai_fib_snapshot_nh_get_next (p_vrf_node, NULL);
+             p_next_hop != NULL;
+             p_next_hop = sai_fib_snapshot_nh_get_next (p_vrf_node, p_next_hop)) {
+            count [SAI_FIB_SNAPSHOT_SECTION_NH]++;
+        }
+
+        for (p_route = sai_fib_route_get_first (p_vrf_node);
+             p_route != NULL;
+             p_route = sai_fib_route_get_next (p_vrf_node, p_route)) {
+            count [SAI_FIB_SNAPSHOT_SECTION_ROUTE]++;
+        }
+    }
+
+    for (p_rif_node = std_rbtree_getfirst (p_fib_global->router_interface_tree);
+         p_rif_node != NULL;
+         p_rif_node = std_rbtree_getnext (p_fib_global->router_interface_tree,
+                                          p_rif_node)) {
+        count [SAI_FIB_SNAPSHOT_SECTION_RIF]++;
+    }
+
+    for (p_group = std_rbtree_getfirst (p_fib_global->nh_group_tree);
+         p_group != NULL;
+         p_group = std_rbtree_getnext (p_fib_global->nh_group_tree, p_group)) {
+
+        count [SAI_FIB_SNAPSHOT_SECTION_NH_GROUP]++;
+
+        if (p_group->p_bucket_table) {
+            count [SAI_FIB_SNAPSHOT_SECTION_NH_GROUP_BUCKET] +=
+                                         p_group->p_bucket_table->num_buckets;
+        }
+
+        for (p_link = sai_fib_get_first_nh_from_nh_group (p_group);
+             p_link != NULL;
+             p_link = sai_fib_get_next_nh_from_nh_group (p_group, p_link)) {
+            count [SAI_FIB_SNAPSHOT_SECTION_NH_GROUP_MEMBER]++;
+        }
+    }
+}
+
+static uint64_t sai_fib_snapshot_layout_get (
+                                   const uint32_t count [],
+                                   sai_fib_snapshot_section_hdr_t section [])
+{
+    uint64_t offset = sai_fib_snapshot_align (sizeof (sai_fib_snapshot_hdr_t));
+    uint_t   index;
+
+    for (index = 0; index < SAI_FIB_SNAPSHOT_SECTION_MAX; index++) {
+
+        section [index].offset      = offset;
+        section [index].count       = count [index];
+        section [index].record_size = sai_fib_snapshot_record_size [index];
+
+        offset = sai_fib_snapshot_align (offset + ((uint64_t) count [index] *
+                                         sai_fib_snapshot_record_size [index]));
+    }
+
+    return offset;
+}
+
+static int sai_fib_snapshot_ptr_map_cmp (const void *p_a, const void *p_b)
+{
+    const void *p_node_a = ((const sai_fib_snapshot_ptr_map_t *) p_a)->p_node;
+    const void *p_node_b = ((const sai_fib_snapshot_ptr_map_t *) p_b)->p_node;
+
+    if (p_node_a == p_node_b) {
+        return 0;
+    }
+
+    return ((uintptr_t) p_node_a < (uintptr_t) p_node_b) ? -1 : 1;
+}
+
+static uint32_t sai_fib_snapshot_ptr_map_find (
+                                    const sai_fib_snapshot_ptr_map_t *p_map,
+                                    uint32_t count, const void *p_node)
+{
+    sai_fib_snapshot_ptr_map_t        key;
+    const sai_fib_snapshot_ptr_map_t *p_found = NULL;
+
+    if ((p_node == NULL) || (count == 0)) {
+        return SAI_FIB_SNAPSHOT_INVALID_INDEX;
+    }
+
+    key.p_node = p_node;
+
+    p_found = bsearch (&key, p_map, count, sizeof (sai_fib_snapshot_ptr_map_t),
+                       sai_fib_snapshot_ptr_map_cmp);
+
+    return ((p_found) ? p_found->index : SAI_FIB_SNAPSHOT_INVALID_INDEX);
+}
+
+static void sai_fib_snapshot_vrf_fill (sai_fib_snapshot_vrf_t *p_rec,
+                                       const sai_fib_vrf_t *p_vrf_node)
+{
+    p_rec->vrf_id                = p_vrf_node->vrf_id;
+    p_rec->ttl0_1_pkt_action     = p_vrf_node->ttl0_1_pkt_action;
+    p_rec->ip_options_pkt_action = p_vrf_node->ip_options_pkt_action;
+    p_rec->v4_admin_state        = p_vrf_node->v4_admin_state;
+    p_rec->v6_admin_state        = p_vrf_node->v6_admin_state;
+
+    memcpy (p_rec->src_mac, p_vrf_node->src_mac, sizeof (p_rec->src_mac));
+}
+
+static void sai_fib_snapshot_rif_fill (sai_fib_snapshot_rif_t *p_rec,
+                                       const sai_fib_router_interface_t *p_rif)
+{
+    p_rec->rif_id                = p_rif->rif_id;
+    p_rec->vrf_id                = p_rif->vrf_id;
+    p_rec->type                  = p_rif->type;
+    p_rec->mtu                   = p_rif->mtu;
+    p_rec->ip_options_pkt_action = p_rif->ip_options_pkt_action;
+    p_rec->ref_count             = p_rif->ref_count;
+    p_rec->v4_admin_state        = p_rif->v4_admin_state;
+    p_rec->v6_admin_state        = p_rif->v6_admin_state;
+
+    if (p_rif->type == SAI_ROUTER_INTERFACE_TYPE_VLAN) {
+        p_rec->attachment = p_rif->attachment.vlan_id;
+    } else {
+        p_rec->attachment = p_rif->attachment.port_id;
+    }
+
+    memcpy (p_rec->src_mac, p_rif->src_mac, sizeof (p_rec->src_mac));
+}
+
+static void sai_fib_snapshot_nh_fill (sai_fib_snapshot_nh_t *p_rec,
+                                      const sai_fib_nh_t *p_next_hop)
+{
+    p_rec->next_hop_id   = p_next_hop->next_hop_id;
+    p_rec->rif_id        = p_next_hop->key.rif_id;
+    p_rec->vrf_id        = p_next_hop->vrf_id;
+    p_rec->port_id       = p_next_hop->port_id;
+    p_rec->nh_type       = p_next_hop->key.nh_type;
+    p_rec->owner_flag    = p_next_hop->owner_flag;
+    p_rec->packet_action = p_next_hop->packet_action;
+    p_rec->ref_count     = p_next_hop->ref_count;
+    p_rec->meta_data     = p_next_hop->meta_data;
+    p_rec->no_host_route = p_next_hop->no_host_route;
+
+    sai_fib_snapshot_ip_addr_to_record (&p_next_hop->key.info.ip_nh.ip_addr,
+                                        &p_rec->addr_family, p_rec->addr);
+
+    memcpy (p_rec->mac_addr, p_next_hop->mac_addr, sizeof (p_rec->mac_addr));
+}
+
+/* Next hop and next hop group references of the route are resolved by the
+ * caller */
+static void sai_fib_snapshot_route_fill (sai_fib_snapshot_route_t *p_rec,
+                                         const sai_fib_route_t *p_route)
+{
+    p_rec->vrf_id        = p_route->vrf_id;
+    p_rec->prefix_len    = p_route->prefix_len;
+    p_rec->nh_type       = p_route->nh_type;
+    p_rec->nh_index      = SAI_FIB_SNAPSHOT_INVALID_INDEX;
+    p_rec->packet_action = p_route->packet_action;
+    p_rec->trap_priority = p_route->trap_priority;
+    p_rec->meta_data     = p_route->meta_data;
+
+    sai_fib_snapshot_ip_addr_to_record (&p_route->key.prefix,
+                                        &p_rec->addr_family, p_rec->addr);
+}
+
+static sai_status_t sai_fib_snapshot_header_validate (const uint8_t *p_buf,
+                                                      size_t len)
+{
+    const sai_fib_snapshot_hdr_t         *p_hdr = NULL;
+    const sai_fib_snapshot_section_hdr_t *p_section = NULL;
+    uint_t                                index;
+
+    if (((uintptr_t) p_buf % SAI_FIB_SNAPSHOT_ALIGN) ||
+        (len < sizeof (sai_fib_snapshot_hdr_t))) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    p_hdr = (const sai_fib_snapshot_hdr_t *) p_buf;
+
+    if ((p_hdr->magic != SAI_FIB_SNAPSHOT_MAGIC) ||
+        (p_hdr->version != SAI_FIB_SNAPSHOT_VERSION) ||
+        (p_hdr->hdr_size != sizeof (sai_fib_snapshot_hdr_t)) ||
+        (p_hdr->num_sections != SAI_FIB_SNAPSHOT_SECTION_MAX) ||
+        (p_hdr->total_len > len)) {
+
+        SAI_ROUTER_LOG_ERR ("Invalid FIB snapshot header, magic: 0x%x, "
+                            "version: %d, length: %"PRIu64".", p_hdr->magic,
+                            p_hdr->version, p_hdr->total_len);
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    for (index = 0; index < SAI_FIB_SNAPSHOT_SECTION_MAX; index++) {
+
+        p_section = &p_hdr->section [index];
+
+        if ((p_section->record_size != sai_fib_snapshot_record_size [index]) ||
+            (p_section->offset % SAI_FIB_SNAPSHOT_ALIGN) ||
+            (p_section->offset < p_hdr->hdr_size) ||
+            (p_section->offset > p_hdr->total_len) ||
+            (((uint64_t) p_section->count * p_section->record_size) >
+             (p_hdr->total_len - p_section->offset))) {
+
+            SAI_ROUTER_LOG_ERR ("Invalid FIB snapshot section %d.", index);
+
+            return SAI_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static bool sai_fib_snapshot_is_fib_empty (void)
+{
+    sai_fib_global_t *p_fib_global = sai_fib_access_global_config ();
+
+    return ((std_rbtree_getfirst (p_fib_global->vrf_tree) == NULL) &&
+            (std_rbtree_getfirst (p_fib_global->router_interface_tree) == NULL) &&
+            (std_rbtree_getfirst (p_fib_global->nh_group_tree) == NULL) &&
+            (std_rbtree_getfirst (p_fib_global->nh_id_tree) == NULL));
+}
+
+/* Key of the neighbor MAC entry for neighbors on VLAN router interfaces */
+static bool sai_fib_snapshot_nh_mac_entry_key_get (
+                                      const sai_fib_nh_t *p_next_hop,
+                                      sai_fib_neighbor_mac_entry_key_t *p_key)
+{
+    sai_fib_router_interface_t *p_rif_node = NULL;
+
+    if (!sai_fib_is_owner_neighbor ((sai_fib_nh_t *) p_next_hop)) {
+        return false;
+    }
+
+    p_rif_node = sai_fib_router_interface_node_get (p_next_hop->key.rif_id);
+
+    if ((p_rif_node == NULL) ||
+        (p_rif_node->type != SAI_ROUTER_INTERFACE_TYPE_VLAN)) {
+        return false;
+    }
+
+    memset (p_key, 0, sizeof (sai_fib_neighbor_mac_entry_key_t));
+
+    p_key->vlan_id = p_rif_node->attachment.vlan_id;
+    memcpy (&p_key->mac_addr, &p_next_hop->mac_addr, sizeof (sai_mac_t));
+
+    return true;
+}
+
+static sai_status_t sai_fib_snapshot_nh_mac_entry_link (sai_fib_nh_t *p_next_hop)
+{
+    sai_fib_neighbor_mac_entry_key_t  key;
+    sai_fib_neighbor_mac_entry_t     *p_mac_entry = NULL;
+
+    if (!sai_fib_snapshot_nh_mac_entry_key_get (p_next_hop, &key)) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    p_mac_entry = sai_fib_neighbor_mac_entry_find (&key);
+
+    if (p_mac_entry == NULL) {
+
+        p_mac_entry = (sai_fib_neighbor_mac_entry_t *)
+                      calloc (1, sizeof (sai_fib_neighbor_mac_entry_t));
+
+        if (p_mac_entry == NULL) {
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        memcpy (&p_mac_entry->key, &key, sizeof (key));
+        std_dll_init (&p_mac_entry->neighbor_list);
+
+        p_mac_entry->vrf_id = p_next_hop->vrf_id;
+
+        p_mac_entry->rt_head.rth_addr = (uint8_t *) &p_mac_entry->key;
+
+        if (std_radix_insert (sai_fib_access_global_config()->neighbor_mac_tree,
+                              &p_mac_entry->rt_head,
+                              SAI_FIB_NEIGHBOR_MAC_ENTRY_TREE_KEY_LEN) !=
+            &p_mac_entry->rt_head) {
+
+            free (p_mac_entry);
+
+            return SAI_STATUS_FAILURE;
+        }
+
+        sai_fib_neighbor_mac_entry_mem_stats_update (p_mac_entry, true);
+    }
+
+    std_dll_insertatback (&p_mac_entry->neighbor_list,
+                          &p_next_hop->mac_entry_link);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static void sai_fib_snapshot_nh_mac_entry_unlink (sai_fib_nh_t *p_next_hop)
+{
+    sai_fib_neighbor_mac_entry_key_t  key;
+    sai_fib_neighbor_mac_entry_t     *p_mac_entry = NULL;
+
+    if (!sai_fib_snapshot_nh_mac_entry_key_get (p_next_hop, &key)) {
+        return;
+    }
+
+    p_mac_entry = sai_fib_neighbor_mac_entry_find (&key);
+
+    if (p_mac_entry == NULL) {
+        return;
+    }
+
+    std_dll_remove (&p_mac_entry->neighbor_list, &p_next_hop->mac_entry_link);
+
+    if (sai_fib_get_first_neighbor_from_mac_entry (p_mac_entry) == NULL) {
+
+        std_radix_remove (sai_fib_access_global_config()->neighbor_mac_tree,
+                          &p_mac_entry->rt_head);
+
+        sai_fib_neighbor_mac_entry_mem_stats_update (p_mac_entry, false);
+
+        free (p_mac_entry);
+    }
+}
+
+static void sai_fib_snapshot_group_members_unlink (sai_fib_nh_group_t *p_group)
+{
+    sai_fib_wt_link_node_t *p_link = NULL;
+    sai_fib_wt_link_node_t *p_group_link = NULL;
+    sai_fib_nh_t           *p_next_hop = NULL;
+
+    while ((p_link = sai_fib_get_first_nh_from_nh_group (p_group)) != NULL) {
+
+        p_next_hop = sai_fib_get_nh_from_dll_link_node (&p_link->link_node);
+
+        p_group_link = sai_fib_nh_find_group_link_node (p_next_hop, p_group);
+
+        if (p_group_link) {
+            std_dll_remove (&p_next_hop->nh_group_list,
+                            &p_group_link->link_node.dll_glue);
+            free (p_group_link);
+        }
+
+        std_dll_remove (&p_group->nh_list, &p_link->link_node.dll_glue);
+        free (p_link);
+    }
+}
+
+static void sai_fib_snapshot_load_cleanup (sai_fib_snapshot_load_ctx_t *p_ctx)
+{
+    sai_fib_global_t *p_fib_global = sai_fib_access_global_config ();
+    sai_fib_vrf_t    *p_vrf_node = NULL;
+    sai_fib_router_interface_t *p_rif_node = NULL;
+    sai_fib_nh_t     *p_next_hop = NULL;
+    sai_fib_nh_group_t *p_group = NULL;
+    sai_fib_route_t  *p_route = NULL;
+    uint32_t          index;
+
+    for (index = 0; index < p_ctx->num_linked [SAI_FIB_SNAPSHOT_SECTION_ROUTE];
+         index++) {
+
+        p_route = p_ctx->ap_route [index];
+        p_vrf_node = sai_fib_vrf_node_get (p_route->vrf_id);
+
+        std_radix_remove (p_vrf_node->sai_route_tree, &p_route->rt_head);
+        sai_fib_vrf_route_stats_update (p_vrf_node, p_route, false);
+
+        free (p_route);
+    }
+
+    for (index = 0; index < p_ctx->num_linked [SAI_FIB_SNAPSHOT_SECTION_NH_GROUP];
+         index++) {
+
+        p_group = p_ctx->ap_group [index];
+
+        sai_fib_snapshot_group_members_unlink (p_group);
+        std_rbtree_remove (p_fib_global->nh_group_tree, p_group);
+
+        sai_fib_nh_group_node_free (p_group);
+    }
+
+    for (index = 0; index < p_ctx->num_linked [SAI_FIB_SNAPSHOT_SECTION_NH];
+         index++) {
+
+        p_next_hop = p_ctx->ap_nh [index];
+        p_vrf_node = sai_fib_vrf_node_get (p_next_hop->vrf_id);
+
+        sai_fib_snapshot_nh_mac_entry_unlink (p_next_hop);
+
+        if (sai_fib_is_owner_next_hop (p_next_hop)) {
+            std_rbtree_remove (p_fib_global->nh_id_tree, p_next_hop);
+        }
+
+        sai_fib_nh_tree_remove (p_vrf_node, p_next_hop);
+
+        free (p_next_hop);
+    }
+
+    for (index = 0; index < p_ctx->num_linked [SAI_FIB_SNAPSHOT_SECTION_RIF];
+         index++) {
+
+        p_rif_node = p_ctx->ap_rif [index];
+        p_vrf_node = sai_fib_vrf_node_get (p_rif_node->vrf_id);
+
+        std_dll_remove (&p_vrf_node->rif_dll_head, &p_rif_node->dll_glue);
+        p_vrf_node->num_rif--;
+
+        std_rbtree_remove (p_fib_global->router_interface_tree, p_rif_node);
+
+        free (p_rif_node);
+    }
+
+    for (index = 0; index < p_ctx->num_linked [SAI_FIB_SNAPSHOT_SECTION_VRF];
+         index++) {
+
+        p_vrf_node = p_ctx->ap_vrf [index];
+
+        std_rbtree_remove (p_fib_global->vrf_tree, p_vrf_node);
+
+        std_radix_destroy (p_vrf_node->sai_nh_tree);
+        std_radix_destroy (p_vrf_node->sai_route_tree);
+
+        free (p_vrf_node);
+
+        p_fib_global->num_virtual_routers--;
+    }
+}
+
+static sai_status_t sai_fib_snapshot_vrf_load (sai_fib_snapshot_load_ctx_t *p_ctx)
+{
+    sai_fib_global_t             *p_fib_global = sai_fib_access_global_config ();
+    const sai_fib_snapshot_vrf_t *p_rec = NULL;
+    sai_fib_vrf_t                *p_vrf_node = NULL;
+    uint32_t                      index;
+
+    for (index = 0;
+         index < sai_fib_snapshot_count_get (p_ctx, SAI_FIB_SNAPSHOT_SECTION_VRF);
+         index++) {
+
+        p_rec = sai_fib_snapshot_record_get (p_ctx, SAI_FIB_SNAPSHOT_SECTION_VRF,
+                                             index);
+
+        p_vrf_node = (sai_fib_vrf_t *) calloc (1, sizeof (sai_fib_vrf_t));
+
+        if (p_vrf_node == NULL) {
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        p_vrf_node->vrf_id                = p_rec->vrf_id;
+        p_vrf_node->ttl0_1_pkt_action     = p_rec->ttl0_1_pkt_action;
+        p_vrf_node->ip_options_pkt_action = p_rec->ip_options_pkt_action;
+        p_vrf_node->v4_admin_state        = p_rec->v4_admin_state;
+        p_vrf_node->v6_admin_state        = p_rec->v6_admin_state;
+
+        memcpy (p_vrf_node->src_mac, p_rec->src_mac, sizeof (p_rec->src_mac));
+
+        std_dll_init (&p_vrf_node->rif_dll_head);
+
+        p_vrf_node->sai_nh_tree =
+            std_radix_create ("SAI FIB NH tree", SAI_FIB_NH_IP_ADDR_TREE_KEY_LEN,
+                              NULL, NULL, 0);
+
+        p_vrf_node->sai_route_tree =
+            std_radix_create ("SAI FIB Route tree", SAI_FIB_ROUTE_TREE_KEY_LEN,
+                              NULL, NULL, 0);
+
+        if ((p_vrf_node->sai_nh_tree == NULL) ||
+            (p_vrf_node->sai_route_tree == NULL) ||
+            (std_rbtree_insert (p_fib_global->vrf_tree, p_vrf_node) != STD_ERR_OK)) {
+
+            SAI_ROUTER_LOG_ERR ("Failed to load VRF 0x%"PRIx64" from snapshot.",
+                                p_rec->vrf_id);
+
+            if (p_vrf_node->sai_nh_tree) {
+                std_radix_destroy (p_vrf_node->sai_nh_tree);
+            }
+
+            if (p_vrf_node->sai_route_tree) {
+                std_radix_destroy (p_vrf_node->sai_route_tree);
+            }
+
+            free (p_vrf_node);
+
+            return SAI_STATUS_FAILURE;
+        }
+
+        p_fib_global->num_virtual_routers++;
+
+        p_ctx->ap_vrf [index] = p_vrf_node;
+        p_ctx->num_linked [SAI_FIB_SNAPSHOT_SECTION_VRF]++;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t sai_fib_snapshot_rif_load (sai_fib_snapshot_load_ctx_t *p_ctx)
+{
+    sai_fib_global_t             *p_fib_global = sai_fib_access_global_config ();
+    const sai_fib_snapshot_rif_t *p_rec = NULL;
+    sai_fib_router_interface_t   *p_rif_node = NULL;
+    sai_fib_vrf_t                *p_vrf_node = NULL;
+    uint32_t                      index;
+
+    for (index = 0;
+         index < sai_fib_snapshot_count_get (p_ctx, SAI_FIB_SNAPSHOT_SECTION_RIF);
+         index++) {
+
+        p_rec = sai_fib_snapshot_record_get (p_ctx, SAI_FIB_SNAPSHOT_SECTION_RIF,
+                                             index);
+
+        p_vrf_node = sai_fib_vrf_node_get (p_rec->vrf_id);
+
+        if (p_vrf_node == NULL) {
+            SAI_ROUTER_LOG_ERR ("VRF 0x%"PRIx64" of RIF 0x%"PRIx64" not found "
+                                "in snapshot.", p_rec->vrf_id, p_rec->rif_id);
+
+            return SAI_STATUS_FAILURE;
+        }
+
+        p_rif_node = (sai_fib_router_interface_t *)
+                     calloc (1, sizeof (sai_fib_router_interface_t));
+
+        if (p_rif_node == NULL) {
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        p_rif_node->rif_id                = p_rec->rif_id;
+        p_rif_node->vrf_id                = p_rec->vrf_id;
+        p_rif_node->type                  = p_rec->type;
+        p_rif_node->mtu                   = p_rec->mtu;
+        p_rif_node->ip_options_pkt_action = p_rec->ip_options_pkt_action;
+        p_rif_node->ref_count             = p_rec->ref_count;
+        p_rif_node->v4_admin_state        = p_rec->v4_admin_state;
+        p_rif_node->v6_admin_state        = p_rec->v6_admin_state;
+
+        if (p_rif_node->type == SAI_ROUTER_INTERFACE_TYPE_VLAN) {
+            p_rif_node->attachment.vlan_id = (sai_vlan_id_t) p_rec->attachment;
+        } else {
+            p_rif_node->attachment.port_id = p_rec->attachment;
+        }
+
+        memcpy (p_rif_node->src_mac, p_rec->src_mac, sizeof (p_rec->src_mac));
+
+        if (std_rbtree_insert (p_fib_global->router_interface_tree,
+                               p_rif_node) != STD_ERR_OK) {
+
+            SAI_ROUTER_LOG_ERR ("Failed to load RIF 0x%"PRIx64" from snapshot.",
+                                p_rec->rif_id);
+
+            free (p_rif_node);
+
+            return SAI_STATUS_FAILURE;
+        }
+
+        std_dll_insertatback (&p_vrf_node->rif_dll_head, &p_rif_node->dll_glue);
+        p_vrf_node->num_rif++;
+
+        p_ctx->ap_rif [index] = p_rif_node;
+        p_ctx->num_linked [SAI_FIB_SNAPSHOT_SECTION_RIF]++;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t sai_fib_snapshot_nh_link (sai_fib_nh_t *p_next_hop,
+                                              sai_fib_vrf_t *p_vrf_node)
+{
+    sai_fib_global_t *p_fib_global = sai_fib_access_global_config ();
+
+    if (sai_fib_nh_tree_insert (p_vrf_node, p_next_hop) != SAI_STATUS_SUCCESS) {
+        return SAI_STATUS_FAILURE;
+    }
+
+    if ((sai_fib_is_owner_next_hop (p_next_hop)) &&
+        (std_rbtree_insert (p_fib_global->nh_id_tree, p_next_hop) != STD_ERR_OK)) {
+
+        sai_fib_nh_tree_remove (p_vrf_node, p_next_hop);
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    if (sai_fib_snapshot_nh_mac_entry_link (p_next_hop) != SAI_STATUS_SUCCESS) {
+
+        if (sai_fib_is_owner_next_hop (p_next_hop)) {
+            std_rbtree_remove (p_fib_global->nh_id_tree, p_next_hop);
+        }
+
+        sai_fib_nh_tree_remove (p_vrf_node, p_next_hop);
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t sai_fib_snapshot_nh_load (sai_fib_snapshot_load_ctx_t *p_ctx)
+{
+    const sai_fib_snapshot_nh_t *p_rec = NULL;
+    sai_fib_nh_t                *p_next_hop = NULL;
+    sai_fib_vrf_t               *p_vrf_node = NULL;
+    uint32_t                     index;
+
+    for (index = 0;
+         index < sai_fib_snapshot_count_get (p_ctx, SAI_FIB_SNAPSHOT_SECTION_NH);
+         index++) {
+
+        p_rec = sai_fib_snapshot_record_get (p_ctx, SAI_FIB_SNAPSHOT_SECTION_NH,
+                                             index);
+
+        p_vrf_node = sai_fib_vrf_node_get (p_rec->vrf_id);
+
+        if (p_vrf_node == NULL) {
+            SAI_NEXTHOP_LOG_ERR ("VRF 0x%"PRIx64" of next hop %d not found in "
+                                 "snapshot.", p_rec->vrf_id, index);
+
+            return SAI_STATUS_FAILURE;
+        }
+
+        p_next_hop = (sai_fib_nh_t *) calloc (1, sizeof (sai_fib_nh_t));
+
+        if (p_next_hop == NULL) {
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        p_next_hop->key.nh_type   = p_rec->nh_type;
+        p_next_hop->key.rif_id    = p_rec->rif_id;
+        p_next_hop->next_hop_id   = p_rec->next_hop_id;
+        p_next_hop->vrf_id        = p_rec->vrf_id;
+        p_next_hop->port_id       = p_rec->port_id;
+        p_next_hop->owner_flag    = p_rec->owner_flag;
+        p_next_hop->packet_action = p_rec->packet_action;
+        p_next_hop->ref_count     = p_rec->ref_count;
+        p_next_hop->meta_data     = p_rec->meta_data;
+        p_next_hop->no_host_route = p_rec->no_host_route;
+
+        sai_fib_snapshot_ip_addr_from_record (&p_next_hop->key.info.ip_nh.ip_addr,
+                                              p_rec->addr_family, p_rec->addr);
+
+        memcpy (p_next_hop->mac_addr, p_rec->mac_addr, sizeof (p_rec->mac_addr));
+
+        std_dll_init (&p_next_hop->nh_group_list);
+
+        if (sai_fib_snapshot_nh_link (p_next_hop, p_vrf_node) !=
+            SAI_STATUS_SUCCESS) {
+
+            SAI_NEXTHOP_LOG_ERR ("Failed to load next hop %d, Id 0x%"PRIx64" "
+                                 "from snapshot.", index, p_rec->next_hop_id);
+
+            free (p_next_hop);
+
+            return SAI_STATUS_FAILURE;
+        }
+
+        p_ctx->ap_nh [index] = p_next_hop;
+        p_ctx->num_linked [SAI_FIB_SNAPSHOT_SECTION_NH]++;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t sai_fib_snapshot_group_members_load (
+                                   sai_fib_snapshot_load_ctx_t *p_ctx,
+                                   const sai_fib_snapshot_nh_group_t *p_rec,
+                                   sai_fib_nh_group_t *p_group)
+{
+    const sai_fib_snapshot_nh_group_member_t *p_member = NULL;
+    sai_fib_wt_link_node_t                   *p_nh_link = NULL;
+    sai_fib_wt_link_node_t                   *p_group_link = NULL;
+    sai_fib_nh_t                             *p_next_hop = NULL;
+    uint32_t                                  index;
+
+    for (index = p_rec->member_start;
+         index < (p_rec->member_start + p_rec->member_count); index++) {
+
+        p_member = sai_fib_snapshot_record_get (p_ctx,
+                                        SAI_FIB_SNAPSHOT_SECTION_NH_GROUP_MEMBER,
+                                        index);
+
+        if (p_member->nh_index >=
+            sai_fib_snapshot_count_get (p_ctx, SAI_FIB_SNAPSHOT_SECTION_NH)) {
+            return SAI_STATUS_FAILURE;
+        }
+
+        p_next_hop = p_ctx->ap_nh [p_member->nh_index];
+
+        p_nh_link = (sai_fib_wt_link_node_t *)
+                    calloc (1, sizeof (sai_fib_wt_link_node_t));
+        p_group_link = (sai_fib_wt_link_node_t *)
+                       calloc (1, sizeof (sai_fib_wt_link_node_t));
+
+        if ((p_nh_link == NULL) || (p_group_link == NULL)) {
+            free (p_nh_link);
+            free (p_group_link);
+
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        p_nh_link->link_node.self = p_next_hop;
+        p_nh_link->weight = p_member->weight;
+        std_dll_insertatback (&p_group->nh_list, &p_nh_link->link_node.dll_glue);
+
+        p_group_link->link_node.self = p_group;
+        p_group_link->weight = p_member->weight;
+        std_dll_insertatback (&p_next_hop->nh_group_list,
+                              &p_group_link->link_node.dll_glue);
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Buckets are restored as saved, the NPU buckets are not reassigned */
+static sai_status_t sai_fib_snapshot_group_buckets_load (
+                                   sai_fib_snapshot_load_ctx_t *p_ctx,
+                                   const sai_fib_snapshot_nh_group_t *p_rec,
+                                   sai_fib_nh_group_t *p_group)
+{
+    const sai_fib_snapshot_nh_group_bucket_t *p_bucket = NULL;
+    sai_fib_nh_group_bucket_table_t          *p_table = p_group->p_bucket_table;
+    uint32_t                                  index;
+
+    if (p_table == NULL) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    for (index = 0; index < p_rec->num_buckets; index++) {
+
+        p_bucket = sai_fib_snapshot_record_get (p_ctx,
+                                        SAI_FIB_SNAPSHOT_SECTION_NH_GROUP_BUCKET,
+                                        p_rec->bucket_start + index);
+
+        if (p_bucket->nh_index == SAI_FIB_SNAPSHOT_INVALID_INDEX) {
+            p_table->p_bucket_list [index] = SAI_NULL_OBJECT_ID;
+            continue;
+        }
+
+        if (p_bucket->nh_index >=
+            sai_fib_snapshot_count_get (p_ctx, SAI_FIB_SNAPSHOT_SECTION_NH)) {
+            return SAI_STATUS_FAILURE;
+        }
+
+        p_table->p_bucket_list [index] =
+                                 p_ctx->ap_nh [p_bucket->nh_index]->next_hop_id;
+    }
+
+    p_table->is_programmed = true;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t sai_fib_snapshot_group_load (
+                                        sai_fib_snapshot_load_ctx_t *p_ctx)
+{
+    sai_fib_global_t                  *p_fib_global = sai_fib_access_global_config ();
+    const sai_fib_snapshot_nh_group_t *p_rec = NULL;
+    sai_fib_nh_group_t                *p_group = NULL;
+    uint32_t                           num_members;
+    uint32_t                           num_buckets;
+    uint32_t                           index;
+
+    num_members = sai_fib_snapshot_count_get (p_ctx,
+                                      SAI_FIB_SNAPSHOT_SECTION_NH_GROUP_MEMBER);
+    num_buckets = sai_fib_snapshot_count_get (p_ctx,
+                                      SAI_FIB_SNAPSHOT_SECTION_NH_GROUP_BUCKET);
+
+    for (index = 0;
+         index < sai_fib_snapshot_count_get (p_ctx,
+                                             SAI_FIB_SNAPSHOT_SECTION_NH_GROUP);
+         index++) {
+
+        p_rec = sai_fib_snapshot_record_get (p_ctx,
+                                             SAI_FIB_SNAPSHOT_SECTION_NH_GROUP,
+                                             index);
+
+        if ((p_rec->member_start > num_members) ||
+            (p_rec->member_count > (num_members - p_rec->member_start))) {
+
+            SAI_NH_GROUP_LOG_ERR ("Invalid members for group 0x%"PRIx64" in "
+                                  "snapshot.", p_rec->group_id);
+
+            return SAI_STATUS_FAILURE;
+        }
+
+        if ((p_rec->num_buckets > SAI_FIB_NH_GROUP_MAX_NUM_BUCKETS) ||
+            (p_rec->bucket_start > num_buckets) ||
+            (p_rec->num_buckets > (num_buckets - p_rec->bucket_start))) {
+
+            SAI_NH_GROUP_LOG_ERR ("Invalid buckets for group 0x%"PRIx64" in "
+                                  "snapshot.", p_rec->group_id);
+
+            return SAI_STATUS_FAILURE;
+        }
+
+        /* Bucket table is built empty, the buckets are loaded after the
+         * members */
+        p_group = sai_fib_nh_group_node_alloc (p_rec->group_id, p_rec->type,
+                                               p_rec->num_buckets);
+
+        if (p_group == NULL) {
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        p_group->nh_count     = p_rec->nh_count;
+        p_group->ref_count    = p_rec->ref_count;
+
+        if (std_rbtree_insert (p_fib_global->nh_group_tree, p_group) !=
+            STD_ERR_OK) {
+
+            SAI_NH_GROUP_LOG_ERR ("Failed to load group 0x%"PRIx64" from "
+                                  "snapshot.", p_rec->group_id);
+
+            sai_fib_nh_group_node_free (p_group);
+
+            return SAI_STATUS_FAILURE;
+        }
+
+        /* Members linked so far are released by the cleanup */
+        p_ctx->ap_group [index] = p_group;
+        p_ctx->num_linked [SAI_FIB_SNAPSHOT_SECTION_NH_GROUP]++;
+
+        if (sai_fib_snapshot_group_members_load (p_ctx, p_rec, p_group) !=
+            SAI_STATUS_SUCCESS) {
+
+            SAI_NH_GROUP_LOG_ERR ("Failed to load members of group 0x%"PRIx64" "
+                                  "from snapshot.", p_rec->group_id);
+
+            return SAI_STATUS_FAILURE;
+        }
+
+        if (sai_fib_snapshot_group_buckets_load (p_ctx, p_rec, p_group) !=
+            SAI_STATUS_SUCCESS) {
+
+            SAI_NH_GROUP_LOG_ERR ("Failed to load buckets of group 0x%"PRIx64" "
+                                  "from snapshot.", p_rec->group_id);
+
+            return SAI_STATUS_FAILURE;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t sai_fib_snapshot_route_load (
+                                        sai_fib_snapshot_load_ctx_t *p_ctx)
+{
+    const sai_fib_snapshot_route_t *p_rec = NULL;
+    sai_fib_route_t                *p_route = NULL;
+    sai_fib_vrf_t                  *p_vrf_node = NULL;
+    uint32_t                        index;
+
+    for (index = 0;
+         index < sai_fib_snapshot_count_get (p_ctx, SAI_FIB_SNAPSHOT_SECTION_ROUTE);
+         index++) {
+
+        p_rec = sai_fib_snapshot_record_get (p_ctx, SAI_FIB_SNAPSHOT_SECTION_ROUTE,
+                                             index);
+
+        p_vrf_node = sai_fib_vrf_node_get (p_rec->vrf_id);
+
+        if ((p_vrf_node == NULL) ||
+            (sai_fib_ip_prefix_len_validate (p_rec->addr_family,
+                                             p_rec->prefix_len) !=
+             SAI_STATUS_SUCCESS) ||
+            ((p_rec->nh_type == SAI_OBJECT_TYPE_NEXT_HOP) &&
+             (p_rec->nh_index >=
+              sai_fib_snapshot_count_get (p_ctx, SAI_FIB_SNAPSHOT_SECTION_NH))) ||
+            ((p_rec->nh_type == SAI_OBJECT_TYPE_NEXT_HOP_GROUP) &&
+             (p_rec->nh_index >=
+              sai_fib_snapshot_count_get (p_ctx, SAI_FIB_SNAPSHOT_SECTION_NH_GROUP)))) {
+
+            SAI_ROUTE_LOG_ERR ("Invalid route %d in snapshot.", index);
+
+            return SAI_STATUS_FAILURE;
+        }
+
+        p_route = (sai_fib_route_t *) calloc (1, sizeof (sai_fib_route_t));
+
+        if (p_route == NULL) {
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        p_route->vrf_id        = p_rec->vrf_id;
+        p_route->prefix_len    = p_rec->prefix_len;
+        p_route->nh_type       = p_rec->nh_type;
+        p_route->packet_action = p_rec->packet_action;
+        p_route->trap_priority = p_rec->trap_priority;
+        p_route->meta_data     = p_rec->meta_data;
+
+        if (p_rec->nh_type == SAI_OBJECT_TYPE_NEXT_HOP) {
+            p_route->nh_info.nh_node = p_ctx->ap_nh [p_rec->nh_index];
+        } else if (p_rec->nh_type == SAI_OBJECT_TYPE_NEXT_HOP_GROUP) {
+            p_route->nh_info.group_node = p_ctx->ap_group [p_rec->nh_index];
+        }
+
+        sai_fib_snapshot_ip_addr_from_record (&p_route->key.prefix,
+                                              p_rec->addr_family, p_rec->addr);
+
+        if (!sai_fib_ip_prefix_is_canonical (&p_route->key.prefix,
+                                             p_route->prefix_len)) {
+
+            SAI_ROUTE_LOG_ERR ("Route %d in snapshot has host bits set.", index);
+
+            free (p_route);
+
+            return SAI_STATUS_FAILURE;
+        }
+
+        p_route->rt_head.rth_addr = (uint8_t *) &p_route->key;
+
+        if (std_radix_insert (p_vrf_node->sai_route_tree, &p_route->rt_head,
+                              sai_fib_route_key_len_get (p_route->prefix_len)) !=
+            &p_route->rt_head) {
+
+            SAI_ROUTE_LOG_ERR ("Failed to load route %d from snapshot.", index);
+
+            free (p_route);
+
+            return SAI_STATUS_FAILURE;
+        }
+
+        sai_fib_vrf_route_stats_update (p_vrf_node, p_route, true);
+
+        p_ctx->ap_route [index] = p_route;
+        p_ctx->num_linked [SAI_FIB_SNAPSHOT_SECTION_ROUTE]++;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static void **sai_fib_snapshot_node_array_alloc (uint32_t count)
+{
+    return ((void **) calloc ((count) ? count : 1, sizeof (void *)));
+}
+
+/***************************************************************************
+ *                          Public Functions
+ ***************************************************************************/
+sai_status_t sai_fib_snapshot_len_get (size_t *p_len)
+{
+    uint32_t                       count [SAI_FIB_SNAPSHOT_SECTION_MAX];
+    sai_fib_snapshot_section_hdr_t section [SAI_FIB_SNAPSHOT_SECTION_MAX];
+
+    if (p_len == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    sai_fib_snapshot_counts_get (count);
+
+    *p_len = sai_fib_snapshot_layout_get (count, section);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_fib_snapshot_serialize (uint8_t *p_buf, size_t buf_len,
+                                         size_t *p_len)
+{
+    sai_fib_global_t            *p_fib_global = sai_fib_access_global_config ();
+    sai_fib_snapshot_hdr_t      *p_hdr = NULL;
+    sai_fib_snapshot_ptr_map_t  *p_nh_map = NULL;
+    sai_fib_snapshot_ptr_map_t  *p_group_map = NULL;
+    sai_fib_snapshot_vrf_t      *p_vrf_rec = NULL;
+    sai_fib_snapshot_rif_t      *p_rif_rec = NULL;
+    sai_fib_snapshot_nh_t       *p_nh_rec = NULL;
+    sai_fib_snapshot_nh_group_t *p_group_rec = NULL;
+    sai_fib_snapshot_nh_group_member_t *p_member_rec = NULL;
+    sai_fib_snapshot_nh_group_bucket_t *p_bucket_rec = NULL;
+    sai_fib_snapshot_route_t    *p_route_rec = NULL;
+    sai_fib_vrf_t               *p_vrf_node = NULL;
+    sai_fib_router_interface_t  *p_rif_node = NULL;
+    sai_fib_nh_t                *p_next_hop = NULL;
+    sai_fib_nh_group_t          *p_group = NULL;
+    sai_fib_wt_link_node_t      *p_link = NULL;
+    sai_fib_route_t             *p_route = NULL;
+    uint32_t                     bucket;
+    uint32_t                     count [SAI_FIB_SNAPSHOT_SECTION_MAX];
+    uint32_t                     index [SAI_FIB_SNAPSHOT_SECTION_MAX];
+    uint64_t                     total_len;
+    sai_status_t                 status = SAI_STATUS_SUCCESS;
+
+    if ((p_buf == NULL) || (p_len == NULL) ||
+        ((uintptr_t) p_buf % SAI_FIB_SNAPSHOT_ALIGN)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    sai_fib_snapshot_counts_get (count);
+
+    memset (p_buf, 0, sizeof (sai_fib_snapshot_hdr_t) < buf_len ?
+            sizeof (sai_fib_snapshot_hdr_t) : buf_len);
+
+    if (buf_len < sizeof (sai_fib_snapshot_hdr_t)) {
+        return SAI_STATUS_BUFFER_OVERFLOW;
+    }
+
+    p_hdr = (sai_fib_snapshot_hdr_t *) p_buf;
+
+    total_len = sai_fib_snapshot_layout_get (count, p_hdr->section);
+
+    if (total_len > buf_len) {
+        *p_len = total_len;
+
+        return SAI_STATUS_BUFFER_OVERFLOW;
+    }
+
+    memset (p_buf, 0, total_len);
+
+    p_hdr->magic        = SAI_FIB_SNAPSHOT_MAGIC;
+    p_hdr->version      = SAI_FIB_SNAPSHOT_VERSION;
+    p_hdr->total_len    = total_len;
+    p_hdr->hdr_size     = sizeof (sai_fib_snapshot_hdr_t);
+    p_hdr->num_sections = SAI_FIB_SNAPSHOT_SECTION_MAX;
+
+    sai_fib_snapshot_layout_get (count, p_hdr->section);
+
+    p_nh_map = (sai_fib_snapshot_ptr_map_t *)
+               calloc (count [SAI_FIB_SNAPSHOT_SECTION_NH] + 1,
+                       sizeof (sai_fib_snapshot_ptr_map_t));
+    p_group_map = (sai_fib_snapshot_ptr_map_t *)
+                  calloc (count [SAI_FIB_SNAPSHOT_SECTION_NH_GROUP] + 1,
+                          sizeof (sai_fib_snapshot_ptr_map_t));
+
+    if ((p_nh_map == NULL) || (p_group_map == NULL)) {
+        free (p_nh_map);
+        free (p_group_map);
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    p_vrf_rec = (sai_fib_snapshot_vrf_t *)
+                (p_buf + p_hdr->section [SAI_FIB_SNAPSHOT_SECTION_VRF].offset);
+    p_rif_rec = (sai_fib_snapshot_rif_t *)
+                (p_buf + p_hdr->section [SAI_FIB_SNAPSHOT_SECTION_RIF].offset);
+    p_nh_rec = (sai_fib_snapshot_nh_t *)
+               (p_buf + p_hdr->section [SAI_FIB_SNAPSHOT_SECTION_NH].offset);
+    p_group_rec = (sai_fib_snapshot_nh_group_t *)
+                  (p_buf + p_hdr->section [SAI_FIB_SNAPSHOT_SECTION_NH_GROUP].offset);
+    p_member_rec = (sai_fib_snapshot_nh_group_member_t *)
+                   (p_buf +
+                    p_hdr->section [SAI_FIB_SNAPSHOT_SECTION_NH_GROUP_MEMBER].offset);
+    p_bucket_rec = (sai_fib_snapshot_nh_group_bucket_t *)
+                   (p_buf +
+                    p_hdr->section [SAI_FIB_SNAPSHOT_SECTION_NH_GROUP_BUCKET].offset);
+    p_route_rec = (sai_fib_snapshot_route_t *)
+                  (p_buf + p_hdr->section [SAI_FIB_SNAPSHOT_SECTION_ROUTE].offset);
+
+    memset (index, 0, sizeof (index));
+
+    /* VRF, next hop and router interface records */
+    for (p_vrf_node = std_rbtree_getfirst (p_fib_global->vrf_tree);
+         p_vrf_node != NULL;
+         p_vrf_node = std_rbtree_getnext (p_fib_global->vrf_tree, p_vrf_node)) {
+
+        sai_fib_snapshot_vrf_fill (&p_vrf_rec [index [SAI_FIB_SNAPSHOT_SECTION_VRF]++],
+                                   p_vrf_node);
+
+        for (p_next_hop = sai_fib_snapshot_nh_get_next (p_vrf_node, NULL);
+             p_next_hop != NULL;
+             p_next_hop = sai_fib_snapshot_nh_get_next (p_vrf_node, p_next_hop)) {
+
+            p_nh_map [index [SAI_FIB_SNAPSHOT_SECTION_NH]].p_node = p_next_hop;
+            p_nh_map [index [SAI_FIB_SNAPSHOT_SECTION_NH]].index =
+                                          index [SAI_FIB_SNAPSHOT_SECTION_NH];
+
+            sai_fib_snapshot_nh_fill (&p_nh_rec [index [SAI_FIB_SNAPSHOT_SECTION_NH]++],
+                                      p_next_hop);
+        }
+    }
+
+    for (p_rif_node = std_rbtree_getfirst (p_fib_global->router_interface_tree);
+         p_rif_node != NULL;
+         p_rif_node = std_rbtree_getnext (p_fib_global->router_interface_tree,
+                                          p_rif_node)) {
+
+        sai_fib_snapshot_rif_fill (&p_rif_rec [index [SAI_FIB_SNAPSHOT_SECTION_RIF]++],
+                                   p_rif_node);
+    }
+
+    qsort (p_nh_map, count [SAI_FIB_SNAPSHOT_SECTION_NH],
+           sizeof (sai_fib_snapshot_ptr_map_t), sai_fib_snapshot_ptr_map_cmp);
+
+    /* Next hop group and member records */
+    for (p_group = std_rbtree_getfirst (p_fib_global->nh_group_tree);
+         p_group != NULL;
+         p_group = std_rbtree_getnext (p_fib_global->nh_group_tree, p_group)) {
+
+        p_group_map [index [SAI_FIB_SNAPSHOT_SECTION_NH_GROUP]].p_node = p_group;
+        p_group_map [index [SAI_FIB_SNAPSHOT_SECTION_NH_GROUP]].index =
+                                     index [SAI_FIB_SNAPSHOT_SECTION_NH_GROUP];
+
+        p_group_rec->group_id     = p_group->key.group_id;
+        p_group_rec->type         = p_group->type;
+        p_group_rec->nh_count     = p_group->nh_count;
+        p_group_rec->ref_count    = p_group->ref_count;
+        p_group_rec->member_start =
+                             index [SAI_FIB_SNAPSHOT_SECTION_NH_GROUP_MEMBER];
+
+        for (p_link = sai_fib_get_first_nh_from_nh_group (p_group);
+             p_link != NULL;
+             p_link = sai_fib_get_next_nh_from_nh_group (p_group, p_link)) {
+
+            p_member_rec->nh_index =
+                sai_fib_snapshot_ptr_map_find (p_nh_map,
+                         count [SAI_FIB_SNAPSHOT_SECTION_NH],
+                         sai_fib_get_nh_from_dll_link_node (&p_link->link_node));
+            p_member_rec->weight = p_link->weight;
+
+            if (p_member_rec->nh_index == SAI_FIB_SNAPSHOT_INVALID_INDEX) {
+                SAI_NH_GROUP_LOG_ERR ("Next hop member of group 0x%"PRIx64" "
+                                      "not found in VRF next hop trees.",
+                                      p_group->key.group_id);
+
+                status = SAI_STATUS_FAILURE;
+            }
+
+            p_member_rec++;
+            p_group_rec->member_count++;
+            index [SAI_FIB_SNAPSHOT_SECTION_NH_GROUP_MEMBER]++;
+        }
+
+        p_group_rec->bucket_start =
+                             index [SAI_FIB_SNAPSHOT_SECTION_NH_GROUP_BUCKET];
+
+        for (bucket = 0; (p_group->p_bucket_table) &&
+             (bucket < p_group->p_bucket_table->num_buckets); bucket++) {
+
+            p_bucket_rec->nh_index = SAI_FIB_SNAPSHOT_INVALID_INDEX;
+
+            p_next_hop = sai_fib_next_hop_node_get_from_id (
+                             p_group->p_bucket_table->p_bucket_list [bucket]);
+
+            if (p_next_hop) {
+                p_bucket_rec->nh_index =
+                    sai_fib_snapshot_ptr_map_find (p_nh_map,
+                                         count [SAI_FIB_SNAPSHOT_SECTION_NH],
+                                         p_next_hop);
+            }
+
+            if ((p_group->p_bucket_table->p_bucket_list [bucket] !=
+                 SAI_NULL_OBJECT_ID) &&
+                (p_bucket_rec->nh_index == SAI_FIB_SNAPSHOT_INVALID_INDEX)) {
+                SAI_NH_GROUP_LOG_ERR ("Next hop of bucket %d of group "
+                                      "0x%"PRIx64" not found in VRF next hop "
+                                      "trees.", bucket, p_group->key.group_id);
+
+                status = SAI_STATUS_FAILURE;
+            }
+
+            p_bucket_rec++;
+            p_group_rec->num_buckets++;
+            index [SAI_FIB_SNAPSHOT_SECTION_NH_GROUP_BUCKET]++;
+        }
+
+        p_group_rec++;
+        index [SAI_FIB_SNAPSHOT_SECTION_NH_GROUP]++;
+    }
+
+    qsort (p_group_map, count [SAI_FIB_SNAPSHOT_SECTION_NH_GROUP],
+           sizeof (sai_fib_snapshot_ptr_map_t), sai_fib_snapshot_ptr_map_cmp);
+
+    /* Route records */
+    for (p_vrf_node = std_rbtree_getfirst (p_fib_global->vrf_tree);
+         p_vrf_node != NULL;
+         p_vrf_node = std_rbtree_getnext (p_fib_global->vrf_tree, p_vrf_node)) {
+
+        for (p_route = sai_fib_route_get_first (p_vrf_node);
+             p_route != NULL;
+             p_route = sai_fib_route_get_next (p_vrf_node, p_route)) {
+
+            sai_fib_snapshot_route_fill (p_route_rec, p_route);
+
+            if (p_route->nh_type == SAI_OBJECT_TYPE_NEXT_HOP) {
+                p_route_rec->nh_index =
+                    sai_fib_snapshot_ptr_map_find (p_nh_map,
+                                        count [SAI_FIB_SNAPSHOT_SECTION_NH],
+                                        p_route->nh_info.nh_node);
+            } else if (p_route->nh_type == SAI_OBJECT_TYPE_NEXT_HOP_GROUP) {
+                p_route_rec->nh_index =
+                    sai_fib_snapshot_ptr_map_find (p_group_map,
+                                        count [SAI_FIB_SNAPSHOT_SECTION_NH_GROUP],
+                                        p_route->nh_info.group_node);
+            }
+
+            if (((p_route->nh_type == SAI_OBJECT_TYPE_NEXT_HOP) ||
+                 (p_route->nh_type == SAI_OBJECT_TYPE_NEXT_HOP_GROUP)) &&
+                (p_route_rec->nh_index == SAI_FIB_SNAPSHOT_INVALID_INDEX)) {
+
+                SAI_ROUTE_LOG_ERR ("Next hop of route in VRF 0x%"PRIx64" not "
+                                   "found in the FIB.", p_route->vrf_id);
+
+                status = SAI_STATUS_FAILURE;
+            }
+
+            p_route_rec++;
+        }
+    }
+
+    free (p_nh_map);
+    free (p_group_map);
+
+    *p_len = total_len;
+
+    return status;
+}
+
+sai_status_t sai_fib_snapshot_deserialize (const uint8_t *p_buf, size_t len)
+{
+    sai_fib_snapshot_load_ctx_t ctx;
+    sai_status_t                status;
+
+    status = sai_fib_snapshot_header_validate (p_buf, len);
+
+    if (status != SAI_STATUS_SUCCESS) {
+        return status;
+    }
+
+    if (!sai_fib_snapshot_is_fib_empty ()) {
+        SAI_ROUTER_LOG_ERR ("FIB snapshot can be loaded only in an empty FIB.");
+
+        return SAI_STATUS_OBJECT_IN_USE;
+    }
+
+    memset (&ctx, 0, sizeof (ctx));
+
+    ctx.p_buf = p_buf;
+    ctx.p_hdr = (const sai_fib_snapshot_hdr_t *) p_buf;
+
+    ctx.ap_vrf = (sai_fib_vrf_t **) sai_fib_snapshot_node_array_alloc (
+                   sai_fib_snapshot_count_get (&ctx, SAI_FIB_SNAPSHOT_SECTION_VRF));
+    ctx.ap_rif = (sai_fib_router_interface_t **) sai_fib_snapshot_node_array_alloc (
+                   sai_fib_snapshot_count_get (&ctx, SAI_FIB_SNAPSHOT_SECTION_RIF));
+    ctx.ap_nh = (sai_fib_nh_t **) sai_fib_snapshot_node_array_alloc (
+                   sai_fib_snapshot_count_get (&ctx, SAI_FIB_SNAPSHOT_SECTION_NH));
+    ctx.ap_group = (sai_fib_nh_group_t **) sai_fib_snapshot_node_array_alloc (
+                   sai_fib_snapshot_count_get (&ctx, SAI_FIB_SNAPSHOT_SECTION_NH_GROUP));
+    ctx.ap_route = (sai_fib_route_t **) sai_fib_snapshot_node_array_alloc (
+                   sai_fib_snapshot_count_get (&ctx, SAI_FIB_SNAPSHOT_SECTION_ROUTE));
+
+    do {
+        if ((ctx.ap_vrf == NULL) || (ctx.ap_rif == NULL) || (ctx.ap_nh == NULL) ||
+            (ctx.ap_group == NULL) || (ctx.ap_route == NULL)) {
+
+            status = SAI_STATUS_NO_MEMORY;
+            break;
+        }
+
+        if (((status = sai_fib_snapshot_vrf_load (&ctx)) != SAI_STATUS_SUCCESS) ||
+            ((status = sai_fib_snapshot_rif_load (&ctx)) != SAI_STATUS_SUCCESS) ||
+            ((status = sai_fib_snapshot_nh_load (&ctx)) != SAI_STATUS_SUCCESS) ||
+            ((status = sai_fib_snapshot_group_load (&ctx)) != SAI_STATUS_SUCCESS) ||
+            ((status = sai_fib_snapshot_route_load (&ctx)) != SAI_STATUS_SUCCESS)) {
+            break;
+        }
+    } while (0);
+
+    if (status != SAI_STATUS_SUCCESS) {
+        SAI_ROUTER_LOG_ERR ("Failed to load FIB snapshot, status: %d.", status);
+
+        sai_fib_snapshot_load_cleanup (&ctx);
+    } else {
+        SAI_ROUTER_LOG_INFO ("Loaded FIB snapshot, VRFs: %d, RIFs: %d, "
+                             "Next Hops: %d, Groups: %d, Routes: %d.",
+                             ctx.num_linked [SAI_FIB_SNAPSHOT_SECTION_VRF],
+                             ctx.num_linked [SAI_FIB_SNAPSHOT_SECTION_RIF],
+                             ctx.num_linked [SAI_FIB_SNAPSHOT_SECTION_NH],
+                             ctx.num_linked [SAI_FIB_SNAPSHOT_SECTION_NH_GROUP],
+                             ctx.num_linked [SAI_FIB_SNAPSHOT_SECTION_ROUTE]);
+    }
+
+    free (ctx.ap_vrf);
+    free (ctx.ap_rif);
+    free (ctx.ap_nh);
+    free (ctx.ap_group);
+    free (ctx.ap_route);
+
+    return status;
+}
+
+sai_status_t sai_fib_snapshot_save (const char *p_file_name)
+{
+    char          tmp_file_name [SAI_FIB_MAX_BUFSZ];
+    uint8_t      *p_buf = NULL;
+    size_t        len = 0;
+    size_t        written = 0;
+    ssize_t       rc;
+    int           fd;
+    sai_status_t  status;
+
+    if ((p_file_name == NULL) ||
+        (snprintf (tmp_file_name, sizeof (tmp_file_name), "%s.tmp",
+                   p_file_name) >= (int) sizeof (tmp_file_name))) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    sai_fib_read_lock ();
+
+    sai_fib_snapshot_len_get (&len);
+
+    p_buf = (uint8_t *) malloc (len);
+
+    if (p_buf == NULL) {
+        sai_fib_read_unlock ();
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    status = sai_fib_snapshot_serialize (p_buf, len, &len);
+
+    sai_fib_read_unlock ();
+
+    if (status != SAI_STATUS_SUCCESS) {
+        free (p_buf);
+
+        return status;
+    }
+
+    /* Write a temporary file and rename it, so that a previous snapshot is
+     * never left truncated */
+    fd = open (tmp_file_name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0) {
+        SAI_ROUTER_LOG_ERR ("Failed to open FIB snapshot file %s.",
+                            tmp_file_name);
+        free (p_buf);
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    while (written < len) {
+
+        rc = write (fd, p_buf + written, len - written);
+
+        if (rc <= 0) {
+            status = SAI_STATUS_FAILURE;
+            break;
+        }
+
+        written += rc;
+    }
+
+    if ((status == SAI_STATUS_SUCCESS) && (fsync (fd) != 0)) {
+        status = SAI_STATUS_FAILURE;
+    }
+
+    close (fd);
+    free (p_buf);
+
+    if ((status != SAI_STATUS_SUCCESS) ||
+        (rename (tmp_file_name, p_file_name) != 0)) {
+
+        SAI_ROUTER_LOG_ERR ("Failed to write FIB snapshot file %s.",
+                            p_file_name);
+        unlink (tmp_file_name);
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    SAI_ROUTER_LOG_INFO ("Saved FIB snapshot of %zu bytes in %s.", len,
+                         p_file_name);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_fib_snapshot_load (const char *p_file_name)
+{
+    struct stat   file_stat;
+    void         *p_map = NULL;
+    int           fd;
+    sai_status_t  status;
+
+    if (p_file_name == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    fd = open (p_file_name, O_RDONLY);
+
+    if (fd < 0) {
+        SAI_ROUTER_LOG_ERR ("Failed to open FIB snapshot file %s.",
+                            p_file_name);
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    if ((fstat (fd, &file_stat) != 0) ||
+        (file_stat.st_size < (off_t) sizeof (sai_fib_snapshot_hdr_t))) {
+        close (fd);
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    p_map = mmap (NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    close (fd);
+
+    if (p_map == MAP_FAILED) {
+        SAI_ROUTER_LOG_ERR ("Failed to map FIB snapshot file %s.", p_file_name);
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    sai_fib_lock ();
+
+    status = sai_fib_snapshot_deserialize ((const uint8_t *) p_map,
+                                           file_stat.st_size);
+
+    sai_fib_unlock ();
+
+    munmap (p_map, file_stat.st_size);
+
+    return status;
+}
@@ -17,9 +17,12 @@
 
 #include "sai_l3_util.h"
 #include "sai_l3_common.h"
+#include "sai_l3_nh_hash.h"
+#include "sai_l3_nh_group_bucket.h"
 #include "sai_oid_utils.h"
 #include "sai_port_common.h"
 #include "sai_port_utils.h"
+#include "sai_fdb_api.h"
 #include "sairoute.h"
 #include "saiswitch.h"
 #include "sairouterintf.h"
@@ -29,7 +32,12 @@
 #include "std_type_defs.h"
 #include "std_ip_utils.h"
 #include <string.h>
+#include <stdlib.h>
 #include <arpa/inet.h>
+#include <inttypes.h>
+
+/* NPU Neighbor API table used for the FDB event based neighbor updates */
+static const sai_npu_neighbor_api_t *p_sai_fib_fdb_binding_neighbor_api = NULL;
 
 static sai_mac_t g_zero_mac = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
 
@@ -108,6 +116,50 @@ sai_fib_nh_group_t* sai_fib_next_hop_group_get (sai_object_id_t id)
                                                         &group_entry));
 }
 
+sai_fib_nh_group_t *sai_fib_nh_group_node_alloc (sai_object_id_t group_id,
+                                                 sai_next_hop_group_type_t type,
+                                                 uint_t num_buckets)
+{
+    sai_fib_nh_group_t *p_group = NULL;
+
+    p_group = (sai_fib_nh_group_t *) calloc (1, sizeof (sai_fib_nh_group_t));
+
+    if (p_group == NULL) {
+        SAI_NH_GROUP_LOG_CRIT ("Failed to allocate NH Group node.");
+
+        return NULL;
+    }
+
+    p_group->key.group_id = group_id;
+    p_group->type         = type;
+
+    std_dll_init (&p_group->nh_list);
+
+    if ((num_buckets) &&
+        (sai_fib_nh_group_bucket_table_create (p_group, num_buckets) !=
+         SAI_STATUS_SUCCESS)) {
+        SAI_NH_GROUP_LOG_ERR ("Failed to build the bucket table of NH Group "
+                              "0x%"PRIx64".", group_id);
+
+        free (p_group);
+
+        return NULL;
+    }
+
+    return p_group;
+}
+
+void sai_fib_nh_group_node_free (sai_fib_nh_group_t *p_group)
+{
+    if (p_group == NULL) {
+        return;
+    }
+
+    sai_fib_nh_group_bucket_table_destroy (p_group);
+
+    free (p_group);
+}
+
 sai_fib_nh_t* sai_fib_next_hop_node_get_from_id (sai_object_id_t nh_id)
 {
     rbtree_handle  nh_id_tree;
@@ -142,6 +194,17 @@ sai_fib_nh_t* sai_fib_ip_next_hop_node_get (sai_object_id_t rif_id,
         return NULL;
     }
 
+    if (sai_fib_nh_hash_is_init ()) {
+
+        p_nh_node = sai_fib_nh_hash_lookup (rif_id, &p_ip_nh_key->ip_addr);
+
+        if (p_nh_node) {
+            return p_nh_node;
+        }
+    }
+
+    /* Next hops inserted in the radix tree outside of
+     * sai_fib_nh_tree_insert() are not in the hash index */
     p_vrf_node = sai_fib_get_vrf_node_for_rif (rif_id);
 
     if (p_vrf_node) {
@@ -155,6 +218,147 @@ sai_fib_nh_t* sai_fib_ip_next_hop_node_get (sai_object_id_t rif_id,
     return p_nh_node;
 }
 
+/* Estimated radix tree branch node bytes charged per inserted node */
+#define SAI_FIB_MEM_STATS_RADIX_NODE_BYTES  (sizeof (std_rt_head))
+
+static inline void sai_fib_mem_stats_bytes_update (uint64_t *p_bytes,
+                                                   uint64_t bytes, bool is_add)
+{
+    if (is_add) {
+        (*p_bytes) += bytes;
+    } else {
+        (*p_bytes) = ((*p_bytes) > bytes) ? ((*p_bytes) - bytes) : 0;
+    }
+}
+
+static inline void sai_fib_mem_stats_update (uint_t *p_count, uint64_t *p_bytes,
+                                             uint64_t bytes, bool is_add)
+{
+    if (is_add) {
+        (*p_count)++;
+    } else if (*p_count) {
+        (*p_count)--;
+    } else {
+        return;
+    }
+
+    sai_fib_mem_stats_bytes_update (p_bytes, bytes, is_add);
+}
+
+static void sai_fib_rif_nh_owner_stats_update (sai_fib_rif_mem_stats_t *p_rif_stats,
+                                               uint_t owner_flag, bool is_add)
+{
+    if (owner_flag & (0x1 << SAI_FIB_OWNER_NEXT_HOP)) {
+        sai_fib_mem_stats_update (&p_rif_stats->num_nh, &p_rif_stats->bytes,
+                                  0, is_add);
+    }
+
+    if (owner_flag & (0x1 << SAI_FIB_OWNER_NEIGHBOR)) {
+        sai_fib_mem_stats_update (&p_rif_stats->num_neighbors,
+                                  &p_rif_stats->bytes, 0, is_add);
+    }
+}
+
+static void sai_fib_vrf_nh_mem_stats_update (sai_fib_vrf_t *p_vrf_node,
+                                             sai_fib_nh_t *p_next_hop,
+                                             bool is_add)
+{
+    sai_fib_vrf_mem_stats_t    *p_stats = &p_vrf_node->mem_stats;
+    sai_fib_router_interface_t *p_rif_node = NULL;
+    sai_fib_rif_mem_stats_t    *p_rif_stats = NULL;
+
+    sai_fib_mem_stats_update (&p_stats->num_nh, &p_stats->nh_bytes,
+                              sizeof (sai_fib_nh_t), is_add);
+
+    sai_fib_mem_stats_bytes_update (&p_stats->radix_bytes,
+                                    SAI_FIB_MEM_STATS_RADIX_NODE_BYTES, is_add);
+
+    p_rif_node = sai_fib_router_interface_node_get (p_next_hop->key.rif_id);
+
+    if (p_rif_node == NULL) {
+        return;
+    }
+
+    p_rif_stats = &p_rif_node->mem_stats;
+
+    /* Count from the owners recorded at insert, the owner flag may have
+     * been cleared by the time the node is removed. */
+    if (is_add) {
+        p_next_hop->mem_stats_owner_flag = p_next_hop->owner_flag;
+    }
+
+    sai_fib_rif_nh_owner_stats_update (p_rif_stats,
+                                       p_next_hop->mem_stats_owner_flag,
+                                       is_add);
+
+    if (!is_add) {
+        p_next_hop->mem_stats_owner_flag = 0;
+    }
+
+    sai_fib_mem_stats_bytes_update (&p_rif_stats->bytes, sizeof (sai_fib_nh_t),
+                                    is_add);
+}
+
+void sai_fib_nh_mem_stats_owner_sync (sai_fib_nh_t *p_next_hop)
+{
+    sai_fib_router_interface_t *p_rif_node = NULL;
+
+    if (p_next_hop->mem_stats_owner_flag == p_next_hop->owner_flag) {
+        return;
+    }
+
+    p_rif_node = sai_fib_router_interface_node_get (p_next_hop->key.rif_id);
+
+    if (p_rif_node != NULL) {
+        sai_fib_rif_nh_owner_stats_update (&p_rif_node->mem_stats,
+                                           p_next_hop->mem_stats_owner_flag,
+                                           false);
+        sai_fib_rif_nh_owner_stats_update (&p_rif_node->mem_stats,
+                                           p_next_hop->owner_flag, true);
+    }
+
+    p_next_hop->mem_stats_owner_flag = p_next_hop->owner_flag;
+}
+
+sai_status_t sai_fib_nh_tree_insert (sai_fib_vrf_t *p_vrf_node,
+                                     sai_fib_nh_t *p_next_hop)
+{
+    sai_status_t status;
+
+    p_next_hop->rt_head.rth_addr = (uint8_t *) &p_next_hop->key;
+
+    if (std_radix_insert (p_vrf_node->sai_nh_tree, &p_next_hop->rt_head,
+                          SAI_FIB_NH_IP_ADDR_TREE_KEY_LEN) !=
+        &p_next_hop->rt_head) {
+        return SAI_STATUS_FAILURE;
+    }
+
+    if (sai_fib_nh_hash_is_init ()) {
+
+        status = sai_fib_nh_hash_insert (p_next_hop);
+
+        if (status != SAI_STATUS_SUCCESS) {
+            std_radix_remove (p_vrf_node->sai_nh_tree, &p_next_hop->rt_head);
+
+            return status;
+        }
+    }
+
+    sai_fib_vrf_nh_mem_stats_update (p_vrf_node, p_next_hop, true);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_fib_nh_tree_remove (sai_fib_vrf_t *p_vrf_node,
+                             sai_fib_nh_t *p_next_hop)
+{
+    sai_fib_nh_hash_remove (p_next_hop);
+
+    std_radix_remove (p_vrf_node->sai_nh_tree, &p_next_hop->rt_head);
+
+    sai_fib_vrf_nh_mem_stats_update (p_vrf_node, p_next_hop, false);
+}
+
 sai_fib_wt_link_node_t *sai_fib_nh_find_group_link_node (
                                                 sai_fib_nh_t *p_nh_node,
                                                 sai_fib_nh_group_t *p_nh_group)
@@ -476,3 +680,404 @@ sai_fib_nh_t* sai_fib_get_next_neighbor_from_mac_entry (
     }
 }
 
+sai_status_t sai_fib_neighbor_mac_entry_port_update (
+                                const sai_npu_neighbor_api_t *p_neighbor_api,
+                                const sai_fib_neighbor_mac_entry_key_t *p_key,
+                                sai_object_id_t port_id, uint_t *p_count)
+{
+    sai_fib_neighbor_mac_entry_t *p_mac_entry = NULL;
+    sai_fib_nh_t                 *p_neighbor = NULL;
+    sai_object_id_t               old_port_id;
+    sai_status_t                  status = SAI_STATUS_SUCCESS;
+    sai_status_t                  rc;
+    uint_t                        count = 0;
+
+    if ((p_neighbor_api == NULL) || (p_key == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (p_count) {
+        *p_count = 0;
+    }
+
+    p_mac_entry = sai_fib_neighbor_mac_entry_find (p_key);
+
+    if (p_mac_entry == NULL) {
+        /* No neighbor is bound to the MAC */
+        return SAI_STATUS_SUCCESS;
+    }
+
+    for (p_neighbor = sai_fib_get_first_neighbor_from_mac_entry (p_mac_entry);
+         p_neighbor != NULL;
+         p_neighbor = sai_fib_get_next_neighbor_from_mac_entry (p_mac_entry,
+                                                                p_neighbor)) {
+        if (p_neighbor->port_id != port_id) {
+            count++;
+        }
+    }
+
+    if (count == 0) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if (p_neighbor_api->neighbor_mac_entry_port_update) {
+
+        status = p_neighbor_api->neighbor_mac_entry_port_update (p_mac_entry,
+                                                                 port_id);
+
+        if (status != SAI_STATUS_SUCCESS) {
+            SAI_NEIGHBOR_LOG_ERR ("Failed to update port 0x%"PRIx64" in NPU "
+                                  "for neighbor MAC entry on VLAN %d, "
+                                  "status: %d.", port_id, p_key->vlan_id,
+                                  status);
+
+            return status;
+        }
+
+        for (p_neighbor = sai_fib_get_first_neighbor_from_mac_entry (p_mac_entry);
+             p_neighbor != NULL;
+             p_neighbor = sai_fib_get_next_neighbor_from_mac_entry (p_mac_entry,
+                                                                    p_neighbor)) {
+            p_neighbor->port_id = port_id;
+        }
+
+    } else if (p_neighbor_api->neighbor_attr_set) {
+
+        count = 0;
+
+        for (p_neighbor = sai_fib_get_first_neighbor_from_mac_entry (p_mac_entry);
+             p_neighbor != NULL;
+             p_neighbor = sai_fib_get_next_neighbor_from_mac_entry (p_mac_entry,
+                                                                    p_neighbor)) {
+            if (p_neighbor->port_id == port_id) {
+                continue;
+            }
+
+            old_port_id = p_neighbor->port_id;
+            p_neighbor->port_id = port_id;
+
+            rc = p_neighbor_api->neighbor_attr_set (p_neighbor,
+                                            SAI_FIB_NEIGHBOR_PORT_ID_ATTR_FLAG);
+
+            if (rc != SAI_STATUS_SUCCESS) {
+                SAI_NEIGHBOR_LOG_ERR ("Failed to update port 0x%"PRIx64" in "
+                                      "NPU for neighbor %p, status: %d.",
+                                      port_id, p_neighbor, rc);
+
+                p_neighbor->port_id = old_port_id;
+                status = rc;
+
+                continue;
+            }
+
+            count++;
+        }
+    } else {
+        return SAI_STATUS_NOT_SUPPORTED;
+    }
+
+    SAI_NEIGHBOR_LOG_TRACE ("Updated port 0x%"PRIx64" for %d neighbor(s) on "
+                            "VLAN %d.", port_id, count, p_key->vlan_id);
+
+    if (p_count) {
+        *p_count = count;
+    }
+
+    return status;
+}
+
+/* Re-reads the FDB port of every neighbor MAC entry, used when FDB changes
+ * were lost. Called with the FIB lock held, the FDB lock is taken per entry */
+static void sai_fib_neighbor_fdb_resync (void)
+{
+    sai_fib_neighbor_mac_entry_key_t  key;
+    sai_fib_neighbor_mac_entry_t     *p_mac_entry = NULL;
+    sai_fdb_entry_t                   fdb_entry;
+    sai_object_id_t                   port_id;
+
+    SAI_NEIGHBOR_LOG_INFO ("Resyncing neighbor ports with the FDB.");
+
+    memset (&key, 0, sizeof (sai_fib_neighbor_mac_entry_key_t));
+
+    p_mac_entry = (sai_fib_neighbor_mac_entry_t *) std_radix_getexact (
+                             sai_fib_access_global_config()->neighbor_mac_tree,
+                             (uint8_t *) &key,
+                             SAI_FIB_NEIGHBOR_MAC_ENTRY_TREE_KEY_LEN);
+
+    if (p_mac_entry == NULL) {
+
+        p_mac_entry = (sai_fib_neighbor_mac_entry_t *) std_radix_getnext (
+                             sai_fib_access_global_config()->neighbor_mac_tree,
+                             (uint8_t *) &key,
+                             SAI_FIB_NEIGHBOR_MAC_ENTRY_TREE_KEY_LEN);
+    }
+
+    while (p_mac_entry) {
+
+        memcpy (&key, &p_mac_entry->key, sizeof (sai_fib_neighbor_mac_entry_key_t));
+
+        memset (&fdb_entry, 0, sizeof (sai_fdb_entry_t));
+        fdb_entry.vlan_id = key.vlan_id;
+        memcpy (&fdb_entry.mac_address, &key.mac_addr, sizeof (sai_mac_t));
+
+        sai_fdb_lock ();
+
+        if (sai_fdb_get_port_from_cache (&fdb_entry, &port_id) !=
+            SAI_STATUS_SUCCESS) {
+            port_id = SAI_NULL_OBJECT_ID;
+        }
+
+        sai_fdb_unlock ();
+
+        sai_fib_neighbor_mac_entry_port_update (p_sai_fib_fdb_binding_neighbor_api,
+                                                &key, port_id, NULL);
+
+        p_mac_entry = (sai_fib_neighbor_mac_entry_t *) std_radix_getnext (
+                             sai_fib_access_global_config()->neighbor_mac_tree,
+                             (uint8_t *) &key,
+                             SAI_FIB_NEIGHBOR_MAC_ENTRY_TREE_KEY_LEN);
+    }
+}
+
+/* Called without the FDB lock, the FIB lock is taken once for all the
+ * changes of a batch */
+static void sai_fib_neighbor_fdb_entry_change_handler (
+                                  uint_t num_changes,
+                                  const sai_fdb_notification_data_t *p_change_list,
+                                  bool resync)
+{
+    sai_fib_neighbor_mac_entry_key_t key;
+    sai_object_id_t                  port_id;
+    uint_t                           index;
+
+    if (p_sai_fib_fdb_binding_neighbor_api == NULL) {
+        return;
+    }
+
+    sai_fib_lock ();
+
+    for (index = 0; index < num_changes; index++) {
+
+        memset (&key, 0, sizeof (sai_fib_neighbor_mac_entry_key_t));
+
+        key.vlan_id = p_change_list [index].fdb_entry.vlan_id;
+        memcpy (&key.mac_addr, &p_change_list [index].fdb_entry.mac_address,
+                sizeof (sai_mac_t));
+
+        port_id = (p_change_list [index].fdb_event == SAI_FDB_EVENT_LEARNED) ?
+                  p_change_list [index].port_id : SAI_NULL_OBJECT_ID;
+
+        sai_fib_neighbor_mac_entry_port_update (p_sai_fib_fdb_binding_neighbor_api,
+                                                &key, port_id, NULL);
+    }
+
+    if (resync) {
+        sai_fib_neighbor_fdb_resync ();
+    }
+
+    sai_fib_unlock ();
+}
+
+void sai_fib_neighbor_fdb_binding_set (
+                                const sai_npu_neighbor_api_t *p_neighbor_api)
+{
+    p_sai_fib_fdb_binding_neighbor_api = p_neighbor_api;
+
+    sai_fdb_entry_change_listener_set ((p_neighbor_api) ?
+                                     sai_fib_neighbor_fdb_entry_change_handler :
+                                     NULL);
+}
+
+static sai_fib_route_stats_nh_type_t sai_fib_route_stats_nh_type_get (
+                                                const sai_fib_route_t *p_route)
+{
+    if (p_route->nh_type == SAI_OBJECT_TYPE_NEXT_HOP) {
+        return SAI_FIB_ROUTE_STATS_NH_TYPE_NEXT_HOP;
+    } else if (p_route->nh_type == SAI_OBJECT_TYPE_NEXT_HOP_GROUP) {
+        return SAI_FIB_ROUTE_STATS_NH_TYPE_NEXT_HOP_GROUP;
+    } else {
+        return SAI_FIB_ROUTE_STATS_NH_TYPE_NONE;
+    }
+}
+
+static inline void sai_fib_route_stats_counter_update (uint_t *p_counter,
+                                                       bool is_add)
+{
+    if (is_add) {
+        (*p_counter)++;
+    } else if (*p_counter) {
+        (*p_counter)--;
+    }
+}
+
+void sai_fib_vrf_route_stats_update (sai_fib_vrf_t *p_vrf_node,
+                                     const sai_fib_route_t *p_route,
+                                     bool is_add)
+{
+    sai_fib_vrf_route_stats_t *p_stats = NULL;
+
+    if ((p_vrf_node == NULL) || (p_route == NULL)) {
+        return;
+    }
+
+    p_stats = &p_vrf_node->route_stats;
+
+    if (p_route->key.prefix.addr_family == SAI_IP_ADDR_FAMILY_IPV4) {
+
+        sai_fib_route_stats_counter_update (&p_stats->num_v4_routes, is_add);
+
+        if (p_route->prefix_len < SAI_FIB_V4_PREFIX_LEN_COUNT) {
+            sai_fib_route_stats_counter_update (
+                   &p_stats->v4_prefix_len_count [p_route->prefix_len], is_add);
+        }
+    } else {
+
+        sai_fib_route_stats_counter_update (&p_stats->num_v6_routes, is_add);
+
+        if (p_route->prefix_len < SAI_FIB_V6_PREFIX_LEN_COUNT) {
+            sai_fib_route_stats_counter_update (
+                   &p_stats->v6_prefix_len_count [p_route->prefix_len], is_add);
+        }
+    }
+
+    sai_fib_route_stats_counter_update (
+          &p_stats->nh_type_count [sai_fib_route_stats_nh_type_get (p_route)],
+          is_add);
+
+    if ((uint_t) p_route->packet_action < SAI_FIB_ROUTE_STATS_PKT_ACTION_COUNT) {
+        sai_fib_route_stats_counter_update (
+                  &p_stats->pkt_action_count [p_route->packet_action], is_add);
+    }
+
+    sai_fib_mem_stats_update (&p_vrf_node->mem_stats.num_routes,
+                              &p_vrf_node->mem_stats.route_bytes,
+                              sizeof (sai_fib_route_t), is_add);
+
+    sai_fib_mem_stats_bytes_update (&p_vrf_node->mem_stats.radix_bytes,
+                                    SAI_FIB_MEM_STATS_RADIX_NODE_BYTES, is_add);
+}
+
+sai_status_t sai_fib_vrf_route_stats_get (sai_object_id_t vrf_id,
+                                          sai_fib_vrf_route_stats_t *p_stats)
+{
+    sai_fib_vrf_t *p_vrf_node = NULL;
+
+    if (p_stats == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    p_vrf_node = sai_fib_vrf_node_get (vrf_id);
+
+    if (p_vrf_node == NULL) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    memcpy (p_stats, &p_vrf_node->route_stats,
+            sizeof (sai_fib_vrf_route_stats_t));
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_fib_neighbor_mac_entry_mem_stats_update (
+                                    sai_fib_neighbor_mac_entry_t *p_mac_entry,
+                                    bool is_add)
+{
+    sai_fib_vrf_t           *p_vrf_node = NULL;
+    sai_fib_vrf_mem_stats_t *p_stats = NULL;
+
+    if (p_mac_entry == NULL) {
+        return;
+    }
+
+    p_vrf_node = sai_fib_vrf_node_get (p_mac_entry->vrf_id);
+
+    if (p_vrf_node == NULL) {
+        return;
+    }
+
+    p_stats = &p_vrf_node->mem_stats;
+
+    sai_fib_mem_stats_update (&p_stats->num_neighbor_mac_entries,
+                              &p_stats->neighbor_mac_entry_bytes,
+                              sizeof (sai_fib_neighbor_mac_entry_t), is_add);
+
+    sai_fib_mem_stats_bytes_update (&p_stats->radix_bytes,
+                                    SAI_FIB_MEM_STATS_RADIX_NODE_BYTES, is_add);
+}
+
+sai_status_t sai_fib_vrf_mem_stats_get (sai_object_id_t vrf_id,
+                                        sai_fib_vrf_mem_stats_t *p_stats)
+{
+    sai_fib_vrf_t *p_vrf_node = NULL;
+
+    if (p_stats == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    p_vrf_node = sai_fib_vrf_node_get (vrf_id);
+
+    if (p_vrf_node == NULL) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    memcpy (p_stats, &p_vrf_node->mem_stats, sizeof (sai_fib_vrf_mem_stats_t));
+
+    return SAI_STATUS_SUCCESS;
+}
+
+uint64_t sai_fib_vrf_mem_stats_total_bytes_get (
+                                        const sai_fib_vrf_mem_stats_t *p_stats)
+{
+    return (p_stats->route_bytes + p_stats->nh_bytes +
+            p_stats->neighbor_mac_entry_bytes + p_stats->radix_bytes);
+}
+
+sai_status_t sai_fib_rif_mem_stats_get (sai_object_id_t rif_id,
+                                        sai_fib_rif_mem_stats_t *p_stats)
+{
+    sai_fib_router_interface_t *p_rif_node = NULL;
+
+    if (p_stats == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    p_rif_node = sai_fib_router_interface_node_get (rif_id);
+
+    if (p_rif_node == NULL) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    memcpy (p_stats, &p_rif_node->mem_stats, sizeof (sai_fib_rif_mem_stats_t));
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_fib_route_t *sai_fib_route_get_first (sai_fib_vrf_t *p_vrf_node)
+{
+    sai_fib_route_key_t key;
+    sai_fib_route_t    *p_route = NULL;
+
+    memset (&key, 0, sizeof (sai_fib_route_key_t));
+
+    p_route = (sai_fib_route_t *)
+              std_radix_getexact (p_vrf_node->sai_route_tree, (uint8_t *) &key,
+                                  sai_fib_route_key_len_get (0));
+
+    if (p_route == NULL) {
+        p_route = (sai_fib_route_t *)
+                  std_radix_getnext (p_vrf_node->sai_route_tree,
+                                     (uint8_t *) &key,
+                                     sai_fib_route_key_len_get (0));
+    }
+
+    return p_route;
+}
+
+sai_fib_route_t *sai_fib_route_get_next (sai_fib_vrf_t *p_vrf_node,
+                                         sai_fib_route_t *p_route)
+{
+    return ((sai_fib_route_t *)
+            std_radix_getnext (p_vrf_node->sai_route_tree,
+                               (uint8_t *) &p_route->key,
+                               sai_fib_route_key_len_get (p_route->prefix_len)));
+}
@@ -0,0 +1,589 @@
+/************************************************************************
+* LEGALESE:   "Copyright (c) 2015, Dell Inc. All rights reserved."
+*
+* This source code is confidential, proprietary, and contains trade
+* secrets that are the sole property of Dell Inc.
+* Copy and/or distribution of this source code or disassembly or reverse
+* engineering of the resultant object code are strictly forbidden without
+* the written consent of Dell Inc.
+*
+************************************************************************/
+/**
+* @file sai_hash_sim.c
+*
+* @brief This file contains the software LAG and ECMP hash simulator used
+*        to predict the load distribution of a traffic mix.
+*
+*************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arpa/inet.h>
+
+#include "saitypes.h"
+#include "saistatus.h"
+#include "saihash.h"
+#include "std_assert.h"
+
+#include "sai_hash_sim.h"
+#include "sai_hash_object.h"
+#include "sai_switch_utils.h"
+
+#define SAI_HASH_SIM_CRC16_POLY         (0x1021)
+#define SAI_HASH_SIM_CRC32C_POLY        (0x82f63b78)
+#define SAI_HASH_SIM_TRACE_LINE_LEN     (512)
+#define SAI_HASH_SIM_TRACE_DFLT_FLOWS   (1024)
+
+#define SAI_HASH_SIM_FIELD_IS_SET(_mask, _field) \
+        (((_mask) >> (_field)) & 0x1)
+
+static uint16_t sai_hash_sim_crc16_table [256];
+static uint32_t sai_hash_sim_crc32_table [256];
+static bool     sai_hash_sim_tables_init = false;
+
+static void sai_hash_sim_crc_tables_init(void)
+{
+    uint_t   index;
+    uint_t   bit;
+    uint16_t crc16;
+    uint32_t crc32;
+
+    if(sai_hash_sim_tables_init) {
+        return;
+    }
+
+    for(index = 0; index < 256; index++) {
+        crc16 = (uint16_t)(index << 8);
+        crc32 = index;
+
+        for(bit = 0; bit < 8; bit++) {
+            crc16 = (crc16 & 0x8000) ?
+                    (uint16_t)((crc16 << 1) ^ SAI_HASH_SIM_CRC16_POLY) :
+                    (uint16_t)(crc16 << 1);
+            crc32 = (crc32 & 0x1) ?
+                    ((crc32 >> 1) ^ SAI_HASH_SIM_CRC32C_POLY) : (crc32 >> 1);
+        }
+        sai_hash_sim_crc16_table[index] = crc16;
+        sai_hash_sim_crc32_table[index] = crc32;
+    }
+    sai_hash_sim_tables_init = true;
+}
+
+static inline uint_t sai_hash_sim_ip_addr_pack(const sai_ip_address_t *ip_addr,
+                                               uint8_t *key)
+{
+    if(ip_addr->addr_family == SAI_IP_ADDR_FAMILY_IPV6) {
+        memcpy(key, ip_addr->addr.ip6, sizeof(sai_ip6_t));
+        return sizeof(sai_ip6_t);
+    }
+    memcpy(key, &ip_addr->addr.ip4, sizeof(sai_ip4_t));
+    return sizeof(sai_ip4_t);
+}
+
+static inline uint_t sai_hash_sim_u16_pack(uint16_t value, uint8_t *key)
+{
+    key[0] = (uint8_t)(value >> 8);
+    key[1] = (uint8_t)value;
+    return sizeof(uint16_t);
+}
+
+/* Pack the hashed fields of a flow in the order of the field values */
+static uint_t sai_hash_sim_key_build(uint32_t field_mask,
+                                     const sai_hash_sim_flow_t *flow,
+                                     uint8_t *key)
+{
+    uint_t len = 0;
+
+    if(SAI_HASH_SIM_FIELD_IS_SET(field_mask, SAI_NATIVE_HASH_FIELD_SRC_IP)) {
+        len += sai_hash_sim_ip_addr_pack(&flow->src_ip, &key[len]);
+    }
+    if(SAI_HASH_SIM_FIELD_IS_SET(field_mask, SAI_NATIVE_HASH_FIELD_DST_IP)) {
+        len += sai_hash_sim_ip_addr_pack(&flow->dst_ip, &key[len]);
+    }
+    if(SAI_HASH_SIM_FIELD_IS_SET(field_mask, SAI_NATIVE_HASH_FIELD_VLAN_ID)) {
+        len += sai_hash_sim_u16_pack(flow->vlan_id, &key[len]);
+    }
+    if(SAI_HASH_SIM_FIELD_IS_SET(field_mask, SAI_NATIVE_HASH_FIELD_IP_PROTOCOL)) {
+        key[len++] = flow->ip_protocol;
+    }
+    if(SAI_HASH_SIM_FIELD_IS_SET(field_mask, SAI_NATIVE_HASH_FIELD_ETHERTYPE)) {
+        len += sai_hash_sim_u16_pack(flow->ethertype, &key[len]);
+    }
+    if(SAI_HASH_SIM_FIELD_IS_SET(field_mask, SAI_NATIVE_HASH_FIELD_L4_SRC_PORT)) {
+        len += sai_hash_sim_u16_pack(flow->l4_src_port, &key[len]);
+    }
+    if(SAI_HASH_SIM_FIELD_IS_SET(field_mask, SAI_NATIVE_HASH_FIELD_L4_DST_PORT)) {
+        len += sai_hash_sim_u16_pack(flow->l4_dst_port, &key[len]);
+    }
+    if(SAI_HASH_SIM_FIELD_IS_SET(field_mask, SAI_NATIVE_HASH_FIELD_SRC_MAC)) {
+        memcpy(&key[len], flow->src_mac, sizeof(sai_mac_t));
+        len += sizeof(sai_mac_t);
+    }
+    if(SAI_HASH_SIM_FIELD_IS_SET(field_mask, SAI_NATIVE_HASH_FIELD_DST_MAC)) {
+        memcpy(&key[len], flow->dst_mac, sizeof(sai_mac_t));
+        len += sizeof(sai_mac_t);
+    }
+    if(SAI_HASH_SIM_FIELD_IS_SET(field_mask, SAI_NATIVE_HASH_FIELD_IN_PORT)) {
+        len += sai_hash_sim_u16_pack((uint16_t)(flow->in_port >> 16), &key[len]);
+        len += sai_hash_sim_u16_pack((uint16_t)flow->in_port, &key[len]);
+    }
+    return len;
+}
+
+static uint32_t sai_hash_sim_crc16_get(uint32_t seed, const uint8_t *key,
+                                       uint_t len)
+{
+    uint16_t crc = (uint16_t)seed;
+    uint_t   index;
+
+    for(index = 0; index < len; index++) {
+        crc = (uint16_t)((crc << 8) ^
+                         sai_hash_sim_crc16_table[((crc >> 8) ^ key[index]) & 0xff]);
+    }
+    return crc;
+}
+
+static uint32_t sai_hash_sim_crc32_get(uint32_t seed, const uint8_t *key,
+                                       uint_t len)
+{
+    uint32_t crc = ~seed;
+    uint_t   index;
+
+    for(index = 0; index < len; index++) {
+        crc = sai_hash_sim_crc32_table[(crc ^ key[index]) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+static uint32_t sai_hash_sim_xor_get(uint32_t seed, const uint8_t *key,
+                                     uint_t len)
+{
+    uint32_t hash = seed;
+    uint32_t word;
+    uint_t   index;
+
+    for(index = 0; index < len; index += sizeof(uint32_t)) {
+        word = 0;
+        memcpy(&word, &key[index],
+               ((len - index) < sizeof(uint32_t)) ? (len - index) : sizeof(uint32_t));
+        hash ^= word;
+    }
+    return (hash ^ (hash >> 16));
+}
+
+static sai_status_t sai_hash_sim_ip_addr_parse(const char *str,
+                                               sai_ip_address_t *ip_addr)
+{
+    if(inet_pton(AF_INET, str, &ip_addr->addr.ip4) == 1) {
+        ip_addr->addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+        return SAI_STATUS_SUCCESS;
+    }
+    if(inet_pton(AF_INET6, str, ip_addr->addr.ip6) == 1) {
+        ip_addr->addr_family = SAI_IP_ADDR_FAMILY_IPV6;
+        return SAI_STATUS_SUCCESS;
+    }
+    return SAI_STATUS_INVALID_PARAMETER;
+}
+
+static sai_status_t sai_hash_sim_mac_parse(const char *str, sai_mac_t mac)
+{
+    if(sscanf(str, "%hhx:%hhx:%hhx:%hhx:%hhx:%hhx", &mac[0], &mac[1], &mac[2],
+              &mac[3], &mac[4], &mac[5]) != sizeof(sai_mac_t)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Parse a trace line, returns SAI_STATUS_ITEM_NOT_FOUND if there is no flow
+ * in the line */
+static sai_status_t sai_hash_sim_trace_line_parse(char *line,
+                                                  sai_hash_sim_flow_t *flow)
+{
+    char    *save_ptr = NULL;
+    char    *token = NULL;
+    char    *end = NULL;
+    uint_t   field = 0;
+    unsigned long value;
+
+    memset(flow, 0, sizeof(*flow));
+
+    for(token = strtok_r(line, " \t\r\n", &save_ptr); token != NULL;
+        token = strtok_r(NULL, " \t\r\n", &save_ptr), field++) {
+
+        if((field == 0) && (token[0] == '#')) {
+            break;
+        }
+
+        if(field < 2) {
+            if(sai_hash_sim_ip_addr_parse(token, (field == 0) ? &flow->src_ip :
+                                          &flow->dst_ip) != SAI_STATUS_SUCCESS) {
+                return SAI_STATUS_INVALID_PARAMETER;
+            }
+            continue;
+        }
+
+        if(field >= 8) {
+            if((field > 9) ||
+               (sai_hash_sim_mac_parse(token, (field == 8) ? flow->src_mac :
+                                       flow->dst_mac) != SAI_STATUS_SUCCESS)) {
+                return SAI_STATUS_INVALID_PARAMETER;
+            }
+            continue;
+        }
+
+        value = strtoul(token, &end, 0);
+        if((end == token) || (*end != '\0')) {
+            return SAI_STATUS_INVALID_PARAMETER;
+        }
+
+        switch(field) {
+            case 2:
+                flow->ip_protocol = (uint8_t)value;
+                break;
+            case 3:
+                flow->l4_src_port = (uint16_t)value;
+                break;
+            case 4:
+                flow->l4_dst_port = (uint16_t)value;
+                break;
+            case 5:
+                flow->vlan_id = (uint16_t)value;
+                break;
+            case 6:
+                flow->in_port = (uint32_t)value;
+                break;
+            default:
+                flow->ethertype = (uint16_t)value;
+                break;
+        }
+    }
+
+    if(field == 0) {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+    return (field < 5) ? SAI_STATUS_INVALID_PARAMETER : SAI_STATUS_SUCCESS;
+}
+
+/***************************************************************************
+ *                          Public Functions
+ ***************************************************************************/
+sai_status_t sai_hash_sim_config_init(sai_hash_sim_algo_t algo, uint32_t seed,
+                                      const sai_s32_list_t *field_list,
+                                      uint_t num_members,
+                                      sai_hash_sim_config_t *config)
+{
+    uint_t index;
+
+    STD_ASSERT(field_list != NULL);
+    STD_ASSERT(config != NULL);
+
+    if((algo >= SAI_HASH_SIM_ALGO_MAX) || (num_members == 0) ||
+       (num_members > SAI_HASH_SIM_MAX_MEMBERS)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    sai_hash_sim_crc_tables_init();
+
+    memset(config, 0, sizeof(*config));
+    config->algo = algo;
+    config->seed = seed;
+    config->num_members = num_members;
+
+    for(index = 0; index < field_list->count; index++) {
+        if((field_list->list[index] >= 0) && (field_list->list[index] < 32)) {
+            config->field_mask |= (1u << field_list->list[index]);
+        }
+    }
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Map the switch hash algorithm to a simulator hash function. Algorithms the
+ * simulator cannot model, such as RANDOM, are rejected */
+static sai_status_t sai_hash_sim_algo_get(sai_hash_algorithm_t hash_algo,
+                                          sai_hash_sim_algo_t *algo)
+{
+    switch(hash_algo) {
+        case SAI_HASH_ALGORITHM_CRC:
+            /* Generic CRC of the SAI headers, modeled as CRC16-CCITT */
+            *algo = SAI_HASH_SIM_ALGO_CRC16;
+            return SAI_STATUS_SUCCESS;
+        case SAI_HASH_ALGORITHM_XOR:
+            *algo = SAI_HASH_SIM_ALGO_XOR;
+            return SAI_STATUS_SUCCESS;
+        default:
+            return SAI_STATUS_NOT_SUPPORTED;
+    }
+}
+
+sai_status_t sai_hash_sim_switch_config_get(bool is_lag,
+                                            const dn_sai_hash_object_t *hash_obj,
+                                            uint_t num_members,
+                                            sai_hash_sim_config_t *config)
+{
+    sai_switch_info_t      *sai_switch_info_ptr = sai_switch_info_get();
+    sai_int32_t             dflt_fields[SAI_SWITCH_DEFAULT_HASH_FIELDS_COUNT];
+    sai_s32_list_t          field_list;
+    sai_switch_hash_seed_t  seed = 0;
+    sai_hash_algorithm_t    hash_algo;
+    sai_hash_sim_algo_t     algo;
+    sai_status_t            sai_rc;
+
+    STD_ASSERT(sai_switch_info_ptr != NULL);
+
+    if(hash_obj != NULL) {
+        field_list = hash_obj->native_fields_list;
+    } else {
+        field_list.count = SAI_SWITCH_DEFAULT_HASH_FIELDS_COUNT;
+        field_list.list = dflt_fields;
+
+        sai_rc = sai_switch_default_native_hash_fields_get(&field_list);
+        if(sai_rc != SAI_STATUS_SUCCESS) {
+            return sai_rc;
+        }
+    }
+
+    if(is_lag) {
+        sai_rc = sai_switch_lag_hash_seed_value_get(&seed);
+        hash_algo = sai_switch_info_ptr->lag_hash_algo;
+    } else {
+        sai_rc = sai_switch_ecmp_hash_seed_value_get(&seed);
+        hash_algo = sai_switch_info_ptr->ecmp_hash_algo;
+    }
+    if(sai_rc != SAI_STATUS_SUCCESS) {
+        return sai_rc;
+    }
+
+    sai_rc = sai_hash_sim_algo_get(hash_algo, &algo);
+    if(sai_rc != SAI_STATUS_SUCCESS) {
+        return sai_rc;
+    }
+
+    return sai_hash_sim_config_init(algo, (uint32_t)seed, &field_list,
+                                    num_members, config);
+}
+
+uint32_t sai_hash_sim_flow_hash_get(const sai_hash_sim_config_t *config,
+                                    const sai_hash_sim_flow_t *flow)
+{
+    uint8_t key[SAI_HASH_SIM_MAX_KEY_LEN];
+    uint_t  len;
+
+    STD_ASSERT(config != NULL);
+    STD_ASSERT(flow != NULL);
+
+    len = sai_hash_sim_key_build(config->field_mask, flow, key);
+
+    switch(config->algo) {
+        case SAI_HASH_SIM_ALGO_CRC32:
+            return sai_hash_sim_crc32_get(config->seed, key, len);
+        case SAI_HASH_SIM_ALGO_XOR:
+            return sai_hash_sim_xor_get(config->seed, key, len);
+        default:
+            return sai_hash_sim_crc16_get(config->seed, key, len);
+    }
+}
+
+uint_t sai_hash_sim_flow_member_get(const sai_hash_sim_config_t *config,
+                                    const sai_hash_sim_flow_t *flow)
+{
+    return (sai_hash_sim_flow_hash_get(config, flow) % config->num_members);
+}
+
+sai_status_t sai_hash_sim_trace_load(const char *file_name,
+                                     sai_hash_sim_flow_t **flow_list,
+                                     uint_t *count)
+{
+    FILE                *fp = NULL;
+    sai_hash_sim_flow_t *flows = NULL;
+    sai_hash_sim_flow_t *new_flows = NULL;
+    char                 line[SAI_HASH_SIM_TRACE_LINE_LEN];
+    uint_t               max_flows = SAI_HASH_SIM_TRACE_DFLT_FLOWS;
+    uint_t               num_flows = 0;
+    uint_t               line_num = 0;
+    sai_status_t         sai_rc = SAI_STATUS_SUCCESS;
+
+    STD_ASSERT(file_name != NULL);
+    STD_ASSERT(flow_list != NULL);
+    STD_ASSERT(count != NULL);
+
+    fp = fopen(file_name, "r");
+    if(fp == NULL) {
+        SAI_HASH_LOG_ERR("Unable to open hash trace file %s", file_name);
+        return SAI_STATUS_FAILURE;
+    }
+
+    flows = (sai_hash_sim_flow_t *)calloc(max_flows, sizeof(sai_hash_sim_flow_t));
+    if(flows == NULL) {
+        fclose(fp);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    while(fgets(line, sizeof(line), fp) != NULL) {
+        line_num++;
+
+        if(num_flows == max_flows) {
+            new_flows = (sai_hash_sim_flow_t *)realloc(flows, 2 * max_flows *
+                                                       sizeof(sai_hash_sim_flow_t));
+            if(new_flows == NULL) {
+                sai_rc = SAI_STATUS_NO_MEMORY;
+                break;
+            }
+            flows = new_flows;
+            max_flows *= 2;
+        }
+
+        sai_rc = sai_hash_sim_trace_line_parse(line, &flows[num_flows]);
+        if(sai_rc == SAI_STATUS_ITEM_NOT_FOUND) {
+            sai_rc = SAI_STATUS_SUCCESS;
+            continue;
+        }
+        if(sai_rc != SAI_STATUS_SUCCESS) {
+            SAI_HASH_LOG_ERR("Invalid flow at line %d of hash trace file %s",
+                             line_num, file_name);
+            break;
+        }
+        num_flows++;
+    }
+    fclose(fp);
+
+    if(sai_rc != SAI_STATUS_SUCCESS) {
+        free(flows);
+        return sai_rc;
+    }
+
+    *flow_list = flows;
+    *count = num_flows;
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_hash_sim_distribution_get(const sai_hash_sim_config_t *config,
+                                           const sai_hash_sim_flow_t *flow_list,
+                                           uint_t count,
+                                           sai_hash_sim_result_t *result)
+{
+    uint_t index;
+    double mean;
+
+    STD_ASSERT(config != NULL);
+    STD_ASSERT(result != NULL);
+    STD_ASSERT(result->member_flow_count != NULL);
+
+    if((count > 0) && (flow_list == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    memset(result->member_flow_count, 0,
+           config->num_members * sizeof(result->member_flow_count[0]));
+
+    for(index = 0; index < count; index++) {
+        result->member_flow_count[sai_hash_sim_flow_member_get(config,
+                                                               &flow_list[index])]++;
+    }
+
+    result->num_members = config->num_members;
+    result->total_flows = count;
+    result->max_flows = 0;
+    result->min_flows = count;
+    result->unused_members = 0;
+
+    for(index = 0; index < config->num_members; index++) {
+        if(result->member_flow_count[index] > result->max_flows) {
+            result->max_flows = result->member_flow_count[index];
+        }
+        if(result->member_flow_count[index] < result->min_flows) {
+            result->min_flows = result->member_flow_count[index];
+        }
+        if(result->member_flow_count[index] == 0) {
+            result->unused_members++;
+        }
+    }
+
+    mean = (double)count / config->num_members;
+    result->max_to_mean_ratio = (count > 0) ? (result->max_flows / mean) : 0.0;
+    result->spread_pct = (count > 0) ?
+        (100.0 * (result->max_flows - result->min_flows) / mean) : 0.0;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_hash_sim_polarization_get(const sai_hash_sim_config_t *hop_list,
+                                           uint_t num_hops,
+                                           const sai_hash_sim_flow_t *flow_list,
+                                           uint_t count,
+                                           double *polarization_list)
+{
+    uint8_t  *pair_map[SAI_HASH_SIM_MAX_HOPS] = {NULL};
+    uint64_t *member_flow_count = NULL;
+    uint_t    member[SAI_HASH_SIM_MAX_HOPS];
+    uint_t    hop;
+    uint_t    index;
+    uint_t    num_members;
+    uint64_t  used_pairs;
+    uint64_t  possible_pairs;
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    STD_ASSERT(hop_list != NULL);
+    STD_ASSERT(polarization_list != NULL);
+
+    if((num_hops < 2) || (num_hops > SAI_HASH_SIM_MAX_HOPS) ||
+       ((count > 0) && (flow_list == NULL))) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    /* Flows per member of every hop but the last, and for each hop after
+     * the first a map of the used (previous hop member, member) pairs */
+    member_flow_count = (uint64_t *)calloc(num_hops * SAI_HASH_SIM_MAX_MEMBERS,
+                                           sizeof(uint64_t));
+    if(member_flow_count == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    for(hop = 1; hop < num_hops; hop++) {
+        pair_map[hop] = (uint8_t *)calloc(hop_list[hop - 1].num_members *
+                                          hop_list[hop].num_members, sizeof(uint8_t));
+        if(pair_map[hop] == NULL) {
+            sai_rc = SAI_STATUS_NO_MEMORY;
+            break;
+        }
+    }
+
+    for(index = 0; (sai_rc == SAI_STATUS_SUCCESS) && (index < count); index++) {
+        for(hop = 0; hop < num_hops; hop++) {
+            member[hop] = sai_hash_sim_flow_member_get(&hop_list[hop],
+                                                       &flow_list[index]);
+            member_flow_count[(hop * SAI_HASH_SIM_MAX_MEMBERS) + member[hop]]++;
+
+            if(hop > 0) {
+                pair_map[hop][(member[hop - 1] * hop_list[hop].num_members) +
+                              member[hop]] = 1;
+            }
+        }
+    }
+
+    for(hop = 1; (sai_rc == SAI_STATUS_SUCCESS) && (hop < num_hops); hop++) {
+        num_members = hop_list[hop].num_members;
+        used_pairs = 0;
+        possible_pairs = 0;
+
+        for(index = 0; index < (hop_list[hop - 1].num_members * num_members); index++) {
+            used_pairs += pair_map[hop][index];
+        }
+        for(index = 0; index < hop_list[hop - 1].num_members; index++) {
+            possible_pairs +=
+                (member_flow_count[((hop - 1) * SAI_HASH_SIM_MAX_MEMBERS) + index] <
+                 num_members) ?
+                member_flow_count[((hop - 1) * SAI_HASH_SIM_MAX_MEMBERS) + index] :
+                num_members;
+        }
+
+        polarization_list[hop - 1] = (possible_pairs > 0) ?
+            (1.0 - ((double)used_pairs / possible_pairs)) : 0.0;
+    }
+
+    for(hop = 1; hop < num_hops; hop++) {
+        free(pair_map[hop]);
+    }
+    free(member_flow_count);
+
+    return sai_rc;
+}
@@ -15,6 +15,7 @@
 *
 *************************************************************************/
 #include <stdio.h>
+#include <stdlib.h>
 #include <inttypes.h>
 
 #include "saitypes.h"
@@ -24,6 +25,7 @@
 #include "sai_switch_common.h"
 #include "sai_switch_utils.h"
 #include "sai_fdb_common.h"
+#include "sai_hash_sim.h"
 
 void sai_switch_capability_flag_dump(void)
 {
@@ -99,3 +101,77 @@ void sai_switch_info_dump(void)
     sai_switch_capability_flag_dump();
 }
 
+
+/* Simulate the switch LAG or ECMP hash on the flows of a trace file */
+void sai_switch_hash_sim_dump(const char *file_name, bool is_lag, uint_t num_members)
+{
+    sai_hash_sim_config_t  config;
+    sai_hash_sim_result_t  result;
+    sai_hash_sim_flow_t   *flow_list = NULL;
+    uint64_t               member_flow_count[SAI_HASH_SIM_MAX_MEMBERS];
+    uint_t                 count = 0;
+    uint_t                 member;
+    sai_status_t           sai_rc;
+
+    sai_rc = sai_hash_sim_switch_config_get(is_lag, NULL, num_members, &config);
+    if(sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_DEBUG("Unable to simulate %d members, status %d", num_members, sai_rc);
+        return;
+    }
+
+    if(sai_hash_sim_trace_load(file_name, &flow_list, &count) != SAI_STATUS_SUCCESS) {
+        SAI_DEBUG("Unable to load hash trace file %s", file_name);
+        return;
+    }
+
+    result.member_flow_count = member_flow_count;
+    sai_hash_sim_distribution_get(&config, flow_list, count, &result);
+
+    SAI_DEBUG("###### %s HASH SIMULATION #######", is_lag ? "LAG" : "ECMP");
+    SAI_DEBUG("Algorithm %d Seed 0x%x Fields 0x%x",
+              config.algo, config.seed, config.field_mask);
+    SAI_DEBUG("Flows %" PRIu64 " Members %d Unused members %d",
+              result.total_flows, result.num_members, result.unused_members);
+    SAI_DEBUG("Max flows %" PRIu64 " Min flows %" PRIu64,
+              result.max_flows, result.min_flows);
+    SAI_DEBUG("Max to mean ratio %.3f Spread %.2f%%",
+              result.max_to_mean_ratio, result.spread_pct);
+
+    for(member = 0; member < result.num_members; member++) {
+        SAI_DEBUG("Member %d flows %" PRIu64, member, member_flow_count[member]);
+    }
+
+    free(flow_list);
+}
+
+/* Simulate two hops using the same switch LAG or ECMP hash on the flows of
+ * a trace file and report their polarization */
+void sai_switch_hash_sim_polarization_dump(const char *file_name, bool is_lag,
+                                           uint_t num_members)
+{
+    sai_hash_sim_config_t  hop_list[2];
+    sai_hash_sim_flow_t   *flow_list = NULL;
+    double                 polarization = 0.0;
+    uint_t                 count = 0;
+    sai_status_t           sai_rc;
+
+    sai_rc = sai_hash_sim_switch_config_get(is_lag, NULL, num_members, &hop_list[0]);
+    if(sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_DEBUG("Unable to simulate %d members, status %d", num_members, sai_rc);
+        return;
+    }
+    hop_list[1] = hop_list[0];
+
+    if(sai_hash_sim_trace_load(file_name, &flow_list, &count) != SAI_STATUS_SUCCESS) {
+        SAI_DEBUG("Unable to load hash trace file %s", file_name);
+        return;
+    }
+
+    if(sai_hash_sim_polarization_get(hop_list, 2, flow_list, count, &polarization)
+       == SAI_STATUS_SUCCESS) {
+        SAI_DEBUG("%s hash polarization over 2 hops of %d members: %.3f",
+                  is_lag ? "LAG" : "ECMP", num_members, polarization);
+    }
+
+    free(flow_list);
+}
@@ -36,6 +36,15 @@
 static sai_fdb_global_data_t sai_fdb_global_cache;
 static std_mutex_lock_create_static_init_fast(fdb_lock);
 static sai_fdb_internal_callback_fn fdb_internal_callback = NULL;
+static sai_fdb_entry_change_listener_fn fdb_entry_change_listener = NULL;
+static std_mutex_lock_create_static_init_fast(fdb_change_lock);
+static sai_fdb_notification_data_t *fdb_change_list = NULL;
+static uint_t fdb_change_count = 0;
+static uint_t fdb_change_size = 0;
+/*Set when a change could not be queued, the listener then resyncs all entries*/
+static bool fdb_change_resync = false;
+
+#define SAI_FDB_DFLT_CHANGE_LIST_SIZE (64)
 
 void sai_fdb_lock(void)
 {
@@ -130,6 +139,42 @@ sai_status_t sai_fdb_get_port_from_cache(const sai_fdb_entry_t *fdb_entry,
     *port_id = fdb_entry_node->port_id;
     return SAI_STATUS_SUCCESS;
 }
+/* Called with the FDB lock held. Change is queued and handed to the listener
+ * by sai_fdb_send_entry_change_notifications() once the FDB lock is released.
+ * If the change cannot be queued the listener is asked to resync instead */
+static void sai_fdb_entry_change_notify (const sai_fdb_entry_key_t *fdb_key,
+                                         sai_object_id_t port_id,
+                                         sai_fdb_event_t fdb_event)
+{
+    sai_fdb_notification_data_t *change_list = NULL;
+    uint_t size = 0;
+
+    if((fdb_entry_change_listener == NULL) || fdb_change_resync) {
+        return;
+    }
+
+    if(fdb_change_count == fdb_change_size) {
+        size = (fdb_change_size) ? (fdb_change_size * 2) : SAI_FDB_DFLT_CHANGE_LIST_SIZE;
+        change_list = realloc(fdb_change_list, size * sizeof(sai_fdb_notification_data_t));
+        if(change_list == NULL) {
+            SAI_FDB_LOG_CRIT ("No memory to queue FDB entry change for vlan:%d, "
+                              "listener will resync all entries", fdb_key->vlan_id);
+            fdb_change_resync = true;
+            return;
+        }
+        fdb_change_list = change_list;
+        fdb_change_size = size;
+    }
+
+    memset(&fdb_change_list[fdb_change_count], 0, sizeof(sai_fdb_notification_data_t));
+    fdb_change_list[fdb_change_count].fdb_entry.vlan_id = fdb_key->vlan_id;
+    memcpy(&(fdb_change_list[fdb_change_count].fdb_entry.mac_address),
+           &(fdb_key->mac_address), sizeof(sai_mac_t));
+    fdb_change_list[fdb_change_count].port_id = port_id;
+    fdb_change_list[fdb_change_count].fdb_event = fdb_event;
+    fdb_change_count++;
+}
+
 static void sai_remove_fdb_entry_node (sai_fdb_entry_node_t *fdb_entry_node)
 {
     sai_fdb_registered_node_t *fdb_registered_node = NULL;
@@ -149,6 +194,8 @@ static void sai_remove_fdb_entry_node (sai_fdb_entry_node_t *fdb_entry_node)
         fdb_registered_node->node_in_cl = true;
     }
     STD_ASSERT(fdb_entry_node != NULL);
+    sai_fdb_entry_change_notify(&fdb_entry_node->fdb_key, SAI_NULL_OBJECT_ID,
+                                SAI_FDB_EVENT_FLUSHED);
     std_radix_remove(sai_fdb_global_cache.sai_global_fdb_tree,&(fdb_entry_node->fdb_rt_head));
     free(fdb_entry_node);
 }
@@ -378,6 +425,10 @@ sai_status_t sai_insert_fdb_entry_node(const sai_fdb_entry_t *fdb_entry,
     fdb_entry_node->entry_type = entry_type;
     fdb_entry_node->action = action;
     fdb_entry_node->metadata = metadata;
+    if(notify) {
+        sai_fdb_entry_change_notify(&fdb_entry_node->fdb_key, port_id,
+                                    SAI_FDB_EVENT_LEARNED);
+    }
     SAI_FDB_LOG_TRACE("Added FDB Node MAC:%s vlan:%d",
                       std_mac_to_string(&(fdb_entry->mac_address), mac_str,
                                      sizeof(mac_str)), fdb_entry->vlan_id);
@@ -390,6 +441,39 @@ void sai_fdb_internal_callback_cache_update (sai_fdb_internal_callback_fn
    fdb_internal_callback = fdb_callback;
 }
 
+void sai_fdb_entry_change_listener_set (sai_fdb_entry_change_listener_fn listener)
+{
+    fdb_entry_change_listener = listener;
+}
+
+void sai_fdb_send_entry_change_notifications(void)
+{
+    sai_fdb_notification_data_t *change_list = NULL;
+    uint_t change_count = 0;
+    bool resync = false;
+
+    /* Serializes the listener calls so that the changes are applied in order */
+    std_mutex_lock(&fdb_change_lock);
+
+    sai_fdb_lock();
+    change_list = fdb_change_list;
+    change_count = fdb_change_count;
+    fdb_change_list = NULL;
+    fdb_change_count = 0;
+    fdb_change_size = 0;
+    resync = fdb_change_resync;
+    fdb_change_resync = false;
+    sai_fdb_unlock();
+
+    if(((change_count > 0) || resync) && (fdb_entry_change_listener != NULL)) {
+        fdb_entry_change_listener(change_count, change_list, resync);
+    }
+
+    std_mutex_unlock(&fdb_change_lock);
+
+    free(change_list);
+}
+
 int sai_fdb_notification_list_walk(std_radical_head_t *radical_head, va_list ap)
 {
    sai_fdb_registered_node_t *fdb_registered_node = (sai_fdb_registered_node_t *)radical_head;
@@ -420,7 +504,8 @@ int sai_fdb_notification_list_walk(std_radical_head_t *radical_head, va_list ap)
 
 bool sai_fdb_is_notifications_pending (void)
 {
-    if (sai_fdb_global_cache.num_notifications > 0) {
+    if ((sai_fdb_global_cache.num_notifications > 0) || (fdb_change_count > 0) ||
+        fdb_change_resync) {
         return true;
     }
     return false;
@@ -432,6 +517,8 @@ void sai_fdb_send_internal_notifications(void)
     sai_fdb_notification_data_t *data = NULL;
     uint_t num_notifications = 0;
 
+    sai_fdb_send_entry_change_notifications();
+
     if(fdb_internal_callback == NULL) {
         return;
     }
@@ -562,6 +649,9 @@ void sai_update_fdb_entry_node (sai_fdb_entry_node_t *fdb_entry_node,
                 }
                 fdb_registered_node->node_in_cl = true;
             }
+            sai_fdb_entry_change_notify(&fdb_entry_node->fdb_key,
+                                        fdb_entry_node->port_id,
+                                        SAI_FDB_EVENT_LEARNED);
         }
 
     } else if(attr->id == SAI_FDB_ENTRY_ATTR_TYPE) {
@@ -31,6 +31,7 @@ sai_status_t sai_dump_lag_port_list(sai_object_id_t lag_id)
     sai_lag_node_t *lag_node = sai_lag_node_get(lag_id);
     sai_lag_port_node_t *lag_port_node = NULL;
     std_dll *node = NULL;
+    unsigned int port_index = 0;
 
     if(lag_node == NULL) {
         return SAI_STATUS_ITEM_NOT_FOUND;
@@ -48,6 +49,13 @@ sai_status_t sai_dump_lag_port_list(sai_object_id_t lag_id)
               (int)sai_uoid_npu_obj_id_get(lag_port_node->port_id));
     }
     SAI_DEBUG("\r\n");
+    SAI_DEBUG("active port list: count:%d epoch:%"PRIu64"",
+              lag_node->active_port_count, lag_node->active_epoch);
+    for(port_index = 0; port_index < lag_node->active_port_count; port_index++) {
+        SAI_DEBUG("0x%"PRIx64"(%d) ",lag_node->active_port_list[port_index],
+              (int)sai_uoid_npu_obj_id_get(lag_node->active_port_list[port_index]));
+    }
+    SAI_DEBUG("\r\n");
 
     return SAI_STATUS_SUCCESS;
 }
@@ -31,8 +31,200 @@
 #include <inttypes.h>
 
 static std_dll_head global_lag_list;
+/*LAG nodes hashed on LAG id. The sorted list is kept for ordered walks*/
+static sai_lag_node_t *global_lag_hash[SAI_LAG_ID_HASH_NUM_BUCKETS];
+/*LAG port nodes hashed on member id and on port id*/
+static sai_lag_port_node_t *global_lag_member_hash[SAI_LAG_MEMBER_HASH_NUM_BUCKETS];
+static sai_lag_port_node_t *global_lag_port_hash[SAI_LAG_MEMBER_HASH_NUM_BUCKETS];
 static std_mutex_lock_create_static_init_fast(lag_lock);
 
+static inline unsigned int sai_lag_hash_bucket_get(sai_object_id_t id,
+                                                   unsigned int num_buckets)
+{
+    uint64_t hash = id * 0x9e3779b97f4a7c15ULL;
+
+    return ((unsigned int)(hash >> 32) & (num_buckets - 1));
+}
+
+static inline unsigned int sai_lag_id_hash_bucket_get(sai_object_id_t lag_id)
+{
+    return sai_lag_hash_bucket_get(lag_id, SAI_LAG_ID_HASH_NUM_BUCKETS);
+}
+
+static inline unsigned int sai_lag_member_hash_bucket_get(sai_object_id_t id)
+{
+    return sai_lag_hash_bucket_get(id, SAI_LAG_MEMBER_HASH_NUM_BUCKETS);
+}
+
+static void sai_lag_member_id_hash_insert(sai_lag_port_node_t *lag_port_node)
+{
+    unsigned int bucket = sai_lag_member_hash_bucket_get(lag_port_node->member_id);
+
+    lag_port_node->member_hash_next = global_lag_member_hash[bucket];
+    global_lag_member_hash[bucket] = lag_port_node;
+}
+
+static void sai_lag_member_id_hash_remove(sai_lag_port_node_t *lag_port_node)
+{
+    sai_lag_port_node_t **link = NULL;
+    unsigned int bucket = sai_lag_member_hash_bucket_get(lag_port_node->member_id);
+
+    for(link = &global_lag_member_hash[bucket]; *link != NULL;
+        link = &((*link)->member_hash_next)) {
+        if(*link == lag_port_node) {
+            *link = lag_port_node->member_hash_next;
+            lag_port_node->member_hash_next = NULL;
+            return;
+        }
+    }
+}
+
+static void sai_lag_port_id_hash_insert(sai_lag_port_node_t *lag_port_node)
+{
+    unsigned int bucket = sai_lag_member_hash_bucket_get(lag_port_node->port_id);
+
+    lag_port_node->port_hash_next = global_lag_port_hash[bucket];
+    global_lag_port_hash[bucket] = lag_port_node;
+}
+
+static void sai_lag_port_id_hash_remove(sai_lag_port_node_t *lag_port_node)
+{
+    sai_lag_port_node_t **link = NULL;
+    unsigned int bucket = sai_lag_member_hash_bucket_get(lag_port_node->port_id);
+
+    for(link = &global_lag_port_hash[bucket]; *link != NULL;
+        link = &((*link)->port_hash_next)) {
+        if(*link == lag_port_node) {
+            *link = lag_port_node->port_hash_next;
+            lag_port_node->port_hash_next = NULL;
+            return;
+        }
+    }
+}
+
+static sai_lag_port_node_t* sai_lag_member_id_hash_lookup(sai_object_id_t member_id)
+{
+    sai_lag_port_node_t *lag_port_node = NULL;
+
+    for(lag_port_node = global_lag_member_hash[sai_lag_member_hash_bucket_get(member_id)];
+        lag_port_node != NULL;
+        lag_port_node = lag_port_node->member_hash_next) {
+        if(lag_port_node->member_id == member_id) {
+            return lag_port_node;
+        }
+    }
+    return NULL;
+}
+
+static void sai_lag_id_hash_insert(sai_lag_node_t *lag_node)
+{
+    unsigned int bucket = sai_lag_id_hash_bucket_get(lag_node->sai_lag_id);
+
+    lag_node->hash_next = global_lag_hash[bucket];
+    global_lag_hash[bucket] = lag_node;
+}
+
+static void sai_lag_id_hash_remove(sai_lag_node_t *lag_node)
+{
+    sai_lag_node_t **link = NULL;
+    unsigned int bucket = sai_lag_id_hash_bucket_get(lag_node->sai_lag_id);
+
+    for(link = &global_lag_hash[bucket]; *link != NULL;
+        link = &((*link)->hash_next)) {
+        if(*link == lag_node) {
+            *link = lag_node->hash_next;
+            lag_node->hash_next = NULL;
+            return;
+        }
+    }
+}
+
+/* Make room for one more port in the active port list of the LAG */
+static sai_status_t sai_lag_active_port_list_reserve(sai_lag_node_t *lag_node)
+{
+    sai_object_id_t *port_list = NULL;
+    unsigned int max_ports;
+
+    if(lag_node->active_port_count < lag_node->active_port_max) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    max_ports = (lag_node->active_port_max == 0) ?
+                SAI_LAG_ACTIVE_PORT_LIST_DFLT_SIZE : (2 * lag_node->active_port_max);
+
+    if(posix_memalign((void **)&port_list, SAI_LAG_ACTIVE_PORT_LIST_ALIGN,
+                      max_ports * sizeof(sai_object_id_t)) != 0) {
+        SAI_LAG_LOG_CRIT("Unable to grow LAG 0x%"PRIx64" active port list to %d ports",
+                         lag_node->sai_lag_id, max_ports);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    if(lag_node->active_port_count > 0) {
+        memcpy(port_list, lag_node->active_port_list,
+               lag_node->active_port_count * sizeof(sai_object_id_t));
+    }
+    free(lag_node->active_port_list);
+    lag_node->active_port_list = port_list;
+    lag_node->active_port_max = max_ports;
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Position of the port in the active port list, or where it is to be
+ * inserted */
+static unsigned int sai_lag_active_port_index_get(const sai_lag_node_t *lag_node,
+                                                  sai_object_id_t port_id)
+{
+    unsigned int low = 0;
+    unsigned int high = lag_node->active_port_count;
+    unsigned int mid;
+
+    while(low < high) {
+        mid = low + ((high - low) / 2);
+        if(lag_node->active_port_list[mid] < port_id) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/* Room must have been reserved with sai_lag_active_port_list_reserve */
+static void sai_lag_active_port_insert(sai_lag_node_t *lag_node,
+                                       sai_object_id_t port_id)
+{
+    unsigned int index = sai_lag_active_port_index_get(lag_node, port_id);
+
+    if((index < lag_node->active_port_count) &&
+       (lag_node->active_port_list[index] == port_id)) {
+        return;
+    }
+
+    memmove(&lag_node->active_port_list[index + 1],
+            &lag_node->active_port_list[index],
+            (lag_node->active_port_count - index) * sizeof(sai_object_id_t));
+    lag_node->active_port_list[index] = port_id;
+    lag_node->active_port_count++;
+    lag_node->active_epoch++;
+}
+
+static void sai_lag_active_port_remove(sai_lag_node_t *lag_node,
+                                       sai_object_id_t port_id)
+{
+    unsigned int index = sai_lag_active_port_index_get(lag_node, port_id);
+
+    if((index >= lag_node->active_port_count) ||
+       (lag_node->active_port_list[index] != port_id)) {
+        return;
+    }
+
+    lag_node->active_port_count--;
+    memmove(&lag_node->active_port_list[index],
+            &lag_node->active_port_list[index + 1],
+            (lag_node->active_port_count - index) * sizeof(sai_object_id_t));
+    lag_node->active_epoch++;
+}
+
 void sai_lag_lock(void)
 {
     std_mutex_lock(&lag_lock);
@@ -51,6 +243,9 @@ void sai_lag_cache_init(void)
 {
     std_dll_init_sort(&global_lag_list,sai_port_node_compare,
                  SAI_LAG_ID_OFFSET, SAI_LAG_ID_SIZE);
+    memset(global_lag_hash, 0, sizeof(global_lag_hash));
+    memset(global_lag_member_hash, 0, sizeof(global_lag_member_hash));
+    memset(global_lag_port_hash, 0, sizeof(global_lag_port_hash));
 }
 
 sai_status_t sai_lag_node_add(sai_object_id_t lag_id)
@@ -69,22 +264,19 @@ sai_status_t sai_lag_node_add(sai_object_id_t lag_id)
                  SAI_LAG_PORT_ID_OFFSET, SAI_LAG_PORT_ID_SIZE);
 
     std_dll_insert(&global_lag_list,&(lag_node->node));
+    sai_lag_id_hash_insert(lag_node);
     return SAI_STATUS_SUCCESS;
 }
 
 sai_lag_node_t* sai_lag_node_get(sai_object_id_t lag_id)
 {
     sai_lag_node_t *lag_node = NULL;
-    std_dll *node = NULL;
 
-    for(node = std_dll_getfirst(&global_lag_list);
-        node != NULL;
-        node = std_dll_getnext(&global_lag_list,node)) {
-        lag_node = (sai_lag_node_t *)node;
+    for(lag_node = global_lag_hash[sai_lag_id_hash_bucket_get(lag_id)];
+        lag_node != NULL;
+        lag_node = lag_node->hash_next) {
         if(lag_node->sai_lag_id == lag_id) {
             return lag_node;
-        }else if (lag_node->sai_lag_id > lag_id){
-            break;
         }
     }
     return NULL;
@@ -112,6 +304,8 @@ sai_status_t sai_lag_node_remove (sai_object_id_t lag_id)
     lag_node = sai_lag_node_get(lag_id);
     if(lag_node != NULL) {
         std_dll_remove(&global_lag_list,&(lag_node->node));
+        sai_lag_id_hash_remove(lag_node);
+        free(lag_node->active_port_list);
         free(lag_node);
         return SAI_STATUS_SUCCESS;
     }
@@ -145,6 +339,9 @@ sai_status_t sai_lag_port_node_add(sai_object_id_t  lag_id,
     if(lag_node == NULL) {
         return SAI_STATUS_ITEM_NOT_FOUND;
     }
+    if(sai_lag_active_port_list_reserve(lag_node) != SAI_STATUS_SUCCESS) {
+        return SAI_STATUS_NO_MEMORY;
+    }
     lag_port_node = (sai_lag_port_node_t *)
                          calloc(1, sizeof(sai_lag_port_node_t));
     if(lag_port_node == NULL) {
@@ -161,6 +358,9 @@ sai_status_t sai_lag_port_node_add(sai_object_id_t  lag_id,
     lag_port_node->egr_disable = false;
 
     std_dll_insert(&(lag_node->port_list),&(lag_port_node->node));
+    sai_lag_member_id_hash_insert(lag_port_node);
+    sai_lag_port_id_hash_insert(lag_port_node);
+    sai_lag_active_port_insert(lag_node, port_id);
     lag_node->port_count++;
     return SAI_STATUS_SUCCESS;
 }
@@ -168,22 +368,14 @@ sai_status_t sai_lag_port_node_add(sai_object_id_t  lag_id,
 static sai_lag_port_node_t* sai_lag_port_node_get(sai_object_id_t lag_id,
                                                   sai_object_id_t port_id)
 {
-    sai_lag_node_t *lag_node = sai_lag_node_get(lag_id);
     sai_lag_port_node_t *lag_port_node = NULL;
-    std_dll *node = NULL;
-
-    if(lag_node == NULL) {
-        return NULL;
-    }
 
-    for(node = std_dll_getfirst(&(lag_node->port_list));
-        node != NULL;
-        node = std_dll_getnext(&(lag_node->port_list),node)) {
-        lag_port_node = (sai_lag_port_node_t *)node;
-        if(lag_port_node->port_id == port_id) {
+    for(lag_port_node = global_lag_port_hash[sai_lag_member_hash_bucket_get(port_id)];
+        lag_port_node != NULL;
+        lag_port_node = lag_port_node->port_hash_next) {
+        if((lag_port_node->port_id == port_id) &&
+           (lag_port_node->lag_id == lag_id)) {
             return lag_port_node;
-        }else if (lag_port_node->port_id > port_id){
-            break;
         }
     }
     return NULL;
@@ -193,26 +385,17 @@ sai_status_t sai_lag_get_port_id_from_member_id (sai_object_id_t  lag_id,
                                                  sai_object_id_t  member_id,
                                                  sai_object_id_t *port_id)
 {
-    sai_lag_node_t      *lag_node;
     sai_lag_port_node_t *lag_port_node = NULL;
-    std_dll             *node = NULL;
-
-    lag_node = sai_lag_node_get (lag_id);
 
-    if (lag_node == NULL) {
+    if (sai_lag_node_get (lag_id) == NULL) {
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
-    for (node = std_dll_getfirst (&(lag_node->port_list));
-         node != NULL;
-         node = std_dll_getnext (&(lag_node->port_list), node)) {
+    lag_port_node = sai_lag_member_id_hash_lookup (member_id);
 
-        lag_port_node = (sai_lag_port_node_t *) node;
-
-        if (lag_port_node->member_id == member_id) {
-            *port_id = lag_port_node->port_id;
-            return SAI_STATUS_SUCCESS;
-        }
+    if ((lag_port_node != NULL) && (lag_port_node->lag_id == lag_id)) {
+        *port_id = lag_port_node->port_id;
+        return SAI_STATUS_SUCCESS;
     }
 
     return SAI_STATUS_ITEM_NOT_FOUND;
@@ -222,29 +405,14 @@ sai_status_t sai_lag_get_info_from_member_id (sai_object_id_t  member_id,
                                               sai_object_id_t *lag_id,
                                               sai_object_id_t *port_id)
 {
-    sai_lag_node_t      *lag_node;
     sai_lag_port_node_t *lag_port_node = NULL;
-    std_dll             *node1 = NULL;
-    std_dll             *node2 = NULL;
 
-    for (node1 = std_dll_getfirst (&global_lag_list);
-         node1 != NULL;
-         node1 = std_dll_getnext (&global_lag_list, node1)) {
+    lag_port_node = sai_lag_member_id_hash_lookup (member_id);
 
-        lag_node = (sai_lag_node_t *) node1;
-
-        for (node2 = std_dll_getfirst (&(lag_node->port_list));
-             node2 != NULL;
-             node2 = std_dll_getnext (&(lag_node->port_list), node2)) {
-
-            lag_port_node = (sai_lag_port_node_t *)node2;
-
-            if (lag_port_node->member_id == member_id) {
-                *port_id = lag_port_node->port_id;
-                *lag_id  = lag_port_node->lag_id;
-                return SAI_STATUS_SUCCESS;
-            }
-        }
+    if (lag_port_node != NULL) {
+        *port_id = lag_port_node->port_id;
+        *lag_id  = lag_port_node->lag_id;
+        return SAI_STATUS_SUCCESS;
     }
 
     return SAI_STATUS_ITEM_NOT_FOUND;
@@ -257,6 +425,9 @@ sai_status_t sai_lag_port_node_remove (sai_object_id_t lag_id,
     sai_lag_port_node_t *lag_port_node = sai_lag_port_node_get(lag_id, port_id);
     if((lag_node != NULL) && (lag_port_node != NULL)) {
         std_dll_remove(&(lag_node->port_list),&(lag_port_node->node));
+        sai_lag_member_id_hash_remove(lag_port_node);
+        sai_lag_port_id_hash_remove(lag_port_node);
+        sai_lag_active_port_remove(lag_node, port_id);
         free(lag_port_node);
         lag_node->port_count--;
         return SAI_STATUS_SUCCESS;
@@ -279,9 +450,15 @@ sai_status_t sai_remove_all_lag_port_nodes(sai_object_id_t lag_id)
         node = std_dll_getfirst(&(lag_node->port_list))) {
         lag_port_node = (sai_lag_port_node_t *)node;
         std_dll_remove(&(lag_node->port_list),&(lag_port_node->node));
+        sai_lag_member_id_hash_remove(lag_port_node);
+        sai_lag_port_id_hash_remove(lag_port_node);
         free(lag_port_node);
     }
     lag_node->port_count = 0;
+    if(lag_node->active_port_count > 0) {
+        lag_node->active_port_count = 0;
+        lag_node->active_epoch++;
+    }
     return SAI_STATUS_SUCCESS;
 }
 
@@ -340,17 +517,14 @@ sai_status_t sai_lag_portlist_cache_read(sai_object_id_t lag_id,
 
 bool sai_is_port_part_of_different_lag(sai_object_id_t lag_id, sai_object_id_t port_id)
 {
-    sai_lag_node_t *lag_node = NULL;
-    std_dll *node = NULL;
+    sai_lag_port_node_t *lag_port_node = NULL;
 
-    for(node = std_dll_getfirst(&global_lag_list);
-        node != NULL;
-        node = std_dll_getnext(&global_lag_list,node)) {
-        lag_node = (sai_lag_node_t *)node;
-        if(lag_node->sai_lag_id != lag_id) {
-            if(sai_is_port_lag_member(lag_node->sai_lag_id, port_id)) {
-                return true;
-            }
+    for(lag_port_node = global_lag_port_hash[sai_lag_member_hash_bucket_get(port_id)];
+        lag_port_node != NULL;
+        lag_port_node = lag_port_node->port_hash_next) {
+        if((lag_port_node->port_id == port_id) &&
+           (lag_port_node->lag_id != lag_id)) {
+            return true;
         }
     }
     return false;
@@ -421,18 +595,28 @@ sai_status_t sai_lag_member_set_disable_status (sai_object_id_t lag_id,
                                                 bool            is_ingress,
                                                 bool            status)
 {
+    sai_lag_node_t      *lag_node;
     sai_lag_port_node_t *lag_port_node;
 
+    lag_node = sai_lag_node_get (lag_id);
     lag_port_node = sai_lag_port_node_get (lag_id, port_id);
 
-    if (lag_port_node == NULL) {
+    if ((lag_node == NULL) || (lag_port_node == NULL)) {
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
     if (is_ingress) {
         lag_port_node->ing_disable = status;
     }
+    else if (status) {
+        sai_lag_active_port_remove (lag_node, port_id);
+        lag_port_node->egr_disable = status;
+    }
     else {
+        if (sai_lag_active_port_list_reserve (lag_node) != SAI_STATUS_SUCCESS) {
+            return SAI_STATUS_NO_MEMORY;
+        }
+        sai_lag_active_port_insert (lag_node, port_id);
         lag_port_node->egr_disable = status;
     }
 
@@ -468,7 +652,31 @@ sai_status_t sai_lag_member_set_member_id (sai_object_id_t lag_id,
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
+    sai_lag_member_id_hash_remove (lag_port_node);
     lag_port_node->member_id = member_id;
+    sai_lag_member_id_hash_insert (lag_port_node);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_lag_active_port_list_get (sai_object_id_t         lag_id,
+                                           const sai_object_id_t **port_list,
+                                           unsigned int           *port_count,
+                                           uint64_t               *epoch)
+{
+    sai_lag_node_t *lag_node = sai_lag_node_get (lag_id);
+
+    STD_ASSERT (port_list != NULL);
+    STD_ASSERT (port_count != NULL);
+    STD_ASSERT (epoch != NULL);
+
+    if (lag_node == NULL) {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    *port_list = lag_node->active_port_list;
+    *port_count = lag_node->active_port_count;
+    *epoch = lag_node->active_epoch;
 
     return SAI_STATUS_SUCCESS;
 }
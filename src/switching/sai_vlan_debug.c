@@ -26,8 +26,7 @@
 
 sai_status_t sai_dump_vlan(sai_vlan_id_t vlan_id)
 {
-    sai_vlan_port_node_t *vlan_port_node = NULL;
-    std_dll *node = NULL;
+    const sai_vlan_port_t *vlan_port = NULL;
     sai_vlan_global_cache_node_t *vlan_port_list = sai_vlan_portlist_cache_read(vlan_id);
 
     if(vlan_port_list == NULL) {
@@ -35,13 +34,13 @@ sai_status_t sai_dump_vlan(sai_vlan_id_t vlan_id)
         return SAI_STATUS_FAILURE;
     }
 
-    for(node = std_dll_getfirst(&(vlan_port_list->port_list));
-        node != NULL;
-        node = std_dll_getnext(&(vlan_port_list->port_list),node)) {
-        vlan_port_node = (sai_vlan_port_node_t *)node;
+    SAI_DEBUG("port count:%d", sai_vlan_port_count_get(vlan_id));
+    for(vlan_port = sai_vlan_port_get_first(vlan_id);
+        vlan_port != NULL;
+        vlan_port = sai_vlan_port_get_next(vlan_id, vlan_port)) {
         SAI_DEBUG("port:%d tagging mode:%d",
-               (int)sai_uoid_npu_obj_id_get(vlan_port_node->vlan_port.port_id),
-               vlan_port_node->vlan_port.tagging_mode);
+               (int)sai_uoid_npu_obj_id_get(vlan_port->port_id),
+               vlan_port->tagging_mode);
     }
     return SAI_STATUS_SUCCESS;
 }
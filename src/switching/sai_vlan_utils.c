@@ -22,6 +22,7 @@
 #include "saistatus.h"
 #include "saitypes.h"
 #include "std_llist.h"
+#include "std_bit_masks.h"
 #include "sai_vlan_api.h"
 #include "sai_vlan_common.h"
 #include "std_mutex_lock.h"
@@ -35,6 +36,33 @@ static sai_vlan_global_cache_node_t *global_vlan_list[SAI_MAX_VLAN_TAG_ID+1];
 static std_mutex_lock_create_static_init_fast(vlan_lock);
 static sai_vlan_id_t sai_internal_vlan_id = VLAN_UNDEF;
 static std_dll_head global_port_vlan_count_list;
+/*Number of bits in the VLAN port bitmaps, one per logical port*/
+static unsigned int sai_vlan_port_bitmap_size = 0;
+static unsigned int sai_vlan_port_bitmap_bytes = 0;
+/*Port id of each port bitmap index*/
+static sai_object_id_t *sai_vlan_port_index_table = NULL;
+/*Number of VLANs of each port bitmap index*/
+static unsigned int *sai_port_vlan_count_table = NULL;
+/*VLAN bitmap of each port bitmap index, SAI_VLAN_BITMAP_BYTES per port*/
+static uint8_t *sai_port_vlan_bitmap_table = NULL;
+/*VLAN cache node and port bitmaps of each VLAN id*/
+static sai_vlan_global_cache_node_t *sai_vlan_cache_node_pool = NULL;
+static uint8_t *sai_vlan_port_bitmap_pool = NULL;
+
+/*VLAN port node pool, grown by chunks and reused through a free list*/
+#define SAI_VLAN_PORT_NODE_POOL_CHUNK_SIZE (1024)
+
+typedef struct _sai_vlan_port_node_chunk_t{
+    /*next: Next chunk in the pool*/
+    struct _sai_vlan_port_node_chunk_t *next;
+    /*node_list: Nodes of the chunk*/
+    sai_vlan_port_node_t node_list[SAI_VLAN_PORT_NODE_POOL_CHUNK_SIZE];
+}sai_vlan_port_node_chunk_t;
+
+static sai_vlan_port_node_chunk_t *sai_vlan_port_node_chunk_list = NULL;
+static std_dll_head sai_vlan_port_node_free_list;
+static unsigned int sai_vlan_port_node_pool_size = 0;
+static unsigned int sai_vlan_port_node_pool_max = 0;
 
 void sai_vlan_lock(void)
 {
@@ -71,6 +99,72 @@ sai_vlan_id_t sai_internal_vlan_id_get(void)
     return sai_internal_vlan_id;
 }
 
+static void sai_vlan_cache_tables_free(void)
+{
+    sai_vlan_port_node_chunk_t *chunk = NULL;
+
+    free(sai_vlan_port_index_table);
+    sai_vlan_port_index_table = NULL;
+    free(sai_port_vlan_count_table);
+    sai_port_vlan_count_table = NULL;
+    free(sai_port_vlan_bitmap_table);
+    sai_port_vlan_bitmap_table = NULL;
+    free(sai_vlan_cache_node_pool);
+    sai_vlan_cache_node_pool = NULL;
+    free(sai_vlan_port_bitmap_pool);
+    sai_vlan_port_bitmap_pool = NULL;
+    while(sai_vlan_port_node_chunk_list != NULL) {
+        chunk = sai_vlan_port_node_chunk_list;
+        sai_vlan_port_node_chunk_list = chunk->next;
+        free(chunk);
+    }
+    sai_vlan_port_node_pool_size = 0;
+}
+
+/*Adds a chunk of nodes to the VLAN port node pool free list*/
+static sai_status_t sai_vlan_port_node_pool_grow(void)
+{
+    sai_vlan_port_node_chunk_t *chunk = NULL;
+    unsigned int node_idx = 0;
+
+    if(sai_vlan_port_node_pool_size >= sai_vlan_port_node_pool_max) {
+        return SAI_STATUS_INSUFFICIENT_RESOURCES;
+    }
+    chunk = (sai_vlan_port_node_chunk_t *)calloc(1, sizeof(sai_vlan_port_node_chunk_t));
+    if(chunk == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+    chunk->next = sai_vlan_port_node_chunk_list;
+    sai_vlan_port_node_chunk_list = chunk;
+    for(node_idx = 0; node_idx < SAI_VLAN_PORT_NODE_POOL_CHUNK_SIZE; node_idx++) {
+        std_dll_insertatback(&sai_vlan_port_node_free_list,
+                             &(chunk->node_list[node_idx].node));
+    }
+    sai_vlan_port_node_pool_size += SAI_VLAN_PORT_NODE_POOL_CHUNK_SIZE;
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_vlan_port_node_t* sai_vlan_port_node_alloc(void)
+{
+    std_dll *node = NULL;
+
+    node = std_dll_getfirst(&sai_vlan_port_node_free_list);
+    if((node == NULL) && (sai_vlan_port_node_pool_grow() == SAI_STATUS_SUCCESS)) {
+        node = std_dll_getfirst(&sai_vlan_port_node_free_list);
+    }
+    if(node == NULL) {
+        return NULL;
+    }
+    std_dll_remove(&sai_vlan_port_node_free_list, node);
+    memset(node, 0, sizeof(sai_vlan_port_node_t));
+    return ((sai_vlan_port_node_t *)node);
+}
+
+static void sai_vlan_port_node_free(sai_vlan_port_node_t *vlan_port_node)
+{
+    std_dll_insertatback(&sai_vlan_port_node_free_list, &(vlan_port_node->node));
+}
+
 sai_status_t sai_vlan_cache_init(void)
 {
     sai_vlan_id_t vlan_id = 0;
@@ -80,15 +174,161 @@ sai_status_t sai_vlan_cache_init(void)
     {
         global_vlan_list[vlan_id] = NULL;
     }
-    /*Allocating for maximum possible port range
-      so that it can work for fanout too
+    /*Ports without a port bitmap index, such as LAGs, are counted in
+      the sorted list
      */
     std_dll_init_sort(&global_port_vlan_count_list,sai_port_node_compare,
                  SAI_PORTV_VLAN_COUNTER_OFFSET, SAI_PORTV_VLAN_COUNTER_SIZE);
+
+    /*Port bitmaps are indexed by the NPU local port id*/
+    sai_vlan_port_bitmap_size = sai_switch_get_max_lport() + 1;
+    sai_vlan_port_bitmap_bytes = (sai_vlan_port_bitmap_size + BITS_PER_BYTE - 1)
+                                  / BITS_PER_BYTE;
+    sai_vlan_port_index_table = (sai_object_id_t *)
+                    calloc(sai_vlan_port_bitmap_size, sizeof(sai_object_id_t));
+    /*Allocating for maximum possible port range
+      so that it can work for fanout too
+     */
+    sai_port_vlan_count_table = (unsigned int *)
+                    calloc(sai_vlan_port_bitmap_size, sizeof(unsigned int));
+    sai_port_vlan_bitmap_table = (uint8_t *)
+                    calloc(sai_vlan_port_bitmap_size, SAI_VLAN_BITMAP_BYTES);
+    /*VLAN cache nodes and their port bitmaps are indexed by VLAN id*/
+    sai_vlan_cache_node_pool = (sai_vlan_global_cache_node_t *)
+                    calloc(SAI_MAX_VLAN_TAG_ID + 1,
+                           sizeof(sai_vlan_global_cache_node_t));
+    sai_vlan_port_bitmap_pool = (uint8_t *)
+                    calloc((SAI_MAX_VLAN_TAG_ID + 1) * SAI_VLAN_PORT_BITMAP_MAX,
+                           (sai_vlan_port_bitmap_bytes > 0) ?
+                           sai_vlan_port_bitmap_bytes : 1);
+    if((sai_vlan_port_index_table == NULL) || (sai_port_vlan_count_table == NULL) ||
+       (sai_port_vlan_bitmap_table == NULL) || (sai_vlan_cache_node_pool == NULL) ||
+       (sai_vlan_port_bitmap_pool == NULL)) {
+        SAI_VLAN_LOG_CRIT("Unable to allocate VLAN cache tables for %d ports",
+                          sai_vlan_port_bitmap_size);
+        sai_vlan_cache_tables_free();
+        return SAI_STATUS_NO_MEMORY;
+    }
+    /*VLAN port nodes are pooled up to one node per port in every VLAN*/
+    std_dll_init(&sai_vlan_port_node_free_list);
+    sai_vlan_port_node_pool_max = sai_vlan_port_bitmap_size * SAI_MAX_VLAN_TAG_ID;
+    if(sai_vlan_port_node_pool_grow() != SAI_STATUS_SUCCESS) {
+        SAI_VLAN_LOG_CRIT("Unable to allocate VLAN port node pool");
+        sai_vlan_cache_tables_free();
+        return SAI_STATUS_NO_MEMORY;
+    }
     return SAI_STATUS_SUCCESS;
 }
 
-static sai_status_t sai_add_port_vlan_counter_node(sai_object_id_t port_id)
+static bool sai_vlan_port_bitmap_index_get(sai_object_id_t port_id,
+                                           unsigned int *index)
+{
+    sai_npu_port_id_t local_port_id = 0;
+
+    if(!sai_is_obj_id_logical_port(port_id)) {
+        return false;
+    }
+    if(sai_port_to_npu_local_port(port_id, &local_port_id) != SAI_STATUS_SUCCESS) {
+        return false;
+    }
+    if(local_port_id >= sai_vlan_port_bitmap_size) {
+        return false;
+    }
+    *index = local_port_id;
+    return true;
+}
+
+static sai_vlan_port_bitmap_type_t sai_vlan_port_bitmap_type_get(
+                                        sai_vlan_tagging_mode_t tagging_mode)
+{
+    switch(tagging_mode) {
+        case SAI_VLAN_PORT_TAGGED:
+            return SAI_VLAN_PORT_BITMAP_TAGGED;
+        case SAI_VLAN_PORT_PRIORITY_TAGGED:
+            return SAI_VLAN_PORT_BITMAP_PRIORITY_TAGGED;
+        default:
+            return SAI_VLAN_PORT_BITMAP_UNTAGGED;
+    }
+}
+
+static sai_vlan_tagging_mode_t sai_vlan_port_bitmap_tagging_mode_get(
+                                        sai_vlan_port_bitmap_type_t type)
+{
+    switch(type) {
+        case SAI_VLAN_PORT_BITMAP_TAGGED:
+            return SAI_VLAN_PORT_TAGGED;
+        case SAI_VLAN_PORT_BITMAP_PRIORITY_TAGGED:
+            return SAI_VLAN_PORT_PRIORITY_TAGGED;
+        default:
+            return SAI_VLAN_PORT_UNTAGGED;
+    }
+}
+
+static inline bool sai_vlan_port_bitmap_test(const sai_vlan_global_cache_node_t *vplist,
+                                             sai_vlan_port_bitmap_type_t type,
+                                             unsigned int index)
+{
+    return (STD_BIT_ARRAY_TEST(vplist->port_bitmap[type], index) ? true : false);
+}
+
+/*Returns the first index set in the bitmap from start_index, -1 if none*/
+static int sai_vlan_port_bitmap_next(const uint8_t *bitmap, unsigned int start_index)
+{
+    if(start_index >= sai_vlan_port_bitmap_size) {
+        return -1;
+    }
+    return std_find_first_bit((void *)bitmap, sai_vlan_port_bitmap_size, start_index);
+}
+
+static void sai_vlan_port_bitmap_attach(sai_vlan_global_cache_node_t *vplist)
+{
+    unsigned int type = 0;
+    uint8_t *bitmap_block = NULL;
+
+    if(sai_vlan_port_bitmap_bytes == 0) {
+        return;
+    }
+    bitmap_block = sai_vlan_port_bitmap_pool +
+       (vplist->vlan_id * SAI_VLAN_PORT_BITMAP_MAX * sai_vlan_port_bitmap_bytes);
+    memset(bitmap_block, 0, SAI_VLAN_PORT_BITMAP_MAX * sai_vlan_port_bitmap_bytes);
+    for(type = 0; type < SAI_VLAN_PORT_BITMAP_MAX; type++) {
+        vplist->port_bitmap[type] = bitmap_block + (type * sai_vlan_port_bitmap_bytes);
+    }
+}
+
+/*Updates the bitmaps with the index stored in the port node*/
+static void sai_vlan_port_bitmap_update(sai_vlan_global_cache_node_t *vplist,
+                                        const sai_vlan_port_node_t *vlan_port_node,
+                                        bool is_add)
+{
+    const sai_vlan_port_t *vlan_port = &vlan_port_node->vlan_port;
+    sai_vlan_port_bitmap_type_t type;
+    unsigned int index = vlan_port_node->bitmap_index;
+
+    if(!vlan_port_node->is_indexed) {
+        if(is_add) {
+            vplist->unindexed_port_count++;
+        } else if(vplist->unindexed_port_count > 0) {
+            vplist->unindexed_port_count--;
+        }
+        return;
+    }
+    type = sai_vlan_port_bitmap_type_get(vlan_port->tagging_mode);
+    if(is_add) {
+        STD_BIT_ARRAY_SET(vplist->port_bitmap[type], index);
+        STD_BIT_ARRAY_SET(vplist->port_bitmap[SAI_VLAN_PORT_BITMAP_MEMBER], index);
+        sai_vlan_port_index_table[index] = vlan_port->port_id;
+        return;
+    }
+    STD_BIT_ARRAY_CLR(vplist->port_bitmap[type], index);
+    if(!sai_vlan_port_bitmap_test(vplist, SAI_VLAN_PORT_BITMAP_UNTAGGED, index) &&
+       !sai_vlan_port_bitmap_test(vplist, SAI_VLAN_PORT_BITMAP_TAGGED, index) &&
+       !sai_vlan_port_bitmap_test(vplist, SAI_VLAN_PORT_BITMAP_PRIORITY_TAGGED, index)) {
+        STD_BIT_ARRAY_CLR(vplist->port_bitmap[SAI_VLAN_PORT_BITMAP_MEMBER], index);
+    }
+}
+
+static sai_port_vlan_counter_t* sai_add_port_vlan_counter_node(sai_object_id_t port_id)
 {
     sai_port_vlan_counter_t *port_vlan_counter = NULL;
 
@@ -97,12 +337,12 @@ static sai_status_t sai_add_port_vlan_counter_node(sai_object_id_t port_id)
     if(port_vlan_counter == NULL) {
         SAI_VLAN_LOG_CRIT("Unable to add port 0x%"PRIx64" memory %d unavailable",
                          port_id, sizeof(sai_port_vlan_counter_t));
-        return SAI_STATUS_NO_MEMORY;
+        return NULL;
 
     }
     port_vlan_counter->port_id = port_id;
     std_dll_insert(&global_port_vlan_count_list,&(port_vlan_counter->node));
-    return SAI_STATUS_SUCCESS;
+    return port_vlan_counter;
 }
 
 static sai_port_vlan_counter_t* sai_find_port_vlan_counter(sai_object_id_t port_id)
@@ -139,7 +379,11 @@ static sai_status_t sai_remove_port_vlan_counter(sai_object_id_t port_id)
 bool sai_is_port_vlan_configured(sai_object_id_t port_id)
 {
     sai_port_vlan_counter_t *port_vlan_counter = NULL;
+    unsigned int index = 0;
 
+    if(sai_vlan_port_bitmap_index_get(port_id, &index)) {
+        return (sai_port_vlan_count_table[index] > 0);
+    }
     port_vlan_counter = sai_find_port_vlan_counter(port_id);
     if(port_vlan_counter == NULL) {
         return false;
@@ -147,29 +391,110 @@ bool sai_is_port_vlan_configured(sai_object_id_t port_id)
     return true;
 }
 
-static sai_status_t sai_increment_port_vlan_counter(sai_object_id_t port_id)
+/*Returns the VLAN bitmap of the given index, or of the counter node if unindexed*/
+static uint8_t* sai_port_vlan_bitmap_lookup(sai_object_id_t port_id,
+                                            bool is_indexed, unsigned int index)
 {
     sai_port_vlan_counter_t *port_vlan_counter = NULL;
-    sai_status_t ret_val = SAI_STATUS_FAILURE;
 
+    if(is_indexed) {
+        return (sai_port_vlan_bitmap_table + (index * SAI_VLAN_BITMAP_BYTES));
+    }
+    port_vlan_counter = sai_find_port_vlan_counter(port_id);
+    return ((port_vlan_counter != NULL) ? port_vlan_counter->vlan_bitmap : NULL);
+}
+
+/*Returns the VLAN bitmap of the port, NULL if the port is in no VLAN*/
+static uint8_t* sai_port_vlan_bitmap_get(sai_object_id_t port_id)
+{
+    unsigned int index = 0;
+    bool is_indexed = sai_vlan_port_bitmap_index_get(port_id, &index);
+
+    return sai_port_vlan_bitmap_lookup(port_id, is_indexed, index);
+}
+
+/*Returns the VLAN bitmap of the port node with the index stored at add time*/
+static uint8_t* sai_port_vlan_bitmap_node_get(const sai_vlan_port_node_t *vlan_port_node)
+{
+    return sai_port_vlan_bitmap_lookup(vlan_port_node->vlan_port.port_id,
+                                       vlan_port_node->is_indexed,
+                                       vlan_port_node->bitmap_index);
+}
+
+/*Checks the VLAN port list, used after the port node is removed*/
+static bool sai_vlan_has_port(sai_vlan_id_t vlan_id,
+                              const sai_vlan_port_node_t *port_node)
+{
+    sai_vlan_port_node_t *vlan_port_node = NULL;
+    std_dll *node = NULL;
+
+    if(port_node->is_indexed) {
+        return sai_vlan_port_bitmap_test(global_vlan_list[vlan_id],
+                                         SAI_VLAN_PORT_BITMAP_MEMBER,
+                                         port_node->bitmap_index);
+    }
+    for(node = std_dll_getfirst(&(global_vlan_list[vlan_id]->port_list));
+        node != NULL;
+        node = std_dll_getnext(&(global_vlan_list[vlan_id]->port_list),node)) {
+        vlan_port_node = (sai_vlan_port_node_t *)node;
+        if(vlan_port_node->vlan_port.port_id == port_node->vlan_port.port_id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+unsigned int sai_port_vlan_count_get(sai_object_id_t port_id)
+{
+    sai_port_vlan_counter_t *port_vlan_counter = NULL;
+    unsigned int index = 0;
+
+    if(sai_vlan_port_bitmap_index_get(port_id, &index)) {
+        return sai_port_vlan_count_table[index];
+    }
+    port_vlan_counter = sai_find_port_vlan_counter(port_id);
+    return ((port_vlan_counter != NULL) ? port_vlan_counter->vlan_count : 0);
+}
+
+static sai_status_t sai_increment_port_vlan_counter(
+                                  const sai_vlan_port_node_t *vlan_port_node)
+{
+    sai_port_vlan_counter_t *port_vlan_counter = NULL;
+    sai_object_id_t port_id = vlan_port_node->vlan_port.port_id;
+
+    if(vlan_port_node->is_indexed) {
+        sai_port_vlan_count_table[vlan_port_node->bitmap_index]++;
+        return SAI_STATUS_SUCCESS;
+    }
     port_vlan_counter = sai_find_port_vlan_counter(port_id);
     if(port_vlan_counter == NULL) {
-         ret_val = sai_add_port_vlan_counter_node(port_id);
-         if(ret_val != SAI_STATUS_SUCCESS) {
+         port_vlan_counter = sai_add_port_vlan_counter_node(port_id);
+         if(port_vlan_counter == NULL) {
              SAI_VLAN_LOG_WARN("Unable to create port vlan counter for port 0x%"PRIx64"",
                                port_id);
-             return ret_val;
+             return SAI_STATUS_NO_MEMORY;
          }
-         port_vlan_counter = sai_find_port_vlan_counter(port_id);
     }
     port_vlan_counter->vlan_count++;
     return SAI_STATUS_SUCCESS;
 }
 
-static sai_status_t sai_decrement_port_vlan_counter(sai_object_id_t port_id)
+static sai_status_t sai_decrement_port_vlan_counter(
+                                  const sai_vlan_port_node_t *vlan_port_node)
 {
     sai_port_vlan_counter_t *port_vlan_counter = NULL;
+    sai_object_id_t port_id = vlan_port_node->vlan_port.port_id;
+    unsigned int index = vlan_port_node->bitmap_index;
 
+    if(vlan_port_node->is_indexed) {
+        if(sai_port_vlan_count_table[index] == 0) {
+            SAI_VLAN_LOG_WARN("Port vlan counter already 0 for port 0x%"PRIx64"",
+                              port_id);
+            return SAI_STATUS_ITEM_NOT_FOUND;
+        }
+        sai_port_vlan_count_table[index]--;
+        return SAI_STATUS_SUCCESS;
+    }
     port_vlan_counter = sai_find_port_vlan_counter(port_id);
     if(port_vlan_counter == NULL) {
          SAI_VLAN_LOG_WARN("Unable to find port vlan counter for port 0x%"PRIx64"",
@@ -201,13 +526,15 @@ sai_status_t sai_insert_vlan_in_list(sai_vlan_id_t vlan_id)
                             vlan_id);
         return SAI_STATUS_ITEM_ALREADY_EXISTS;
     }
-    vplist=(sai_vlan_global_cache_node_t *)calloc(1, sizeof(sai_vlan_global_cache_node_t));
-    if(vplist == NULL) {
-        SAI_VLAN_LOG_CRIT("No memory  to create Vlan Id %d memory:%d",
-                          vlan_id, sizeof(sai_vlan_global_cache_node_t));
-        return SAI_STATUS_NO_MEMORY;
+    if(sai_vlan_cache_node_pool == NULL) {
+        SAI_VLAN_LOG_CRIT("VLAN cache not initialized to create Vlan Id %d",
+                          vlan_id);
+        return SAI_STATUS_UNINITIALIZED;
     }
+    vplist = &sai_vlan_cache_node_pool[vlan_id];
+    memset(vplist, 0, sizeof(sai_vlan_global_cache_node_t));
     vplist->vlan_id=vlan_id;
+    sai_vlan_port_bitmap_attach(vplist);
     std_dll_init(&(vplist->port_list));
     global_vlan_list[vlan_id] = vplist;
     SAI_VLAN_LOG_TRACE("Vlan Id %d Inserted in cache",
@@ -219,6 +546,7 @@ void sai_remove_all_vlan_port_nodes (sai_vlan_id_t vlan_id)
 {
     sai_vlan_port_node_t *vlan_port_node;
     std_dll *node = NULL;
+    uint8_t *port_vlan_bitmap = NULL;
 
     SAI_VLAN_LOG_TRACE("Removing all ports for Vlan Id %d",
                         vlan_id);
@@ -232,10 +560,19 @@ void sai_remove_all_vlan_port_nodes (sai_vlan_id_t vlan_id)
         vlan_port_node = (sai_vlan_port_node_t *)node;
         std_dll_remove(&(global_vlan_list[vlan_id]->port_list),
                        &(vlan_port_node->node));
-        sai_decrement_port_vlan_counter(vlan_port_node->vlan_port.port_id);
-        free(vlan_port_node);
+        port_vlan_bitmap = sai_port_vlan_bitmap_node_get(vlan_port_node);
+        if(port_vlan_bitmap != NULL) {
+            STD_BIT_ARRAY_CLR(port_vlan_bitmap, vlan_id);
+        }
+        sai_decrement_port_vlan_counter(vlan_port_node);
+        sai_vlan_port_node_free(vlan_port_node);
         global_vlan_list[vlan_id]->port_count--;
     }
+    if(sai_vlan_port_bitmap_bytes > 0) {
+        memset(global_vlan_list[vlan_id]->port_bitmap[SAI_VLAN_PORT_BITMAP_MEMBER], 0,
+               SAI_VLAN_PORT_BITMAP_MAX * sai_vlan_port_bitmap_bytes);
+    }
+    global_vlan_list[vlan_id]->unindexed_port_count = 0;
 }
 sai_status_t sai_remove_vlan_from_list(sai_vlan_id_t vlan_id)
 {
@@ -244,22 +581,19 @@ sai_status_t sai_remove_vlan_from_list(sai_vlan_id_t vlan_id)
         return SAI_STATUS_ITEM_NOT_FOUND;
     }
     sai_remove_all_vlan_port_nodes(vlan_id);
-    free(global_vlan_list[vlan_id]);
     global_vlan_list[vlan_id] = NULL;
     SAI_VLAN_LOG_TRACE("Deleted Vlan Id %d", vlan_id);
     return SAI_STATUS_SUCCESS;
 }
-sai_status_t sai_add_vlan_port_node(sai_vlan_id_t vlan_id,
-                                    const sai_vlan_port_t *vlan_port)
+/*Adds the port node, its bitmaps and its port VLAN count.
+  Forwarding mode is updated by the caller*/
+static sai_status_t sai_vlan_port_node_add(sai_vlan_id_t vlan_id,
+                                           const sai_vlan_port_t *vlan_port)
 {
     sai_vlan_port_node_t *vlan_port_node = NULL;
-    sai_vlan_port_t def_vlan_port;
-    sai_port_fwd_mode_t fwd_mode;
+    uint8_t *port_vlan_bitmap = NULL;
 
-    STD_ASSERT(vlan_port != NULL);
-    memset(&def_vlan_port, 0, sizeof(def_vlan_port));
-    vlan_port_node = (sai_vlan_port_node_t *)
-                          calloc(1, sizeof(sai_vlan_port_node_t));
+    vlan_port_node = sai_vlan_port_node_alloc();
 
     if(vlan_port_node == NULL) {
         SAI_VLAN_LOG_CRIT("Unable to add  port 0x"PRIx64" Vlan Id %d \
@@ -269,32 +603,172 @@ sai_status_t sai_add_vlan_port_node(sai_vlan_id_t vlan_id,
         return SAI_STATUS_NO_MEMORY;
     }
     vlan_port_node->vlan_port = *vlan_port;
+    vlan_port_node->is_indexed =
+        sai_vlan_port_bitmap_index_get(vlan_port->port_id,
+                                       &vlan_port_node->bitmap_index);
     std_dll_insertatback(&(global_vlan_list[vlan_id]->port_list),
                          &(vlan_port_node->node));
+    sai_vlan_port_bitmap_update(global_vlan_list[vlan_id], vlan_port_node, true);
     SAI_VLAN_LOG_TRACE("Added  port 0x:%"PRIx64" Vlan Id %d",
                       vlan_port->port_id, vlan_id);
     global_vlan_list[vlan_id]->port_count++;
-    if(!sai_is_port_vlan_configured(vlan_port->port_id)) {
-        fwd_mode = SAI_PORT_FWD_MODE_SWITCHING;
-        sai_port_forward_mode_info (vlan_port->port_id, &fwd_mode, true);
+    sai_increment_port_vlan_counter(vlan_port_node);
+    port_vlan_bitmap = sai_port_vlan_bitmap_node_get(vlan_port_node);
+    if(port_vlan_bitmap != NULL) {
+        STD_BIT_ARRAY_SET(port_vlan_bitmap, vlan_id);
     }
-    sai_increment_port_vlan_counter(vlan_port->port_id);
     return SAI_STATUS_SUCCESS;
 }
 
+/*Removes the port node, its bitmaps and its port VLAN count.
+  Uses the index stored in the node, the port may already be deleted.
+  Forwarding mode is updated by the caller*/
+static void sai_vlan_port_node_del(sai_vlan_id_t vlan_id,
+                                   sai_vlan_port_node_t *vlan_port_node)
+{
+    uint8_t *port_vlan_bitmap = NULL;
+
+    std_dll_remove(&(global_vlan_list[vlan_id]->port_list),
+                   &(vlan_port_node->node));
+    sai_vlan_port_bitmap_update(global_vlan_list[vlan_id], vlan_port_node, false);
+    port_vlan_bitmap = sai_port_vlan_bitmap_node_get(vlan_port_node);
+    if((port_vlan_bitmap != NULL) && !sai_vlan_has_port(vlan_id, vlan_port_node)) {
+        STD_BIT_ARRAY_CLR(port_vlan_bitmap, vlan_id);
+    }
+    sai_decrement_port_vlan_counter(vlan_port_node);
+    sai_vlan_port_node_free(vlan_port_node);
+    global_vlan_list[vlan_id]->port_count--;
+}
+
+static void sai_vlan_port_fwd_mode_update(sai_object_id_t port_id,
+                                          bool was_configured)
+{
+    sai_port_fwd_mode_t fwd_mode;
+    bool is_configured = sai_is_port_vlan_configured(port_id);
+
+    if(was_configured == is_configured) {
+        return;
+    }
+    fwd_mode = (is_configured) ? SAI_PORT_FWD_MODE_SWITCHING :
+                                 SAI_PORT_FWD_MODE_UNKNOWN;
+    sai_port_forward_mode_info (port_id, &fwd_mode, true);
+}
+
+sai_status_t sai_add_vlan_port_node(sai_vlan_id_t vlan_id,
+                                    const sai_vlan_port_t *vlan_port)
+{
+    sai_status_t ret_val = SAI_STATUS_FAILURE;
+    bool was_configured = false;
+
+    STD_ASSERT(vlan_port != NULL);
+    was_configured = sai_is_port_vlan_configured(vlan_port->port_id);
+    ret_val = sai_vlan_port_node_add(vlan_id, vlan_port);
+    if(ret_val != SAI_STATUS_SUCCESS) {
+        return ret_val;
+    }
+    sai_vlan_port_fwd_mode_update(vlan_port->port_id, was_configured);
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t sai_vlan_port_bulk_add_check(sai_vlan_id_t vlan_id,
+                                                 const sai_vlan_port_t *vlan_port)
+{
+    if(!sai_is_vlan_created(vlan_id)) {
+        return SAI_STATUS_INVALID_VLAN_ID;
+    }
+    if(!sai_is_valid_vlan_tagging_mode(vlan_port->tagging_mode)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+    if(sai_is_valid_vlan_port_member(vlan_id, vlan_port)) {
+        return SAI_STATUS_ITEM_ALREADY_EXISTS;
+    }
+    if(sai_is_port_in_different_tagging_mode(vlan_id, vlan_port)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_add_port_to_vlan_list(const sai_vlan_port_t *vlan_port,
+                                       unsigned int vlan_count,
+                                       const sai_vlan_id_t *vlan_list,
+                                       sai_status_t *status_list)
+{
+    sai_status_t ret_val = SAI_STATUS_SUCCESS;
+    bool was_configured = false;
+    unsigned int vlan_idx = 0;
+
+    STD_ASSERT(vlan_port != NULL);
+    STD_ASSERT(vlan_list != NULL);
+    STD_ASSERT(status_list != NULL);
+    was_configured = sai_is_port_vlan_configured(vlan_port->port_id);
+    for(vlan_idx = 0; vlan_idx < vlan_count; vlan_idx++) {
+        status_list[vlan_idx] = sai_vlan_port_bulk_add_check(vlan_list[vlan_idx],
+                                                             vlan_port);
+        if(status_list[vlan_idx] == SAI_STATUS_SUCCESS) {
+            status_list[vlan_idx] = sai_vlan_port_node_add(vlan_list[vlan_idx],
+                                                           vlan_port);
+        }
+        if((status_list[vlan_idx] != SAI_STATUS_SUCCESS) &&
+           (ret_val == SAI_STATUS_SUCCESS)) {
+            ret_val = status_list[vlan_idx];
+        }
+    }
+    sai_vlan_port_fwd_mode_update(vlan_port->port_id, was_configured);
+    return ret_val;
+}
+
+sai_status_t sai_add_vlan_port_list(sai_vlan_id_t vlan_id,
+                                    unsigned int port_count,
+                                    const sai_vlan_port_t *vlan_port_list,
+                                    sai_status_t *status_list)
+{
+    sai_status_t ret_val = SAI_STATUS_SUCCESS;
+    bool was_configured = false;
+    unsigned int port_idx = 0;
+
+    STD_ASSERT(vlan_port_list != NULL);
+    STD_ASSERT(status_list != NULL);
+    for(port_idx = 0; port_idx < port_count; port_idx++) {
+        status_list[port_idx] = sai_vlan_port_bulk_add_check(vlan_id,
+                                                     &vlan_port_list[port_idx]);
+        if(status_list[port_idx] == SAI_STATUS_SUCCESS) {
+            was_configured =
+                sai_is_port_vlan_configured(vlan_port_list[port_idx].port_id);
+            status_list[port_idx] = sai_vlan_port_node_add(vlan_id,
+                                                     &vlan_port_list[port_idx]);
+            if(status_list[port_idx] == SAI_STATUS_SUCCESS) {
+                sai_vlan_port_fwd_mode_update(vlan_port_list[port_idx].port_id,
+                                              was_configured);
+            }
+        }
+        if((status_list[port_idx] != SAI_STATUS_SUCCESS) &&
+           (ret_val == SAI_STATUS_SUCCESS)) {
+            ret_val = status_list[port_idx];
+        }
+    }
+    return ret_val;
+}
+
 sai_vlan_port_node_t* sai_find_vlan_port_node(sai_vlan_id_t vlan_id,
                                               const sai_vlan_port_t *vlan_port)
 {
     sai_vlan_port_node_t *vlan_port_node = NULL;
     std_dll *node = NULL;
+    unsigned int index = 0;
     STD_ASSERT(vlan_port != NULL);
-    for(node = std_dll_getfirst(&(global_vlan_list[vlan_id]->port_list));
-        node != NULL;
-        node = std_dll_getnext(&(global_vlan_list[vlan_id]->port_list),node)) {
-        vlan_port_node = (sai_vlan_port_node_t *)node;
-        if((vlan_port_node->vlan_port.port_id == vlan_port->port_id) &&
-           (vlan_port_node->vlan_port.tagging_mode == vlan_port->tagging_mode)){
-            return vlan_port_node;
+    /*Bitmap test rejects non members without the list walk*/
+    if(!sai_vlan_port_bitmap_index_get(vlan_port->port_id, &index) ||
+       sai_vlan_port_bitmap_test(global_vlan_list[vlan_id],
+                        sai_vlan_port_bitmap_type_get(vlan_port->tagging_mode),
+                        index)) {
+        for(node = std_dll_getfirst(&(global_vlan_list[vlan_id]->port_list));
+            node != NULL;
+            node = std_dll_getnext(&(global_vlan_list[vlan_id]->port_list),node)) {
+            vlan_port_node = (sai_vlan_port_node_t *)node;
+            if((vlan_port_node->vlan_port.port_id == vlan_port->port_id) &&
+               (vlan_port_node->vlan_port.tagging_mode == vlan_port->tagging_mode)){
+                return vlan_port_node;
+            }
         }
     }
     SAI_VLAN_LOG_TRACE("port 0x%"PRIx64" tagging mode %d not found on Vlan Id %d",
@@ -306,7 +780,13 @@ bool sai_is_valid_vlan_port_member (sai_vlan_id_t vlan_id,
                                     const sai_vlan_port_t *vlan_port)
 {
     bool ret_val = false;
+    unsigned int index = 0;
     STD_ASSERT(vlan_port != NULL);
+    if(sai_vlan_port_bitmap_index_get(vlan_port->port_id, &index)) {
+        return sai_vlan_port_bitmap_test(global_vlan_list[vlan_id],
+                        sai_vlan_port_bitmap_type_get(vlan_port->tagging_mode),
+                        index);
+    }
     if(sai_find_vlan_port_node(vlan_id, vlan_port) != NULL) {
         ret_val = true;
     }
@@ -317,7 +797,19 @@ bool sai_is_port_in_different_tagging_mode(sai_vlan_id_t vlan_id,
 {
     sai_vlan_port_node_t *vlan_port_node = NULL;
     std_dll *node = NULL;
+    sai_vlan_port_bitmap_type_t type;
+    unsigned int index = 0;
     STD_ASSERT(vlan_port != NULL);
+    if(sai_vlan_port_bitmap_index_get(vlan_port->port_id, &index)) {
+        for(type = SAI_VLAN_PORT_BITMAP_UNTAGGED; type < SAI_VLAN_PORT_BITMAP_MAX;
+            type++) {
+            if((type != sai_vlan_port_bitmap_type_get(vlan_port->tagging_mode)) &&
+               sai_vlan_port_bitmap_test(global_vlan_list[vlan_id], type, index)) {
+                return true;
+            }
+        }
+        return false;
+    }
     for(node = std_dll_getfirst(&(global_vlan_list[vlan_id]->port_list));
         node != NULL;
         node = std_dll_getnext(&(global_vlan_list[vlan_id]->port_list),node)) {
@@ -333,47 +825,258 @@ sai_status_t sai_remove_vlan_port_node (sai_vlan_id_t vlan_id,
                                         const sai_vlan_port_t *vlan_port)
 {
     sai_vlan_port_node_t *vlan_port_node = NULL;
-    sai_port_fwd_mode_t fwd_mode;
 
     STD_ASSERT(vlan_port != NULL);
     vlan_port_node = sai_find_vlan_port_node(vlan_id, vlan_port);
     if(vlan_port_node != NULL) {
-        std_dll_remove(&(global_vlan_list[vlan_id]->port_list),
-                       &(vlan_port_node->node));
-        sai_decrement_port_vlan_counter(vlan_port_node->vlan_port.port_id);
-        free(vlan_port_node);
-        global_vlan_list[vlan_id]->port_count--;
-        if(!sai_is_port_vlan_configured(vlan_port->port_id)) {
-            fwd_mode = SAI_PORT_FWD_MODE_UNKNOWN;
-            sai_port_forward_mode_info (vlan_port->port_id, &fwd_mode, true);
-        }
+        sai_vlan_port_node_del(vlan_id, vlan_port_node);
+        sai_vlan_port_fwd_mode_update(vlan_port->port_id, true);
         SAI_VLAN_LOG_TRACE("port 0x%"PRIx64" removed from Vlan Id %d",
                            vlan_port->port_id, vlan_id);
         return SAI_STATUS_SUCCESS;
     }
     return SAI_STATUS_INVALID_PORT_MEMBER;
 }
+
+static sai_status_t sai_vlan_port_bulk_remove(sai_vlan_id_t vlan_id,
+                                              const sai_vlan_port_t *vlan_port)
+{
+    sai_vlan_port_node_t *vlan_port_node = NULL;
+
+    if(!sai_is_vlan_created(vlan_id)) {
+        return SAI_STATUS_INVALID_VLAN_ID;
+    }
+    vlan_port_node = sai_find_vlan_port_node(vlan_id, vlan_port);
+    if(vlan_port_node == NULL) {
+        return SAI_STATUS_INVALID_PORT_MEMBER;
+    }
+    sai_vlan_port_node_del(vlan_id, vlan_port_node);
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_remove_port_from_vlan_list(const sai_vlan_port_t *vlan_port,
+                                            unsigned int vlan_count,
+                                            const sai_vlan_id_t *vlan_list,
+                                            sai_status_t *status_list)
+{
+    sai_status_t ret_val = SAI_STATUS_SUCCESS;
+    bool was_configured = false;
+    unsigned int vlan_idx = 0;
+
+    STD_ASSERT(vlan_port != NULL);
+    STD_ASSERT(vlan_list != NULL);
+    STD_ASSERT(status_list != NULL);
+    was_configured = sai_is_port_vlan_configured(vlan_port->port_id);
+    for(vlan_idx = 0; vlan_idx < vlan_count; vlan_idx++) {
+        status_list[vlan_idx] = sai_vlan_port_bulk_remove(vlan_list[vlan_idx],
+                                                          vlan_port);
+        if((status_list[vlan_idx] != SAI_STATUS_SUCCESS) &&
+           (ret_val == SAI_STATUS_SUCCESS)) {
+            ret_val = status_list[vlan_idx];
+        }
+    }
+    sai_vlan_port_fwd_mode_update(vlan_port->port_id, was_configured);
+    return ret_val;
+}
+
+sai_status_t sai_remove_vlan_port_list(sai_vlan_id_t vlan_id,
+                                       unsigned int port_count,
+                                       const sai_vlan_port_t *vlan_port_list,
+                                       sai_status_t *status_list)
+{
+    sai_status_t ret_val = SAI_STATUS_SUCCESS;
+    unsigned int port_idx = 0;
+
+    STD_ASSERT(vlan_port_list != NULL);
+    STD_ASSERT(status_list != NULL);
+    for(port_idx = 0; port_idx < port_count; port_idx++) {
+        status_list[port_idx] = sai_vlan_port_bulk_remove(vlan_id,
+                                                     &vlan_port_list[port_idx]);
+        if(status_list[port_idx] == SAI_STATUS_SUCCESS) {
+            sai_vlan_port_fwd_mode_update(vlan_port_list[port_idx].port_id, true);
+        } else if(ret_val == SAI_STATUS_SUCCESS) {
+            ret_val = status_list[port_idx];
+        }
+    }
+    return ret_val;
+}
+
+sai_status_t sai_port_vlan_list_get(sai_object_id_t port_id,
+                                    unsigned int *vlan_count,
+                                    sai_vlan_id_t *vlan_list)
+{
+    const uint8_t *port_vlan_bitmap = NULL;
+    unsigned int count = 0;
+    int vlan_id = 0;
+
+    STD_ASSERT(vlan_count != NULL);
+    port_vlan_bitmap = sai_port_vlan_bitmap_get(port_id);
+    if(port_vlan_bitmap == NULL) {
+        *vlan_count = 0;
+        return SAI_STATUS_SUCCESS;
+    }
+    /*Memberships count bounds the number of VLANs*/
+    if(*vlan_count < sai_port_vlan_count_get(port_id)) {
+        *vlan_count = sai_port_vlan_count_get(port_id);
+        return SAI_STATUS_BUFFER_OVERFLOW;
+    }
+    STD_ASSERT(vlan_list != NULL);
+    for(vlan_id = std_find_first_bit((void *)port_vlan_bitmap,
+                                     SAI_MAX_VLAN_TAG_ID + 1, SAI_MIN_VLAN_TAG_ID);
+        (vlan_id >= 0) && (vlan_id <= SAI_MAX_VLAN_TAG_ID);
+        vlan_id = (vlan_id < SAI_MAX_VLAN_TAG_ID) ?
+                  std_find_first_bit((void *)port_vlan_bitmap,
+                                     SAI_MAX_VLAN_TAG_ID + 1, vlan_id + 1) : -1) {
+        vlan_list[count] = (sai_vlan_id_t)vlan_id;
+        count++;
+    }
+    *vlan_count = count;
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_remove_port_from_all_vlans(sai_object_id_t port_id,
+                                            unsigned int *vlan_count)
+{
+    uint8_t vlan_bitmap[SAI_VLAN_BITMAP_BYTES];
+    const uint8_t *port_vlan_bitmap = NULL;
+    sai_vlan_port_node_t *vlan_port_node = NULL;
+    sai_vlan_port_bitmap_type_t type;
+    sai_vlan_port_t vlan_port;
+    unsigned int count = 0;
+    int vlan_id = 0;
+
+    port_vlan_bitmap = sai_port_vlan_bitmap_get(port_id);
+    if(port_vlan_bitmap == NULL) {
+        if(vlan_count != NULL) {
+            *vlan_count = 0;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+    /*Port counter node holding the bitmap is freed with the last VLAN*/
+    memcpy(vlan_bitmap, port_vlan_bitmap, sizeof(vlan_bitmap));
+    memset(&vlan_port, 0, sizeof(vlan_port));
+    vlan_port.port_id = port_id;
+    for(vlan_id = std_find_first_bit(vlan_bitmap, SAI_MAX_VLAN_TAG_ID + 1,
+                                     SAI_MIN_VLAN_TAG_ID);
+        (vlan_id >= 0) && (vlan_id <= SAI_MAX_VLAN_TAG_ID);
+        vlan_id = (vlan_id < SAI_MAX_VLAN_TAG_ID) ?
+                  std_find_first_bit(vlan_bitmap, SAI_MAX_VLAN_TAG_ID + 1,
+                                     vlan_id + 1) : -1) {
+        for(type = SAI_VLAN_PORT_BITMAP_UNTAGGED; type < SAI_VLAN_PORT_BITMAP_MAX;
+            type++) {
+            vlan_port.tagging_mode = sai_vlan_port_bitmap_tagging_mode_get(type);
+            vlan_port_node = sai_find_vlan_port_node(vlan_id, &vlan_port);
+            if(vlan_port_node != NULL) {
+                sai_vlan_port_node_del(vlan_id, vlan_port_node);
+            }
+        }
+        count++;
+    }
+    sai_vlan_port_fwd_mode_update(port_id, true);
+    SAI_VLAN_LOG_TRACE("port 0x%"PRIx64" removed from %d Vlans", port_id, count);
+    if(vlan_count != NULL) {
+        *vlan_count = count;
+    }
+    return SAI_STATUS_SUCCESS;
+}
 sai_status_t sai_vlan_port_list_get(sai_vlan_id_t vlan_id, sai_vlan_port_list_t *vlan_port_list)
 {
+    sai_vlan_global_cache_node_t *vplist = global_vlan_list[vlan_id];
     sai_vlan_port_node_t *vlan_port_node = NULL;
+    sai_vlan_port_bitmap_type_t type;
     std_dll *node = NULL;
     unsigned int port_idx = 0;
+    int bit_idx = 0;
 
     STD_ASSERT(vlan_port_list != NULL);
-    if(vlan_port_list->count < global_vlan_list[vlan_id]->port_count) {
-        vlan_port_list->count = global_vlan_list[vlan_id]->port_count;
+    if(vlan_port_list->count < vplist->port_count) {
+        vlan_port_list->count = vplist->port_count;
         return SAI_STATUS_BUFFER_OVERFLOW;
     }
-    for(node = std_dll_getfirst(&(global_vlan_list[vlan_id]->port_list));
+    /*Indexed ports are read from the bitmaps in port index order*/
+    for(bit_idx = sai_vlan_port_bitmap_next(vplist->port_bitmap[SAI_VLAN_PORT_BITMAP_MEMBER], 0);
+        bit_idx >= 0;
+        bit_idx = sai_vlan_port_bitmap_next(vplist->port_bitmap[SAI_VLAN_PORT_BITMAP_MEMBER],
+                                            bit_idx + 1)) {
+        for(type = SAI_VLAN_PORT_BITMAP_UNTAGGED; type < SAI_VLAN_PORT_BITMAP_MAX;
+            type++) {
+            if(sai_vlan_port_bitmap_test(vplist, type, bit_idx)) {
+                vlan_port_list->list[port_idx].port_id =
+                                               sai_vlan_port_index_table[bit_idx];
+                vlan_port_list->list[port_idx].tagging_mode =
+                                    sai_vlan_port_bitmap_tagging_mode_get(type);
+                port_idx++;
+            }
+        }
+    }
+    /*Ports without an index, such as LAGs, are read from the port list*/
+    for(node = (vplist->unindexed_port_count > 0) ?
+               std_dll_getfirst(&(vplist->port_list)) : NULL;
         node != NULL;
-        node = std_dll_getnext(&(global_vlan_list[vlan_id]->port_list),node)) {
+        node = std_dll_getnext(&(vplist->port_list),node)) {
         vlan_port_node = (sai_vlan_port_node_t *)node;
-        vlan_port_list->list[port_idx] = vlan_port_node->vlan_port;
-        port_idx++;
+        if(!vlan_port_node->is_indexed) {
+            vlan_port_list->list[port_idx] = vlan_port_node->vlan_port;
+            port_idx++;
+        }
     }
     vlan_port_list->count = port_idx;
     return SAI_STATUS_SUCCESS;
 }
+unsigned int sai_vlan_port_count_get(sai_vlan_id_t vlan_id)
+{
+    if(!sai_is_vlan_created(vlan_id)) {
+        return 0;
+    }
+    return global_vlan_list[vlan_id]->port_count;
+}
+
+const sai_vlan_port_t* sai_vlan_port_get_first(sai_vlan_id_t vlan_id)
+{
+    std_dll *node = NULL;
+
+    if(!sai_is_vlan_created(vlan_id)) {
+        return NULL;
+    }
+    node = std_dll_getfirst(&(global_vlan_list[vlan_id]->port_list));
+    return ((node != NULL) ? &((sai_vlan_port_node_t *)node)->vlan_port : NULL);
+}
+
+const sai_vlan_port_t* sai_vlan_port_get_next(sai_vlan_id_t vlan_id,
+                                              const sai_vlan_port_t *vlan_port)
+{
+    sai_vlan_port_node_t *vlan_port_node = NULL;
+    std_dll *node = NULL;
+
+    STD_ASSERT(vlan_port != NULL);
+    vlan_port_node = (sai_vlan_port_node_t *)((uint8_t *)vlan_port -
+                        STD_STR_OFFSET_OF(sai_vlan_port_node_t, vlan_port));
+    node = std_dll_getnext(&(global_vlan_list[vlan_id]->port_list),
+                           &(vlan_port_node->node));
+    return ((node != NULL) ? &((sai_vlan_port_node_t *)node)->vlan_port : NULL);
+}
+
+sai_status_t sai_vlan_port_walk(sai_vlan_id_t vlan_id,
+                                sai_vlan_port_walk_fn walk_fn, void *p_cookie)
+{
+    const sai_vlan_port_t *vlan_port = NULL;
+    sai_status_t ret_val = SAI_STATUS_SUCCESS;
+
+    STD_ASSERT(walk_fn != NULL);
+    if(!sai_is_vlan_created(vlan_id)) {
+        return SAI_STATUS_INVALID_VLAN_ID;
+    }
+    for(vlan_port = sai_vlan_port_get_first(vlan_id);
+        vlan_port != NULL;
+        vlan_port = sai_vlan_port_get_next(vlan_id, vlan_port)) {
+        ret_val = walk_fn(vlan_id, vlan_port, p_cookie);
+        if(ret_val != SAI_STATUS_SUCCESS) {
+            return ret_val;
+        }
+    }
+    return SAI_STATUS_SUCCESS;
+}
+
 bool sai_is_valid_vlan_tagging_mode(sai_vlan_tagging_mode_t tagging_mode)
 {
     switch(tagging_mode) {